@@ -7,7 +7,16 @@ public class AzureKinectBodyTrackingSimple : ModuleRules
     public AzureKinectBodyTrackingSimple(ReadOnlyTargetRules Target) : base(Target)
     {
         PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
-        PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine" });
+        // AzureKinectSimple also brings the k4a headers (or their stand-in) along
+        PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "AzureKinectSimple" });
+        PrivateDependencyModuleNames.AddRange(new string[] { "LiveLinkInterface", "Sockets", "Networking", "Json", "ProceduralMeshComponent", "RenderCore", "ImageWrapper" });
+
+        // No body tracking SDK off Windows either: header-only stand-in, a tracker never starts
+        if (Target.Platform != UnrealTargetPlatform.Win64)
+        {
+            PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "ThirdParty", "AzureKinectBodyTrackingStandIn", "include"));
+            return;
+        }
 
         // === sensor SDK (k4a) ===
         string SensorSDK = Environment.GetEnvironmentVariable("AZUREKINECT_SDK");
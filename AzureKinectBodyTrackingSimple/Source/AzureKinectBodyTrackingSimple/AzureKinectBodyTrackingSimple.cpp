@@ -1,5 +1,31 @@
 // AzureKinectBodyTrackingSimple.cpp
 #include "Modules/ModuleManager.h"
+#include "AzureBodyTrackingStats.h"
+
+DEFINE_LOG_CATEGORY(LogAzureBodyTracking);
+
+DEFINE_STAT(STAT_AzureBT_Tick);
+DEFINE_STAT(STAT_AzureBT_TrackerEnqueue);
+DEFINE_STAT(STAT_AzureBT_TrackerPop);
+DEFINE_STAT(STAT_AzureBT_SnapshotBuild);
+DEFINE_STAT(STAT_AzureBT_Reidentify);
+DEFINE_STAT(STAT_AzureBT_SkeletonFill);
+DEFINE_STAT(STAT_AzureBT_Selection);
+DEFINE_STAT(STAT_AzureBT_SpatialIndex);
+DEFINE_STAT(STAT_AzureBT_Gestures);
+DEFINE_STAT(STAT_AzureBT_BodyIndexTextures);
+DEFINE_STAT(STAT_AzureBT_OcclusionMesh);
+DEFINE_STAT(STAT_AzureBT_OcclusionUpload);
+DEFINE_STAT(STAT_AzureBT_Occupancy);
+
+TRACE_DECLARE_INT_COUNTER(AzureBT_TrackerQueueDepth, TEXT("AzureKinect/Tracker Queue Depth"));
+TRACE_DECLARE_INT_COUNTER(AzureBT_DroppedFrames, TEXT("AzureKinect/Dropped Body Frames"));
+TRACE_DECLARE_INT_COUNTER(AzureBT_DepthRecorderQueue, TEXT("AzureKinect/Depth Recorder Queue"));
+TRACE_DECLARE_INT_COUNTER(AzureBT_TakeRecorderQueue, TEXT("AzureKinect/Take Recorder Queue"));
+TRACE_DECLARE_INT_COUNTER(AzureBT_ImuDroppedSamples, TEXT("AzureKinect/IMU Dropped Samples"));
+TRACE_DECLARE_FLOAT_COUNTER(AzureBT_SensorToGameLatencyMs, TEXT("AzureKinect/Sensor To Game Latency (ms)"));
+TRACE_DECLARE_INT_COUNTER(AzureBT_OcclusionTilesRebuilt, TEXT("AzureKinect/Occlusion Tiles Rebuilt"));
+TRACE_DECLARE_INT_COUNTER(AzureBT_OccupiedVoxels, TEXT("AzureKinect/Occupied Voxels"));
 
 class FAzureKinectBodyTrackingSimpleModule : public IModuleInterface
 {
@@ -7,7 +33,7 @@ public:
     // Called right after the module DLL is loaded and before any UObject
     virtual void StartupModule() override
     {
-        UE_LOG(LogTemp, Log, TEXT("AzureKinectBodyTrackingSimple loaded"));
+        UE_LOG(LogAzureBodyTracking, Log, TEXT("AzureKinectBodyTrackingSimple loaded"));
     }
 
     // Called before the module is unloaded, right before the DLL is freed
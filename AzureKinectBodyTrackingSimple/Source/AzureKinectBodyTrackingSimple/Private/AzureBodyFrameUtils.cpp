@@ -1,4 +1,6 @@
 #include "AzureBodyFrameUtils.h"
+#include "AzureBodySnapshot.h"
+#include "AzureKinectSkeletonUtils.h"
 
 namespace AzureFrame
 {
@@ -27,4 +29,71 @@ namespace AzureFrame
         }
         return BestId;
     }
+
+    int32 FindClosestBodyId(const FAzureFrameSnapshot& Snapshot)
+    {
+        float BestDistSq = TNumericLimits<float>::Max();
+        int32 BestId = -1;
+
+        for (const FAzureTrackedBody& Body : Snapshot.Bodies)
+        {
+            const auto& P = Body.Skeleton.joints[K4ABT_JOINT_PELVIS].position.xyz;
+            const float DistSq = (P.x * 0.001f) * (P.x * 0.001f)
+                               + (P.y * 0.001f) * (P.y * 0.001f)
+                               + (P.z * 0.001f) * (P.z * 0.001f);
+
+            if (DistSq < BestDistSq) { BestDistSq = DistSq; BestId = Body.PersonId; }
+        }
+        return BestId;
+    }
+
+    void UpdateBodyWorld(FAzureTrackedBody& Body, const FTransform& AzureCameraTransform)
+    {
+        Body.WorldBounds = FBox(ForceInit);
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            const k4abt_joint_t& Joint = Body.Skeleton.joints[J];
+            Body.JointsWorld[J] = AzureSkel::JointToWorld(Joint.position, AzureCameraTransform);
+            if (Joint.confidence_level != K4ABT_JOINT_CONFIDENCE_NONE)
+            {
+                Body.WorldBounds += Body.JointsWorld[J];
+            }
+        }
+
+        // Nothing confident (e.g. everything out of range): fall back to all joints
+        if (!Body.WorldBounds.IsValid)
+        {
+            Body.WorldBounds = FBox(Body.JointsWorld, K4ABT_JOINT_COUNT);
+        }
+    }
+
+    void BuildSnapshot(k4abt_frame_t Frame, const FTransform& AzureCameraTransform, FAzureFrameSnapshot& OutSnapshot)
+    {
+        OutSnapshot.Reset();
+        if (!Frame) return;
+
+        OutSnapshot.DeviceTimestampUsec = k4abt_frame_get_device_timestamp_usec(Frame);
+        OutSnapshot.SystemTimestampNsec = k4abt_frame_get_system_timestamp_nsec(Frame);
+
+        const uint32 NumBodies = k4abt_frame_get_num_bodies(Frame);
+        OutSnapshot.Bodies.Reserve(NumBodies);
+
+        for (uint32 i = 0; i < NumBodies; ++i)
+        {
+            const uint32 BodyId = k4abt_frame_get_body_id(Frame, i);
+            if (BodyId == K4ABT_INVALID_BODY_ID) break;
+
+            FAzureTrackedBody& Body = OutSnapshot.Bodies.AddDefaulted_GetRef();
+            if (k4abt_frame_get_body_skeleton(Frame, i, &Body.Skeleton) != K4A_RESULT_SUCCEEDED)
+            {
+                OutSnapshot.Bodies.Pop(false);
+                continue;
+            }
+
+            Body.BodyId = (int32)BodyId;
+            Body.PersonId = (int32)BodyId;
+            Body.FrameIndex = (int32)i;
+            UpdateBodyWorld(Body, AzureCameraTransform);
+        }
+    }
 }
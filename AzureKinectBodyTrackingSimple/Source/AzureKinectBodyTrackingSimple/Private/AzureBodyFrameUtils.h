@@ -2,8 +2,20 @@
 #include "CoreMinimal.h"
 #include <k4abt.h>
 
+struct FAzureFrameSnapshot;
+struct FAzureTrackedBody;
+
 namespace AzureFrame
 {
     /** Returns the body_id of the closest body (by pelvis distance), or -1 if none. */
     int32 FindClosestBodyId(k4abt_frame_t Frame);
+
+    /** Same as above, from an already-built snapshot (no SDK calls). Returns the PersonId. */
+    int32 FindClosestBodyId(const FAzureFrameSnapshot& Snapshot);
+
+    /** Fills JointsWorld and WorldBounds from the body's raw skeleton. */
+    void UpdateBodyWorld(FAzureTrackedBody& Body, const FTransform& AzureCameraTransform);
+
+    /** Copies every body of Frame into OutSnapshot, with joints also transformed to world space. */
+    void BuildSnapshot(k4abt_frame_t Frame, const FTransform& AzureCameraTransform, FAzureFrameSnapshot& OutSnapshot);
 }
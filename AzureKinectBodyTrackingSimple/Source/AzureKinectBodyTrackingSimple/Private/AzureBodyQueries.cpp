@@ -0,0 +1,81 @@
+#include "AzureBodyQueries.h"
+#include "AzureKinectBodyTrackingComponent.h" // for FBodyJointData / EAzureKinectJoint
+#include "AzureBodyTrackingStats.h"
+#include "AzureBodySnapshot.h"
+#include "AzureBodySpatialIndex.h"
+#include "AzureKinectSkeletonUtils.h"
+
+namespace AzureQuery
+{
+    bool GetPersonJoints(const FAzureFrameSnapshot& Snapshot, int32 PersonId,
+                         const FTransform& AzureCameraTransform, TArray<FBodyJointData>& OutJoints)
+    {
+        OutJoints.Reset();
+
+        const FAzureTrackedBody* Body = Snapshot.FindPerson(PersonId);
+        if (!Body)
+        {
+            UE_LOG(LogAzureBodyTracking, Verbose, TEXT("BodyBT: requested BodyId %d not in frame"), PersonId);
+            return false;
+        }
+
+        AzureSkel::FillJointArrayFromSkeleton(Body->Skeleton, AzureCameraTransform, OutJoints);
+        return true;
+    }
+
+    bool FindJointByName(const TArray<FBodyJointData>& Joints, const FString& BoneName, FBodyJointData& OutJointData)
+    {
+        for (const FBodyJointData& Joint : Joints)
+        {
+            if (Joint.JointName.Equals(BoneName, ESearchCase::IgnoreCase))
+            {
+                OutJointData = Joint;
+                return true;
+            }
+        }
+        UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: bone '%s' not found in provided skeleton"), *BoneName);
+        return false;
+    }
+
+    bool FindJointById(const TArray<FBodyJointData>& Joints, EAzureKinectJoint Joint, FBodyJointData& OutJointData)
+    {
+        const int32 WantedId = static_cast<int32>(Joint);
+        for (const FBodyJointData& Candidate : Joints)
+        {
+            if (Candidate.JointId == WantedId)
+            {
+                OutJointData = Candidate;
+                return true;
+            }
+        }
+        UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: joint enum '%d' not found in provided skeleton"), WantedId);
+        return false;
+    }
+
+    bool FindNearestBody(const FAzureBodySpatialIndex& Index, const FVector& WorldPoint, int32& OutBodyId, float& OutDistance)
+    {
+        OutBodyId = Index.FindNearestBody(WorldPoint, OutDistance);
+        return OutBodyId >= 0;
+    }
+
+    bool FindNearestJoint(const FAzureBodySpatialIndex& Index, const FVector& WorldPoint, EAzureKinectJoint Joint,
+                          int32& OutBodyId, FVector& OutJointPosition, float& OutDistance)
+    {
+        int32 JointId = -1;
+        const uint32 Mask = 1u << static_cast<uint32>(Joint);
+        return Index.FindNearestJoint(WorldPoint, Mask, OutBodyId, JointId, OutJointPosition, OutDistance);
+    }
+
+    bool FindNearestHand(const FAzureBodySpatialIndex& Index, const FVector& WorldPoint,
+                         int32& OutBodyId, EAzureKinectJoint& OutHand, FVector& OutHandPosition, float& OutDistance)
+    {
+        int32 JointId = -1;
+        const uint32 Mask = (1u << K4ABT_JOINT_HAND_LEFT) | (1u << K4ABT_JOINT_HAND_RIGHT);
+        if (!Index.FindNearestJoint(WorldPoint, Mask, OutBodyId, JointId, OutHandPosition, OutDistance))
+        {
+            return false;
+        }
+        OutHand = static_cast<EAzureKinectJoint>(JointId);
+        return true;
+    }
+}
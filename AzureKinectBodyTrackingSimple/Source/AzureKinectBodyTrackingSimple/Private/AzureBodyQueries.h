@@ -0,0 +1,28 @@
+// AzureBodyQueries.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+
+// Shared by the tracking and receiver components so both answer the same Blueprint queries
+// the same way. FBodyJointData / EAzureKinectJoint come from the component header (cpp only).
+struct FAzureFrameSnapshot;
+struct FBodyJointData;
+enum class EAzureKinectJoint : uint8;
+class FAzureBodySpatialIndex;
+
+namespace AzureQuery
+{
+    /** World-space joints of the person with PersonId in Snapshot. False (and empty) if absent. */
+    bool GetPersonJoints(const FAzureFrameSnapshot& Snapshot, int32 PersonId,
+                         const FTransform& AzureCameraTransform, TArray<FBodyJointData>& OutJoints);
+
+    /** Joint by name (case-insensitive) or by id in an array from GetPersonJoints; warns when missing. */
+    bool FindJointByName(const TArray<FBodyJointData>& Joints, const FString& BoneName, FBodyJointData& OutJointData);
+    bool FindJointById(const TArray<FBodyJointData>& Joints, EAzureKinectJoint Joint, FBodyJointData& OutJointData);
+
+    /** Nearest-point queries over an index built from the same frame. */
+    bool FindNearestBody(const FAzureBodySpatialIndex& Index, const FVector& WorldPoint, int32& OutBodyId, float& OutDistance);
+    bool FindNearestJoint(const FAzureBodySpatialIndex& Index, const FVector& WorldPoint, EAzureKinectJoint Joint,
+                          int32& OutBodyId, FVector& OutJointPosition, float& OutDistance);
+    bool FindNearestHand(const FAzureBodySpatialIndex& Index, const FVector& WorldPoint,
+                         int32& OutBodyId, EAzureKinectJoint& OutHand, FVector& OutHandPosition, float& OutDistance);
+}
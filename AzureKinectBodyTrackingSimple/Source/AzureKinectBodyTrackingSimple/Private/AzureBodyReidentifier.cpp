@@ -0,0 +1,217 @@
+#include "AzureBodyReidentifier.h"
+#include "AzureBodySnapshot.h"
+
+namespace
+{
+    // Bone-length features: left/right pairs are averaged so a half-occluded body still measures
+    struct FBoneDef { uint8 A0, B0, A1, B1; };
+
+    const FBoneDef GBones[FAzureBodyReidentifier::NumBones] =
+    {
+        { K4ABT_JOINT_PELVIS,        K4ABT_JOINT_SPINE_CHEST,  K4ABT_JOINT_PELVIS,         K4ABT_JOINT_SPINE_CHEST },  // lower torso
+        { K4ABT_JOINT_SPINE_CHEST,   K4ABT_JOINT_NECK,         K4ABT_JOINT_SPINE_CHEST,    K4ABT_JOINT_NECK },         // upper torso
+        { K4ABT_JOINT_NECK,          K4ABT_JOINT_HEAD,         K4ABT_JOINT_NECK,           K4ABT_JOINT_HEAD },         // neck
+        { K4ABT_JOINT_SHOULDER_LEFT, K4ABT_JOINT_SHOULDER_RIGHT, K4ABT_JOINT_SHOULDER_LEFT, K4ABT_JOINT_SHOULDER_RIGHT }, // shoulder width
+        { K4ABT_JOINT_HIP_LEFT,      K4ABT_JOINT_HIP_RIGHT,    K4ABT_JOINT_HIP_LEFT,       K4ABT_JOINT_HIP_RIGHT },    // hip width
+        { K4ABT_JOINT_SHOULDER_LEFT, K4ABT_JOINT_ELBOW_LEFT,   K4ABT_JOINT_SHOULDER_RIGHT, K4ABT_JOINT_ELBOW_RIGHT },  // upper arm
+        { K4ABT_JOINT_ELBOW_LEFT,    K4ABT_JOINT_WRIST_LEFT,   K4ABT_JOINT_ELBOW_RIGHT,    K4ABT_JOINT_WRIST_RIGHT },  // forearm
+        { K4ABT_JOINT_HIP_LEFT,      K4ABT_JOINT_KNEE_LEFT,    K4ABT_JOINT_HIP_RIGHT,      K4ABT_JOINT_KNEE_RIGHT },   // thigh
+        { K4ABT_JOINT_KNEE_LEFT,     K4ABT_JOINT_ANKLE_LEFT,   K4ABT_JOINT_KNEE_RIGHT,     K4ABT_JOINT_ANKLE_RIGHT },  // shin
+    };
+
+    FORCEINLINE FVector3f ToVector(const k4a_float3_t& P)
+    {
+        return FVector3f(P.xyz.x, P.xyz.y, P.xyz.z);
+    }
+
+    FORCEINLINE bool IsConfident(const k4abt_joint_t& J)
+    {
+        return J.confidence_level >= K4ABT_JOINT_CONFIDENCE_MEDIUM;
+    }
+}
+
+void FAzureBodyReidentifier::Reset()
+{
+    Identities.Reset();
+    NextPersonId = 0;
+}
+
+void FAzureBodyReidentifier::MeasureBones(const k4abt_skeleton_t& Skeleton, float OutLengths[NumBones], bool OutValid[NumBones])
+{
+    for (int32 b = 0; b < NumBones; ++b)
+    {
+        const FBoneDef& Def = GBones[b];
+        float Sum = 0.f;
+        int32 Count = 0;
+
+        const k4abt_joint_t& A0 = Skeleton.joints[Def.A0];
+        const k4abt_joint_t& B0 = Skeleton.joints[Def.B0];
+        if (IsConfident(A0) && IsConfident(B0))
+        {
+            Sum += FVector3f::Distance(ToVector(A0.position), ToVector(B0.position));
+            ++Count;
+        }
+
+        // Symmetric bones list the same pair twice; only count it once
+        const bool bMirrored = (Def.A1 != Def.A0 || Def.B1 != Def.B0);
+        const k4abt_joint_t& A1 = Skeleton.joints[Def.A1];
+        const k4abt_joint_t& B1 = Skeleton.joints[Def.B1];
+        if (bMirrored && IsConfident(A1) && IsConfident(B1))
+        {
+            Sum += FVector3f::Distance(ToVector(A1.position), ToVector(B1.position));
+            ++Count;
+        }
+
+        OutValid[b] = Count > 0;
+        OutLengths[b] = Count > 0 ? Sum / Count : 0.f;
+    }
+}
+
+float FAzureBodyReidentifier::SignatureError(const FIdentity& Identity, const float Lengths[NumBones], const bool Valid[NumBones]) const
+{
+    float Sum = 0.f;
+    int32 Count = 0;
+    for (int32 b = 0; b < NumBones; ++b)
+    {
+        if (!Valid[b] || Identity.SignatureWeight[b] <= 0.f || Identity.Signature[b] <= KINDA_SMALL_NUMBER) continue;
+        Sum += FMath::Abs(Lengths[b] - Identity.Signature[b]) / Identity.Signature[b];
+        ++Count;
+    }
+
+    // Nothing comparable: neutral rather than perfect, so position has to carry the match
+    return Count > 0 ? Sum / Count : Settings.MaxSignatureError * 0.5f;
+}
+
+void FAzureBodyReidentifier::Observe(FIdentity& Identity, int32 TrackerId, const FVector3f& Pelvis,
+                                     const float Lengths[NumBones], const bool Valid[NumBones], double NowSeconds)
+{
+    const float Dt = (float)(NowSeconds - Identity.LastSeen);
+    if (Identity.TrackerId == TrackerId && Dt > KINDA_SMALL_NUMBER)
+    {
+        // Smoothed so a single jittery frame doesn't throw off the extrapolation
+        const FVector3f Instant = (Pelvis - Identity.Position) / Dt;
+        Identity.Velocity = FMath::Lerp(Identity.Velocity, Instant, 0.3f);
+    }
+
+    for (int32 b = 0; b < NumBones; ++b)
+    {
+        if (!Valid[b]) continue;
+        if (Identity.SignatureWeight[b] <= 0.f)
+        {
+            Identity.Signature[b] = Lengths[b];
+            Identity.SignatureWeight[b] = 1.f;
+        }
+        else
+        {
+            Identity.Signature[b] = FMath::Lerp(Identity.Signature[b], Lengths[b], Settings.SignatureSmoothing);
+        }
+    }
+
+    Identity.TrackerId = TrackerId;
+    Identity.Position = Pelvis;
+    Identity.LastSeen = NowSeconds;
+    Identity.bSeenThisFrame = true;
+}
+
+void FAzureBodyReidentifier::Update(FAzureFrameSnapshot& Snapshot, double NowSeconds)
+{
+    for (FIdentity& Id : Identities)
+    {
+        Id.bSeenThisFrame = false;
+    }
+
+    const int32 NumBodies = Snapshot.Bodies.Num();
+    TArray<int32, TInlineAllocator<8>> Unmatched;
+
+    // 1) Known tracker ids keep their person
+    for (int32 i = 0; i < NumBodies; ++i)
+    {
+        FAzureTrackedBody& Body = Snapshot.Bodies[i];
+        FIdentity* Found = Identities.FindByPredicate([&Body](const FIdentity& Id) { return Id.TrackerId == Body.BodyId; });
+        if (!Found)
+        {
+            Unmatched.Add(i);
+            continue;
+        }
+
+        float Lengths[NumBones];
+        bool Valid[NumBones];
+        MeasureBones(Body.Skeleton, Lengths, Valid);
+        Observe(*Found, Body.BodyId, ToVector(Body.Skeleton.joints[K4ABT_JOINT_PELVIS].position), Lengths, Valid, NowSeconds);
+        Body.PersonId = Found->PersonId;
+    }
+
+    // 2) New tracker ids: greedy best match against recently lost people
+    while (Unmatched.Num() > 0)
+    {
+        float BestCost = TNumericLimits<float>::Max();
+        int32 BestUnmatched = INDEX_NONE;
+        int32 BestIdentity = INDEX_NONE;
+
+        for (int32 u = 0; u < Unmatched.Num(); ++u)
+        {
+            const FAzureTrackedBody& Body = Snapshot.Bodies[Unmatched[u]];
+            const FVector3f Pelvis = ToVector(Body.Skeleton.joints[K4ABT_JOINT_PELVIS].position);
+
+            float Lengths[NumBones];
+            bool Valid[NumBones];
+            MeasureBones(Body.Skeleton, Lengths, Valid);
+
+            for (int32 k = 0; k < Identities.Num(); ++k)
+            {
+                const FIdentity& Id = Identities[k];
+                const float Since = (float)(NowSeconds - Id.LastSeen);
+                if (Id.bSeenThisFrame || Since > Settings.WindowSeconds) continue;
+
+                // Extrapolate at most half a second; beyond that velocity is a guess
+                const FVector3f Predicted = Id.Position + Id.Velocity * FMath::Min(Since, 0.5f);
+                const float PosError = FVector3f::Distance(Predicted, Pelvis);
+                const float SigError = SignatureError(Id, Lengths, Valid);
+                if (PosError > Settings.MaxPositionErrorMm || SigError > Settings.MaxSignatureError) continue;
+
+                const float Cost = PosError / Settings.MaxPositionErrorMm + Settings.SignatureWeight * SigError / Settings.MaxSignatureError;
+                if (Cost < BestCost)
+                {
+                    BestCost = Cost;
+                    BestUnmatched = u;
+                    BestIdentity = k;
+                }
+            }
+        }
+
+        if (BestUnmatched == INDEX_NONE)
+        {
+            break;
+        }
+
+        FAzureTrackedBody& Body = Snapshot.Bodies[Unmatched[BestUnmatched]];
+        float Lengths[NumBones];
+        bool Valid[NumBones];
+        MeasureBones(Body.Skeleton, Lengths, Valid);
+
+        FIdentity& Id = Identities[BestIdentity];
+        Observe(Id, Body.BodyId, ToVector(Body.Skeleton.joints[K4ABT_JOINT_PELVIS].position), Lengths, Valid, NowSeconds);
+        Body.PersonId = Id.PersonId;
+        Unmatched.RemoveAtSwap(BestUnmatched);
+    }
+
+    // 3) Nobody to inherit from: a new person
+    for (int32 Index : Unmatched)
+    {
+        FAzureTrackedBody& Body = Snapshot.Bodies[Index];
+
+        FIdentity& Id = Identities.AddDefaulted_GetRef();
+        Id.PersonId = NextPersonId++;
+        FMemory::Memzero(Id.Signature);
+        FMemory::Memzero(Id.SignatureWeight);
+
+        float Lengths[NumBones];
+        bool Valid[NumBones];
+        MeasureBones(Body.Skeleton, Lengths, Valid);
+        Observe(Id, Body.BodyId, ToVector(Body.Skeleton.joints[K4ABT_JOINT_PELVIS].position), Lengths, Valid, NowSeconds);
+        Body.PersonId = Id.PersonId;
+    }
+
+    // Keep the allocation: people come and go all the time
+    Identities.RemoveAllSwap([this, NowSeconds](const FIdentity& Id) { return (NowSeconds - Id.LastSeen) > Settings.WindowSeconds; }, false);
+}
@@ -0,0 +1,161 @@
+#include "AzureBodySpatialIndex.h"
+#include "AzureBodySnapshot.h"
+#include "Algo/Sort.h"
+
+void FAzureBodySpatialIndex::Reset()
+{
+    Nodes.Reset();
+    BodyIds.Reset();
+    Bounds.Reset();
+}
+
+void FAzureBodySpatialIndex::Build(const FAzureFrameSnapshot& Snapshot)
+{
+    Reset();
+
+    const int32 NumBodiesInFrame = FMath::Min(Snapshot.Bodies.Num(), 255);
+    Nodes.Reserve(NumBodiesInFrame * K4ABT_JOINT_COUNT);
+
+    for (int32 Slot = 0; Slot < NumBodiesInFrame; ++Slot)
+    {
+        const FAzureTrackedBody& Body = Snapshot.Bodies[Slot];
+        BodyIds.Add(Body.PersonId);
+        Bounds.Add(Body.WorldBounds);
+
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            FJointNode& N = Nodes.AddDefaulted_GetRef();
+            N.Position = FVector3f(Body.JointsWorld[J]);
+            N.BodySlot = (uint8)Slot;
+            N.JointId = (uint8)J;
+        }
+    }
+
+    BuildRange(0, Nodes.Num());
+}
+
+void FAzureBodySpatialIndex::BuildRange(int32 Begin, int32 End)
+{
+    const int32 Count = End - Begin;
+    if (Count <= 1)
+    {
+        return;
+    }
+
+    // Split on the widest axis of this range
+    FVector3f Min(TNumericLimits<float>::Max());
+    FVector3f Max(-TNumericLimits<float>::Max());
+    for (int32 i = Begin; i < End; ++i)
+    {
+        Min = Min.ComponentMin(Nodes[i].Position);
+        Max = Max.ComponentMax(Nodes[i].Position);
+    }
+    const FVector3f Extent = Max - Min;
+    const uint8 Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+    // Ranges are at most a few hundred joints, a sort is as good as a selection here
+    TArrayView<FJointNode> Range(Nodes.GetData() + Begin, Count);
+    Algo::SortBy(Range, [Axis](const FJointNode& N) { return N.Position[Axis]; });
+
+    const int32 Mid = Begin + Count / 2;
+    Nodes[Mid].SplitAxis = Axis;
+
+    BuildRange(Begin, Mid);
+    BuildRange(Mid + 1, End);
+}
+
+void FAzureBodySpatialIndex::NearestInRange(int32 Begin, int32 End, const FVector3f& P, uint32 JointMask, int32& BestNode, float& BestDistSq) const
+{
+    if (Begin >= End)
+    {
+        return;
+    }
+
+    const int32 Mid = Begin + (End - Begin) / 2;
+    const FJointNode& N = Nodes[Mid];
+
+    if (JointMask & (1u << N.JointId))
+    {
+        const float DistSq = FVector3f::DistSquared(P, N.Position);
+        if (DistSq < BestDistSq)
+        {
+            BestDistSq = DistSq;
+            BestNode = Mid;
+        }
+    }
+
+    if (End - Begin == 1)
+    {
+        return;
+    }
+
+    // Near side first, far side only if the splitting plane is closer than the best so far
+    const float Diff = P[N.SplitAxis] - N.Position[N.SplitAxis];
+    const bool bLeftFirst = Diff < 0.f;
+
+    NearestInRange(bLeftFirst ? Begin : Mid + 1, bLeftFirst ? Mid : End, P, JointMask, BestNode, BestDistSq);
+    if (Diff * Diff < BestDistSq)
+    {
+        NearestInRange(bLeftFirst ? Mid + 1 : Begin, bLeftFirst ? End : Mid, P, JointMask, BestNode, BestDistSq);
+    }
+}
+
+bool FAzureBodySpatialIndex::FindNearestJoint(const FVector& WorldPoint, uint32 JointMask,
+                                              int32& OutBodyId, int32& OutJointId, FVector& OutPosition, float& OutDistance) const
+{
+    int32 BestNode = INDEX_NONE;
+    float BestDistSq = TNumericLimits<float>::Max();
+    NearestInRange(0, Nodes.Num(), FVector3f(WorldPoint), JointMask, BestNode, BestDistSq);
+
+    if (BestNode == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FJointNode& N = Nodes[BestNode];
+    OutBodyId = BodyIds[N.BodySlot];
+    OutJointId = N.JointId;
+    OutPosition = FVector(N.Position);
+    OutDistance = FMath::Sqrt(BestDistSq);
+    return true;
+}
+
+int32 FAzureBodySpatialIndex::FindNearestBody(const FVector& WorldPoint, float& OutDistance) const
+{
+    int32 BodyId = -1;
+    int32 JointId = -1;
+    FVector Position;
+    if (!FindNearestJoint(WorldPoint, AllJoints, BodyId, JointId, Position, OutDistance))
+    {
+        return -1;
+    }
+    return BodyId;
+}
+
+int32 FAzureBodySpatialIndex::FindBodiesInBox(const FBox& WorldBox, TArray<int32>& OutBodyIds, bool bFullyInside) const
+{
+    OutBodyIds.Reset();
+    for (int32 Slot = 0; Slot < Bounds.Num(); ++Slot)
+    {
+        const FBox& B = Bounds[Slot];
+        if (!B.IsValid) continue;
+
+        const bool bHit = bFullyInside ? WorldBox.IsInside(B) : WorldBox.Intersect(B);
+        if (bHit)
+        {
+            OutBodyIds.Add(BodyIds[Slot]);
+        }
+    }
+    return OutBodyIds.Num();
+}
+
+bool FAzureBodySpatialIndex::GetBodyBounds(int32 BodyId, FBox& OutBounds) const
+{
+    const int32 Slot = BodyIds.Find(BodyId);
+    if (Slot == INDEX_NONE)
+    {
+        return false;
+    }
+    OutBounds = Bounds[Slot];
+    return true;
+}
@@ -0,0 +1,36 @@
+// AzureBodyTrackingStats.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+// Per-frame chatter is Verbose: enable with "log LogAzureBodyTracking Verbose"
+DECLARE_LOG_CATEGORY_EXTERN(LogAzureBodyTracking, Log, All);
+
+// Same group as the camera module, so "stat AzureKinect" shows both
+DECLARE_STATS_GROUP(TEXT("AzureKinect"), STATGROUP_AzureKinect, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Body Tracking Tick"), STAT_AzureBT_Tick, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tracker Enqueue (worker)"), STAT_AzureBT_TrackerEnqueue, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tracker Pop (worker)"), STAT_AzureBT_TrackerPop, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snapshot Build (worker)"), STAT_AzureBT_SnapshotBuild, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Re-identification (worker)"), STAT_AzureBT_Reidentify, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Skeleton Fill"), STAT_AzureBT_SkeletonFill, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Active Body Selection"), STAT_AzureBT_Selection, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Index Build"), STAT_AzureBT_SpatialIndex, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gestures"), STAT_AzureBT_Gestures, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Body Index Textures"), STAT_AzureBT_BodyIndexTextures, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Occlusion Mesh Build (worker)"), STAT_AzureBT_OcclusionMesh, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Occlusion Mesh Upload"), STAT_AzureBT_OcclusionUpload, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Occupancy Grid (worker)"), STAT_AzureBT_Occupancy, STATGROUP_AzureKinect, );
+
+// Insights counters
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureBT_TrackerQueueDepth);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureBT_DroppedFrames);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureBT_DepthRecorderQueue);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureBT_TakeRecorderQueue);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureBT_ImuDroppedSamples);
+TRACE_DECLARE_FLOAT_COUNTER_EXTERN(AzureBT_SensorToGameLatencyMs);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureBT_OcclusionTilesRebuilt);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureBT_OccupiedVoxels);
@@ -0,0 +1,227 @@
+#include "AzureBodyTrackingWorker.h"
+#include "AzureBodyTrackingStats.h"
+#include "AzureBodyFrameUtils.h"
+#include "AzureKinectLiveLinkSource.h"
+#include "AzureSkeletonPublisher.h"
+#include "AzureDepthRecorder.h"
+#include "AzureTakeRecorder.h"
+#include "HAL/RunnableThread.h"
+
+FAzureBodyTrackingWorker::FAzureBodyTrackingWorker(k4a_device_t InDevice, k4abt_tracker_t InTracker, const FSettings& InSettings)
+    : Device(InDevice)
+    , Tracker(InTracker)
+    , Settings(InSettings)
+{
+    Reidentifier.Configure(Settings.Reidentification);
+
+    // The two snapshots swap with the game thread's, so all three keep these allocations
+    WorkSnapshot.Bodies.Reserve(Settings.ExpectedMaxBodies);
+    PendingSnapshot.Bodies.Reserve(Settings.ExpectedMaxBodies);
+}
+
+FAzureBodyTrackingWorker::~FAzureBodyTrackingWorker()
+{
+    Shutdown();
+}
+
+bool FAzureBodyTrackingWorker::Start()
+{
+    if (!Device || !Tracker || Thread)
+    {
+        return false;
+    }
+
+    bStopRequested = false;
+    Thread = FRunnableThread::Create(this, TEXT("AzureKinectBodyTracking"), 0, TPri_AboveNormal);
+    return Thread != nullptr;
+}
+
+void FAzureBodyTrackingWorker::Shutdown()
+{
+    if (Thread)
+    {
+        Thread->Kill(true); // calls Stop() and joins
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FScopeLock Lock(&MailboxLock);
+    if (PendingFrame)
+    {
+        k4abt_frame_release(PendingFrame);
+        PendingFrame = nullptr;
+    }
+    bHasPending = false;
+}
+
+void FAzureBodyTrackingWorker::SetDepthRecorder(TSharedPtr<FAzureDepthRecorder> InRecorder)
+{
+    FScopeLock Lock(&RecorderLock);
+    DepthRecorder = InRecorder;
+}
+
+void FAzureBodyTrackingWorker::SetTakeRecorder(TSharedPtr<FAzureTakeRecorder> InRecorder)
+{
+    FScopeLock Lock(&RecorderLock);
+    TakeRecorder = InRecorder;
+}
+
+void FAzureBodyTrackingWorker::SetCameraTransform(const FTransform& InTransform)
+{
+    FScopeLock Lock(&TransformLock);
+    CameraTransform = InTransform;
+}
+
+bool FAzureBodyTrackingWorker::ConsumeLatest(k4abt_frame_t& OutFrame, FAzureFrameSnapshot& OutSnapshot)
+{
+    FScopeLock Lock(&MailboxLock);
+    if (!bHasPending)
+    {
+        return false;
+    }
+
+    OutFrame = PendingFrame;
+    PendingFrame = nullptr;
+    bHasPending = false;
+    Swap(OutSnapshot, PendingSnapshot); // keeps both body arrays' allocations alive
+    return true;
+}
+
+uint32 FAzureBodyTrackingWorker::Run()
+{
+    int32 QueueDepth = 0; // captures enqueued and not popped yet
+
+    while (!bStopRequested)
+    {
+        // Results first, with a short wait: picks a frame up as soon as the GPU is done
+        // and keeps Stop() responsive
+        k4abt_frame_t Frame = nullptr;
+        k4a_wait_result_t Pop;
+        {
+            SCOPE_CYCLE_COUNTER(STAT_AzureBT_TrackerPop);
+            Pop = k4abt_tracker_pop_result(Tracker, &Frame, 5);
+        }
+        if (Pop == K4A_WAIT_RESULT_SUCCEEDED)
+        {
+            QueueDepth = FMath::Max(0, QueueDepth - 1);
+            TRACE_COUNTER_SET(AzureBT_TrackerQueueDepth, QueueDepth);
+            ProcessFrame(Frame);
+        }
+        else if (Pop == K4A_WAIT_RESULT_FAILED)
+        {
+            UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: tracker pop failed, worker stopping"));
+            break;
+        }
+
+        k4a_capture_t Capture = nullptr;
+        const k4a_wait_result_t Wait = k4a_device_get_capture(Device, &Capture, 0);
+        if (Wait == K4A_WAIT_RESULT_TIMEOUT)
+        {
+            continue;
+        }
+        if (Wait != K4A_WAIT_RESULT_SUCCEEDED)
+        {
+            UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: capture failed (%d), worker stopping"), (int)Wait);
+            break;
+        }
+
+        // Never block on a full tracker queue: the capture is simply dropped
+        k4a_wait_result_t Enqueue;
+        {
+            SCOPE_CYCLE_COUNTER(STAT_AzureBT_TrackerEnqueue);
+            Enqueue = k4abt_tracker_enqueue_capture(Tracker, Capture, 0);
+        }
+        if (Enqueue == K4A_WAIT_RESULT_SUCCEEDED)
+        {
+            TRACE_COUNTER_SET(AzureBT_TrackerQueueDepth, ++QueueDepth);
+        }
+        else
+        {
+            TRACE_COUNTER_SET(AzureBT_DroppedFrames, DroppedFrames.Increment());
+        }
+        k4a_capture_release(Capture);
+    }
+    return 0;
+}
+
+void FAzureBodyTrackingWorker::ProcessFrame(k4abt_frame_t Frame)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AzureBT_ProcessFrame);
+
+    FTransform Transform;
+    {
+        FScopeLock Lock(&TransformLock);
+        Transform = CameraTransform;
+    }
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AzureBT_SnapshotBuild);
+        AzureFrame::BuildSnapshot(Frame, Transform, WorkSnapshot);
+    }
+    PublishFrame(Frame, Transform);
+}
+
+void FAzureBodyTrackingWorker::SubmitSnapshot(const FAzureFrameSnapshot& Snapshot)
+{
+    check(!Thread);
+
+    FTransform Transform;
+    {
+        FScopeLock Lock(&TransformLock);
+        Transform = CameraTransform;
+    }
+
+    // Reset + Append keeps WorkSnapshot's allocation, an assignment may not
+    WorkSnapshot.Reset();
+    WorkSnapshot.DeviceTimestampUsec = Snapshot.DeviceTimestampUsec;
+    WorkSnapshot.SystemTimestampNsec = Snapshot.SystemTimestampNsec;
+    WorkSnapshot.Bodies.Append(Snapshot.Bodies);
+    for (FAzureTrackedBody& Body : WorkSnapshot.Bodies)
+    {
+        AzureFrame::UpdateBodyWorld(Body, Transform);
+    }
+    PublishFrame(nullptr, Transform);
+}
+
+void FAzureBodyTrackingWorker::PublishFrame(k4abt_frame_t Frame, const FTransform& Transform)
+{
+    if (Settings.bReidentify)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AzureBT_Reidentify);
+        // Sensor clock, so the re-id window doesn't depend on game frame rate or pause
+        Reidentifier.Update(WorkSnapshot, WorkSnapshot.DeviceTimestampUsec * 1e-6);
+    }
+
+    if (LiveLinkSource)
+    {
+        LiveLinkSource->PushSnapshot_AnyThread(WorkSnapshot, Transform);
+    }
+    if (SkeletonPublisher)
+    {
+        SkeletonPublisher->PushSnapshot_AnyThread(WorkSnapshot, Transform);
+    }
+    {
+        FScopeLock Lock(&RecorderLock);
+        if (DepthRecorder && Frame)
+        {
+            DepthRecorder->SubmitFrame_AnyThread(Frame, WorkSnapshot);
+        }
+        if (TakeRecorder)
+        {
+            TakeRecorder->SubmitFrame_AnyThread(WorkSnapshot);
+        }
+    }
+
+    FScopeLock Lock(&MailboxLock);
+    if (bHasPending)
+    {
+        if (PendingFrame)
+        {
+            k4abt_frame_release(PendingFrame);
+        }
+        TRACE_COUNTER_SET(AzureBT_DroppedFrames, DroppedFrames.Increment());
+    }
+    PendingFrame = Frame;
+    bHasPending = true;
+    Swap(PendingSnapshot, WorkSnapshot);
+}
@@ -0,0 +1,105 @@
+// AzureBodyTrackingWorker.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include <k4a/k4a.h>
+#include <k4abt.h>
+
+#include "AzureBodySnapshot.h"
+#include "AzureBodyReidentifier.h"
+
+class FRunnableThread;
+class FAzureKinectLiveLinkSource;
+class FAzureSkeletonPublisher;
+class FAzureDepthRecorder;
+class FAzureTakeRecorder;
+
+/**
+ * Owns the capture -> tracker -> result loop on its own thread so the game thread
+ * never waits on the sensor. Each tracker frame is turned into a snapshot here
+ * (re-identified, pushed to Live Link), then handed over through a one-slot mailbox:
+ * if the game thread hasn't picked up the previous frame, it's replaced.
+ */
+class FAzureBodyTrackingWorker : public FRunnable
+{
+public:
+    struct FSettings
+    {
+        bool bReidentify = true;
+        int32 ExpectedMaxBodies = 6;   // snapshot arrays are reserved for this many
+        FAzureBodyReidentifier::FSettings Reidentification;
+    };
+
+    /** Device and tracker stay owned by the caller and must outlive the worker. */
+    FAzureBodyTrackingWorker(k4a_device_t InDevice, k4abt_tracker_t InTracker, const FSettings& InSettings);
+    virtual ~FAzureBodyTrackingWorker() override;
+
+    /** Optional, before Start(): Live Link gets every frame straight from this thread. */
+    void SetLiveLinkSource(TSharedPtr<FAzureKinectLiveLinkSource> InSource) { LiveLinkSource = InSource; }
+
+    /** Optional, before Start(): skeleton datagrams go out from this thread too. */
+    void SetSkeletonPublisher(TSharedPtr<FAzureSkeletonPublisher> InPublisher) { SkeletonPublisher = InPublisher; }
+
+    /** Any time, any thread: frames go to this recorder until it's replaced or cleared. */
+    void SetDepthRecorder(TSharedPtr<FAzureDepthRecorder> InRecorder);
+    void SetTakeRecorder(TSharedPtr<FAzureTakeRecorder> InRecorder);
+
+    bool Start();
+
+    /** Joins the thread and releases any frame not yet consumed. Safe to call twice. */
+    void Shutdown();
+
+    /** Game thread: placement applied to snapshots built from now on. */
+    void SetCameraTransform(const FTransform& InTransform);
+
+    /** Game thread: takes the newest frame (caller releases it; null for submitted snapshots) and its snapshot. */
+    bool ConsumeLatest(k4abt_frame_t& OutFrame, FAzureFrameSnapshot& OutSnapshot);
+
+    /**
+     * A recorded frame through the same path as a tracker frame (camera transform, re-identification,
+     * Live Link, streaming, take recording, mailbox), without a sensor. Only while the thread isn't
+     * running; the depth recorder is skipped since there is no capture.
+     */
+    void SubmitSnapshot(const FAzureFrameSnapshot& Snapshot);
+
+    /** Captures the tracker queue refused plus frames replaced before the game thread took them. */
+    int32 GetDroppedFrames() const { return DroppedFrames.GetValue(); }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    void ProcessFrame(k4abt_frame_t Frame);
+    void PublishFrame(k4abt_frame_t Frame, const FTransform& Transform); // WorkSnapshot is built
+
+    k4a_device_t Device = nullptr;
+    k4abt_tracker_t Tracker = nullptr;
+    FRunnableThread* Thread = nullptr;
+    FThreadSafeBool bStopRequested = false;
+
+    FSettings Settings;
+    TSharedPtr<FAzureKinectLiveLinkSource> LiveLinkSource;
+    TSharedPtr<FAzureSkeletonPublisher> SkeletonPublisher;
+
+    FCriticalSection RecorderLock;
+    TSharedPtr<FAzureDepthRecorder> DepthRecorder;
+    TSharedPtr<FAzureTakeRecorder> TakeRecorder;
+
+    FCriticalSection TransformLock;
+    FTransform CameraTransform = FTransform::Identity;
+
+    // Worker-thread only
+    FAzureBodyReidentifier Reidentifier;
+    FAzureFrameSnapshot WorkSnapshot;
+
+    // Mailbox
+    FCriticalSection MailboxLock;
+    k4abt_frame_t PendingFrame = nullptr;
+    FAzureFrameSnapshot PendingSnapshot;
+    bool bHasPending = false;
+
+    FThreadSafeCounter DroppedFrames;
+};
@@ -0,0 +1,69 @@
+// AzureCountingMalloc.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+/**
+ * Forwards everything to the real allocator and counts the allocations made by one thread,
+ * plus frame-sized ones made by any thread (decode workers, the render thread). Only installed
+ * around a measured loop; frees of blocks allocated outside it still reach the allocator that
+ * owns them because nothing is allocated here.
+ */
+class FAzureCountingMalloc final : public FMalloc
+{
+public:
+    /** Smallest allocation counted as frame-sized, well below a binned depth frame (180 KB). */
+    static constexpr SIZE_T FrameSizedBytes = 64 * 1024;
+
+    FMalloc* Inner = nullptr;
+    uint32 ThreadId = 0;
+    uint64 Calls = 0;
+    uint64 Bytes = 0;
+    FThreadSafeCounter64 FrameSizedCalls;
+
+    /** Counts the calling thread from now on. Must stay alive until Uninstall. */
+    void Install()
+    {
+        Inner = GMalloc;
+        ThreadId = FPlatformTLS::GetCurrentThreadId();
+        GMalloc = this;
+    }
+
+    void Uninstall()
+    {
+        GMalloc = Inner;
+    }
+
+    virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+    {
+        Note(Count);
+        return Inner->Malloc(Count, Alignment);
+    }
+    virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        Note(Count);
+        return Inner->Realloc(Original, Count, Alignment);
+    }
+    virtual void Free(void* Original) override { Inner->Free(Original); }
+    virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+    virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+    virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+    virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+    virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+private:
+    void Note(SIZE_T Count)
+    {
+        if (Count >= FrameSizedBytes)
+        {
+            FrameSizedCalls.Increment();
+        }
+        if (Count > 0 && FPlatformTLS::GetCurrentThreadId() == ThreadId)
+        {
+            ++Calls;
+            Bytes += Count;
+        }
+    }
+};
@@ -0,0 +1,250 @@
+#include "AzureDepthCodec.h"
+#include "Misc/Compression.h"
+
+namespace
+{
+    // Nibbles are packed most-significant first into 32-bit words, as in the reference RVL
+    struct FNibbleWriter
+    {
+        TArray<uint8>& Out;
+        uint32 Word = 0;
+        int32 Nibbles = 0;
+
+        explicit FNibbleWriter(TArray<uint8>& InOut) : Out(InOut) {}
+
+        FORCEINLINE void Put(uint32 Nibble)
+        {
+            Word = (Word << 4) | Nibble;
+            if (++Nibbles == 8)
+            {
+                Flush();
+            }
+        }
+
+        FORCEINLINE void EncodeVle(uint32 Value)
+        {
+            do
+            {
+                uint32 Nibble = Value & 0x7;
+                Value >>= 3;
+                if (Value) Nibble |= 0x8; // more to come
+                Put(Nibble);
+            }
+            while (Value);
+        }
+
+        void Flush()
+        {
+            const int32 At = Out.AddUninitialized(sizeof(uint32));
+            FMemory::Memcpy(Out.GetData() + At, &Word, sizeof(uint32));
+            Word = 0;
+            Nibbles = 0;
+        }
+
+        void Finish()
+        {
+            if (Nibbles)
+            {
+                Word <<= 4 * (8 - Nibbles);
+                Flush();
+            }
+        }
+    };
+
+    struct FNibbleReader
+    {
+        const uint8* Data;
+        int32 NumWords;
+        int32 WordIndex = 0;
+        uint32 Word = 0;
+        int32 Nibbles = 0;
+        bool bOverflow = false;
+
+        FNibbleReader(const uint8* InData, int32 InSize) : Data(InData), NumWords(InSize / (int32)sizeof(uint32)) {}
+
+        FORCEINLINE uint32 DecodeVle()
+        {
+            uint32 Value = 0;
+            int32 Shift = 0;
+            uint32 Nibble;
+            do
+            {
+                if (Shift > 30)
+                {
+                    bOverflow = true; // no valid value needs this many nibbles
+                    return 0;
+                }
+                if (!Nibbles)
+                {
+                    if (WordIndex >= NumWords)
+                    {
+                        bOverflow = true;
+                        return 0;
+                    }
+                    FMemory::Memcpy(&Word, Data + WordIndex++ * sizeof(uint32), sizeof(uint32));
+                    Nibbles = 8;
+                }
+                Nibble = Word >> 28;
+                Value |= (Nibble & 0x7) << Shift;
+                Shift += 3;
+                Word <<= 4;
+                --Nibbles;
+            }
+            while (Nibble & 0x8);
+            return Value;
+        }
+    };
+
+    FName SecondStageName(EAzureDepthSecondStage Stage)
+    {
+        switch (Stage)
+        {
+        case EAzureDepthSecondStage::LZ4:   return NAME_LZ4;
+        case EAzureDepthSecondStage::Oodle: return NAME_Oodle;
+        default:                            return NAME_None;
+        }
+    }
+
+    // Encode header: stage, RVL size (needed to size the second-stage output)
+    constexpr int32 EncodeHeaderBytes = 1 + 4;
+
+    // RVL appended to Out after whatever it already holds
+    void RvlAppend(const uint16* Depth, int32 NumPixels, TArray<uint8>& Out)
+    {
+        Out.Reserve(Out.Num() + NumPixels); // ~2x smaller than raw is the common case, so rarely grows
+
+        FNibbleWriter W(Out);
+        const uint16* P = Depth;
+        const uint16* End = Depth + NumPixels;
+        int32 Previous = 0;
+
+        while (P != End)
+        {
+            uint32 Zeros = 0;
+            for (; P != End && *P == 0; ++P) ++Zeros;
+            W.EncodeVle(Zeros);
+
+            uint32 NonZeros = 0;
+            for (const uint16* Q = P; Q != End && *Q != 0; ++Q) ++NonZeros;
+            W.EncodeVle(NonZeros);
+
+            for (uint32 i = 0; i < NonZeros; ++i, ++P)
+            {
+                const int32 Current = *P;
+                const int32 Delta = Current - Previous;
+                W.EncodeVle((uint32)((Delta << 1) ^ (Delta >> 31))); // zigzag
+                Previous = Current;
+            }
+        }
+        W.Finish();
+    }
+
+    void WriteEncodeHeader(uint8* Out, EAzureDepthSecondStage Stage, uint32 RvlSize)
+    {
+        Out[0] = (uint8)Stage;
+        FMemory::Memcpy(Out + 1, &RvlSize, sizeof(uint32));
+    }
+}
+
+namespace AzureDepthCodec
+{
+    void RvlEncode(const uint16* Depth, int32 NumPixels, TArray<uint8>& Out)
+    {
+        Out.Reset();
+        RvlAppend(Depth, NumPixels, Out);
+    }
+
+    bool RvlDecode(const uint8* In, int32 InSize, uint16* OutDepth, int32 NumPixels)
+    {
+        FNibbleReader R(In, InSize);
+        int32 Remaining = NumPixels;
+        int32 Previous = 0;
+
+        while (Remaining > 0)
+        {
+            const uint32 Zeros = R.DecodeVle();
+            if (R.bOverflow || Zeros > (uint32)Remaining) return false;
+            FMemory::Memzero(OutDepth, Zeros * sizeof(uint16));
+            OutDepth += Zeros;
+            Remaining -= Zeros;
+
+            const uint32 NonZeros = R.DecodeVle();
+            if (R.bOverflow || NonZeros > (uint32)Remaining) return false;
+            Remaining -= NonZeros;
+
+            for (uint32 i = 0; i < NonZeros; ++i)
+            {
+                const uint32 Zigzag = R.DecodeVle();
+                const int32 Delta = (int32)(Zigzag >> 1) ^ -(int32)(Zigzag & 1);
+                Previous += Delta;
+                *OutDepth++ = (uint16)Previous;
+            }
+            if (R.bOverflow) return false;
+        }
+        return true;
+    }
+
+    bool Encode(const uint16* Depth, int32 NumPixels, EAzureDepthSecondStage SecondStage, TArray<uint8>& Out, TArray<uint8>& Scratch)
+    {
+        const FName Format = SecondStageName(SecondStage);
+
+        if (Format != NAME_None)
+        {
+            RvlEncode(Depth, NumPixels, Scratch);
+
+            int32 Bound = FCompression::CompressMemoryBound(Format, Scratch.Num());
+            Out.SetNumUninitialized(EncodeHeaderBytes + Bound, false);
+            if (FCompression::CompressMemory(Format, Out.GetData() + EncodeHeaderBytes, Bound, Scratch.GetData(), Scratch.Num()))
+            {
+                Out.SetNum(EncodeHeaderBytes + Bound, false);
+                WriteEncodeHeader(Out.GetData(), SecondStage, (uint32)Scratch.Num());
+                return true;
+            }
+
+            // Store plain RVL rather than fail the frame
+            Out.SetNumUninitialized(EncodeHeaderBytes + Scratch.Num(), false);
+            WriteEncodeHeader(Out.GetData(), EAzureDepthSecondStage::None, (uint32)Scratch.Num());
+            FMemory::Memcpy(Out.GetData() + EncodeHeaderBytes, Scratch.GetData(), Scratch.Num());
+            return true;
+        }
+
+        // No second stage: RVL goes straight in behind the header
+        Out.SetNumUninitialized(EncodeHeaderBytes, false);
+        RvlAppend(Depth, NumPixels, Out);
+        WriteEncodeHeader(Out.GetData(), EAzureDepthSecondStage::None, (uint32)(Out.Num() - EncodeHeaderBytes));
+        return true;
+    }
+
+    bool Decode(const uint8* In, int32 InSize, uint16* OutDepth, int32 NumPixels, TArray<uint8>& Scratch)
+    {
+        if (!In || InSize < EncodeHeaderBytes || !OutDepth)
+        {
+            return false;
+        }
+
+        const EAzureDepthSecondStage Stage = (EAzureDepthSecondStage)In[0];
+        uint32 RvlSize = 0;
+        FMemory::Memcpy(&RvlSize, In + 1, sizeof(uint32));
+
+        const uint8* Payload = In + EncodeHeaderBytes;
+        const int32 PayloadSize = InSize - EncodeHeaderBytes;
+
+        if (Stage == EAzureDepthSecondStage::None)
+        {
+            return RvlSize == (uint32)PayloadSize && RvlDecode(Payload, PayloadSize, OutDepth, NumPixels);
+        }
+
+        const FName Format = SecondStageName(Stage);
+        if (Format == NAME_None || RvlSize > (uint32)NumPixels * 8u)
+        {
+            return false; // unknown stage or implausible size
+        }
+
+        Scratch.SetNumUninitialized(RvlSize, false);
+        if (!FCompression::UncompressMemory(Format, Scratch.GetData(), RvlSize, Payload, PayloadSize))
+        {
+            return false;
+        }
+        return RvlDecode(Scratch.GetData(), RvlSize, OutDepth, NumPixels);
+    }
+}
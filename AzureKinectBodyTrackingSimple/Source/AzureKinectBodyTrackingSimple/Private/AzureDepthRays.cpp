@@ -0,0 +1,65 @@
+#include "AzureDepthRays.h"
+
+namespace AzureDepth
+{
+    bool BuildRayTable(const k4a_calibration_t& Calibration, int32 Step, FAzureDepthRayTable& OutTable)
+    {
+        const int32 W = Calibration.depth_camera_calibration.resolution_width;
+        const int32 H = Calibration.depth_camera_calibration.resolution_height;
+        if (W <= 0 || H <= 0)
+        {
+            return false;
+        }
+
+        OutTable.Width = W;
+        OutTable.Height = H;
+        OutTable.Step = FMath::Max(1, Step);
+        OutTable.PixelIndex.Reset();
+        OutTable.Rays.Reset();
+
+        const int32 S = OutTable.Step;
+        for (int32 y = S / 2; y < H; y += S)
+        {
+            for (int32 x = S / 2; x < W; x += S)
+            {
+                // Unproject at 1 m and divide back so the ray has Z == 1
+                k4a_float2_t P2;
+                P2.xy.x = (float)x;
+                P2.xy.y = (float)y;
+
+                k4a_float3_t P3;
+                int Valid = 0;
+                if (k4a_calibration_2d_to_3d(&Calibration, &P2, 1000.f,
+                    K4A_CALIBRATION_TYPE_DEPTH, K4A_CALIBRATION_TYPE_DEPTH, &P3, &Valid) != K4A_RESULT_SUCCEEDED || !Valid)
+                {
+                    continue;
+                }
+
+                OutTable.PixelIndex.Add(y * W + x);
+                OutTable.Rays.Add(FVector3f(P3.xyz.x, P3.xyz.y, P3.xyz.z) / 1000.f);
+            }
+        }
+
+        return OutTable.Rays.Num() > 0;
+    }
+
+    void SamplePointCloud(
+        const uint16* Depth, int32 Width, int32 Height,
+        const FAzureDepthRayTable& Table,
+        TArray<FVector3f>& OutPoints)
+    {
+        OutPoints.Reset();
+        if (!Depth || Width != Table.Width || Height != Table.Height)
+        {
+            return;
+        }
+
+        OutPoints.Reserve(Table.Rays.Num());
+        for (int32 i = 0; i < Table.Rays.Num(); ++i)
+        {
+            const uint16 D = Depth[Table.PixelIndex[i]];
+            if (D == 0) continue; // invalid / no return
+            OutPoints.Add(Table.Rays[i] * (float)D);
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#include "AzureDepthRecorder.h"
+#include "AzureBodyTrackingStats.h"
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "AzureTakeFile.h" // AzureTake::MaxBodies
+
+FAzureDepthRecorder::~FAzureDepthRecorder()
+{
+    Shutdown();
+}
+
+bool FAzureDepthRecorder::Start(const FString& Path, int32 Width, int32 Height, EAzureDepthSecondStage SecondStage, bool bInVerify)
+{
+    if (Thread || Width <= 0 || Height <= 0)
+    {
+        return false;
+    }
+
+    Writer = IFileManager::Get().CreateFileWriter(*Path);
+    if (!Writer)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: can't create recording '%s'"), *Path);
+        return false;
+    }
+
+    Header.Width = Width;
+    Header.Height = Height;
+    Header.SecondStage = SecondStage;
+    bVerify = bInVerify;
+    AzureDepthFile::WriteHeader(*Writer, Header);
+
+    // Writer-side buffers sized for raw depth up front; RVL only exceeds that on pathological frames
+    const int32 NumPixels = Width * Height;
+    Payload.Reserve(NumPixels * sizeof(uint16) + 64);
+    Scratch.Reserve(NumPixels * sizeof(uint16) + 64);
+    if (bVerify)
+    {
+        VerifyDepth.SetNumUninitialized(NumPixels);
+    }
+    Offsets.Reset(IndexChunkFrames);
+    Timestamps.Reset(IndexChunkFrames);
+    for (FPendingFrame& Frame : Frames)
+    {
+        Frame.Bodies.Bodies.Reserve(AzureTake::MaxBodies);
+        FreeFrames.Push(&Frame);
+    }
+
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    bStopRequested = false;
+    Thread = FRunnableThread::Create(this, TEXT("AzureKinectDepthRecorder"), 0, TPri_BelowNormal);
+    return Thread != nullptr;
+}
+
+void FAzureDepthRecorder::Shutdown()
+{
+    if (Thread)
+    {
+        bStopRequested = true;
+        WorkEvent->Trigger();
+        Thread->WaitForCompletion(); // Run() drains the queue before returning
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+
+    if (Writer)
+    {
+        AzureDepthFile::WriteIndex(*Writer, Offsets, Timestamps);
+        Writer->Close();
+        delete Writer;
+        Writer = nullptr;
+    }
+}
+
+void FAzureDepthRecorder::SubmitFrame_AnyThread(k4abt_frame_t Frame, const FAzureFrameSnapshot& Snapshot)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AzureBT_DepthRecorderSubmit);
+
+    if (!Thread || bStopRequested)
+    {
+        return;
+    }
+    k4a_capture_t FrameCapture = k4abt_frame_get_capture(Frame);
+    if (!FrameCapture)
+    {
+        return;
+    }
+    k4a_image_t DepthImg = k4a_capture_get_depth_image(FrameCapture);
+    k4a_capture_release(FrameCapture);
+    if (!DepthImg)
+    {
+        return;
+    }
+
+    FPendingFrame* Pending = nullptr;
+    if (k4a_image_get_width_pixels(DepthImg) != Header.Width || k4a_image_get_height_pixels(DepthImg) != Header.Height)
+    {
+        k4a_image_release(DepthImg);
+        return;
+    }
+    if (!FreeFrames.Pop(Pending))
+    {
+        // Every slot is still queued: the writer fell behind
+        k4a_image_release(DepthImg);
+        FramesDropped.Increment();
+        return;
+    }
+
+    // The image stays alive until written, so the depth isn't copied here.
+    // Bodies go into the slot's reserved array (assignment would reallocate it).
+    Pending->DeviceTimestampUsec = Snapshot.DeviceTimestampUsec;
+    Pending->Depth = DepthImg;
+    Pending->Bodies.Reset();
+    Pending->Bodies.DeviceTimestampUsec = Snapshot.DeviceTimestampUsec;
+    Pending->Bodies.SystemTimestampNsec = Snapshot.SystemTimestampNsec;
+    Pending->Bodies.Bodies.Append(Snapshot.Bodies);
+
+    Queue.Push(Pending); // can't fail, there are no more slots than ring entries
+    TRACE_COUNTER_SET(AzureBT_DepthRecorderQueue, Queue.Num());
+    WorkEvent->Trigger();
+}
+
+uint32 FAzureDepthRecorder::Run()
+{
+    for (;;)
+    {
+        FPendingFrame* Frame = nullptr;
+        while (Queue.Pop(Frame))
+        {
+            WriteFrame(*Frame);
+            k4a_image_release(Frame->Depth);
+            Frame->Depth = nullptr;
+            FreeFrames.Push(Frame);
+            TRACE_COUNTER_SET(AzureBT_DepthRecorderQueue, Queue.Num());
+        }
+
+        if (bStopRequested)
+        {
+            // The producer stops submitting before Shutdown(), so this drain was the last one
+            break;
+        }
+        WorkEvent->Wait(FTimespan::FromMilliseconds(50));
+    }
+    return 0;
+}
+
+void FAzureDepthRecorder::WriteFrame(const FPendingFrame& Frame)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AzureBT_DepthRecorderWrite);
+
+    const int32 NumPixels = Header.Width * Header.Height;
+    const uint16* Depth = reinterpret_cast<const uint16*>(k4a_image_get_buffer(Frame.Depth));
+    AzureDepthCodec::Encode(Depth, NumPixels, Header.SecondStage, Payload, Scratch);
+
+    if (bVerify)
+    {
+        VerifyDepth.SetNumUninitialized(NumPixels, false);
+        if (!AzureDepthCodec::Decode(Payload.GetData(), Payload.Num(), VerifyDepth.GetData(), NumPixels, Scratch) ||
+            FMemory::Memcmp(VerifyDepth.GetData(), Depth, NumPixels * sizeof(uint16)) != 0)
+        {
+            UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: depth codec round trip mismatch at %llu us"), Frame.DeviceTimestampUsec);
+        }
+    }
+
+    // Grow the index by a fixed chunk rather than doubling, so a long take only reallocates once an hour
+    if (Offsets.Num() == Offsets.Max())
+    {
+        Offsets.Reserve(Offsets.Num() + IndexChunkFrames);
+        Timestamps.Reserve(Timestamps.Num() + IndexChunkFrames);
+    }
+    Offsets.Add(Writer->Tell());
+    Timestamps.Add(Frame.DeviceTimestampUsec);
+    AzureDepthFile::WriteFrame(*Writer, Frame.DeviceTimestampUsec, Payload, Frame.Bodies);
+
+    RawBytes += (int64)NumPixels * sizeof(uint16);
+    StoredBytes += Payload.Num();
+    FramesWritten.Increment();
+}
+
+float FAzureDepthRecorder::GetCompressionRatio() const
+{
+    const int64 Stored = StoredBytes.Load();
+    return Stored > 0 ? (float)((double)RawBytes.Load() / (double)Stored) : 0.f;
+}
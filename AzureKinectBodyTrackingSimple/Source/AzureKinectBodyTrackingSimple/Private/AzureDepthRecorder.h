@@ -0,0 +1,87 @@
+// AzureDepthRecorder.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include <k4abt.h>
+
+#include "AzureDepthRecording.h"
+#include "AzureSpscRing.h"
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Writes an .akdepth file on its own thread. The producer (tracking worker) only keeps a
+ * reference to the depth image and copies the bodies into one of a few recycled slots;
+ * compression and disk I/O happen here. If the writer falls more than a few frames behind,
+ * new frames are dropped rather than queued without bound. Nothing is allocated per frame.
+ */
+class FAzureDepthRecorder : public FRunnable
+{
+public:
+    virtual ~FAzureDepthRecorder() override;
+
+    /** Opens Path and starts the writer thread. bVerify decodes every frame again and checks it's lossless. */
+    bool Start(const FString& Path, int32 Width, int32 Height, EAzureDepthSecondStage SecondStage, bool bVerify);
+
+    /** Writes out queued frames and the index, then closes the file. Safe to call twice. */
+    void Shutdown();
+
+    /**
+     * Producer side (one thread). Takes a reference on the frame's depth image instead of
+     * copying it; the writer releases it once the frame is on disk, so Frame itself may be
+     * released as soon as this returns. Snapshot's bodies are copied into a recycled slot.
+     * Does nothing if every slot is still queued (counted in GetFramesDropped).
+     */
+    void SubmitFrame_AnyThread(k4abt_frame_t Frame, const FAzureFrameSnapshot& Snapshot);
+
+    int32 GetFramesWritten() const { return FramesWritten.GetValue(); }
+    int32 GetFramesDropped() const { return FramesDropped.GetValue(); }
+
+    /** Raw depth size over stored size, so far. */
+    float GetCompressionRatio() const;
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    static constexpr uint32 MaxQueuedFrames = 8; // ~270 ms at 30 fps
+    static constexpr int32 IndexChunkFrames = 30 * 60 * 60; // an hour at 30 fps
+
+    struct FPendingFrame
+    {
+        uint64 DeviceTimestampUsec = 0;
+        k4a_image_t Depth = nullptr;  // referenced, released once written
+        FAzureFrameSnapshot Bodies;
+    };
+
+    void WriteFrame(const FPendingFrame& Frame);
+
+    FArchive* Writer = nullptr;
+    FRunnableThread* Thread = nullptr;
+    FEvent* WorkEvent = nullptr;
+    FThreadSafeBool bStopRequested = false;
+
+    AzureDepthFile::FFileHeader Header;
+    bool bVerify = false;
+
+    // Slots go producer -> writer through Queue and back through FreeFrames
+    FPendingFrame Frames[MaxQueuedFrames];
+    TAzureSpscRing<FPendingFrame*, MaxQueuedFrames> Queue;
+    TAzureSpscRing<FPendingFrame*, MaxQueuedFrames> FreeFrames;
+
+    // Writer-thread only
+    TArray<uint8> Payload;
+    TArray<uint8> Scratch;
+    TArray<uint16> VerifyDepth;
+    TArray<int64> Offsets;          // index, reserved an hour of frames at a time
+    TArray<uint64> Timestamps;
+
+    FThreadSafeCounter FramesWritten;
+    FThreadSafeCounter FramesDropped;
+    TAtomic<int64> RawBytes { 0 };
+    TAtomic<int64> StoredBytes { 0 };
+};
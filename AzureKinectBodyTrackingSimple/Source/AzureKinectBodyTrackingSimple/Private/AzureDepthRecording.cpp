@@ -0,0 +1,218 @@
+#include "AzureDepthRecording.h"
+#include "AzureBodyTrackingStats.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+namespace AzureDepthFile
+{
+    void WriteHeader(FArchive& Ar, const FFileHeader& Header)
+    {
+        uint32 Magic = FileMagic;
+        uint32 Ver = Version;
+        int32 W = Header.Width;
+        int32 H = Header.Height;
+        uint8 Stage = (uint8)Header.SecondStage;
+        Ar << Magic << Ver << W << H << Stage;
+    }
+
+    void WriteFrame(FArchive& Ar, uint64 DeviceTimestampUsec, const TArray<uint8>& DepthPayload, const FAzureFrameSnapshot& Bodies)
+    {
+        uint32 Magic = FrameMagic;
+        int32 PayloadSize = DepthPayload.Num();
+        Ar << Magic << DeviceTimestampUsec << PayloadSize;
+        Ar.Serialize(const_cast<uint8*>(DepthPayload.GetData()), PayloadSize);
+
+        int32 BodyCount = Bodies.Bodies.Num();
+        Ar << BodyCount;
+        for (const FAzureTrackedBody& Body : Bodies.Bodies)
+        {
+            int32 BodyId = Body.BodyId;
+            int32 PersonId = Body.PersonId;
+            Ar << BodyId << PersonId;
+            Ar.Serialize(const_cast<k4abt_skeleton_t*>(&Body.Skeleton), sizeof(k4abt_skeleton_t));
+        }
+    }
+
+    void WriteIndex(FArchive& Ar, const TArray<int64>& Offsets, const TArray<uint64>& Timestamps)
+    {
+        int64 IndexOffset = Ar.Tell();
+        int32 Count = Offsets.Num();
+        Ar << Count;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            int64 Offset = Offsets[i];
+            uint64 Timestamp = Timestamps[i];
+            Ar << Offset << Timestamp;
+        }
+
+        uint32 Magic = FooterMagic;
+        Ar << IndexOffset << Magic;
+    }
+}
+
+bool FAzureDepthRecordingFrame::DecodeDepth(int32 Width, int32 Height, TArray<uint16>& OutDepth, TArray<uint8>& Scratch) const
+{
+    const int32 NumPixels = Width * Height;
+    OutDepth.SetNumUninitialized(NumPixels, false);
+    return AzureDepthCodec::Decode(DepthPayload.GetData(), DepthPayload.Num(), OutDepth.GetData(), NumPixels, Scratch);
+}
+
+FAzureDepthRecordingReader::~FAzureDepthRecordingReader()
+{
+    Close();
+}
+
+bool FAzureDepthRecordingReader::Open(const FString& Path)
+{
+    Close();
+
+    Reader = IFileManager::Get().CreateFileReader(*Path);
+    if (!Reader)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: can't open recording '%s'"), *Path);
+        return false;
+    }
+
+    uint32 Magic = 0, Ver = 0;
+    uint8 Stage = 0;
+    *Reader << Magic << Ver << Header.Width << Header.Height << Stage;
+    Header.SecondStage = (EAzureDepthSecondStage)Stage;
+    if (Reader->IsError() || Magic != AzureDepthFile::FileMagic || Ver != AzureDepthFile::Version)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: '%s' is not a depth recording (or a newer version)"), *Path);
+        Close();
+        return false;
+    }
+    FirstFrameOffset = Reader->Tell();
+
+    // No (valid) index means the recorder didn't shut down cleanly: rebuild it
+    if (!ReadIndex())
+    {
+        UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: '%s' has no index, scanning frames"), *Path);
+        ScanFrames();
+    }
+    return true;
+}
+
+void FAzureDepthRecordingReader::Close()
+{
+    delete Reader;
+    Reader = nullptr;
+    Offsets.Reset();
+    Timestamps.Reset();
+}
+
+bool FAzureDepthRecordingReader::ReadIndex()
+{
+    const int64 FooterSize = sizeof(int64) + sizeof(uint32);
+    const int64 Size = Reader->TotalSize();
+    if (Size < FirstFrameOffset + FooterSize)
+    {
+        return false;
+    }
+
+    Reader->Seek(Size - FooterSize);
+    int64 IndexOffset = 0;
+    uint32 Magic = 0;
+    *Reader << IndexOffset << Magic;
+    if (Magic != AzureDepthFile::FooterMagic || IndexOffset < FirstFrameOffset || IndexOffset >= Size)
+    {
+        return false;
+    }
+
+    Reader->Seek(IndexOffset);
+    int32 Count = 0;
+    *Reader << Count;
+    if (Count < 0 || IndexOffset + (int64)Count * 16 > Size)
+    {
+        return false;
+    }
+
+    Offsets.SetNumUninitialized(Count);
+    Timestamps.SetNumUninitialized(Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        *Reader << Offsets[i] << Timestamps[i];
+    }
+    return !Reader->IsError();
+}
+
+void FAzureDepthRecordingReader::ScanFrames()
+{
+    Offsets.Reset();
+    Timestamps.Reset();
+    Reader->ClearError();
+
+    const int64 Size = Reader->TotalSize();
+    int64 Offset = FirstFrameOffset;
+    while (Offset + 16 <= Size)
+    {
+        Reader->Seek(Offset);
+        uint32 Magic = 0;
+        uint64 Timestamp = 0;
+        int32 PayloadSize = 0;
+        *Reader << Magic << Timestamp << PayloadSize;
+        if (Magic != AzureDepthFile::FrameMagic || PayloadSize < 0)
+        {
+            break; // index (if any) or garbage
+        }
+
+        const int64 BodiesAt = Reader->Tell() + PayloadSize;
+        if (BodiesAt + (int64)sizeof(int32) > Size)
+        {
+            break;
+        }
+        Reader->Seek(BodiesAt);
+        int32 BodyCount = 0;
+        *Reader << BodyCount;
+
+        const int64 End = Reader->Tell() + (int64)BodyCount * (2 * sizeof(int32) + sizeof(k4abt_skeleton_t));
+        if (BodyCount < 0 || End > Size)
+        {
+            break; // last frame was cut off
+        }
+
+        Offsets.Add(Offset);
+        Timestamps.Add(Timestamp);
+        Offset = End;
+    }
+}
+
+bool FAzureDepthRecordingReader::ReadFrame(int32 Index, FAzureDepthRecordingFrame& OutFrame)
+{
+    if (!Reader || !Offsets.IsValidIndex(Index))
+    {
+        return false;
+    }
+
+    Reader->Seek(Offsets[Index]);
+    uint32 Magic = 0;
+    int32 PayloadSize = 0;
+    *Reader << Magic << OutFrame.DeviceTimestampUsec << PayloadSize;
+    if (Magic != AzureDepthFile::FrameMagic || PayloadSize < 0 || PayloadSize > Reader->TotalSize() - Reader->Tell())
+    {
+        return false; // garbage, or a size that runs past the end of the file
+    }
+
+    OutFrame.DepthPayload.SetNumUninitialized(PayloadSize, false);
+    Reader->Serialize(OutFrame.DepthPayload.GetData(), PayloadSize);
+
+    int32 BodyCount = 0;
+    *Reader << BodyCount;
+    if (BodyCount < 0 || BodyCount > 64 ||
+        (int64)BodyCount * (2 * sizeof(int32) + sizeof(k4abt_skeleton_t)) > Reader->TotalSize() - Reader->Tell())
+    {
+        return false;
+    }
+
+    OutFrame.Bodies.Reset();
+    OutFrame.Bodies.DeviceTimestampUsec = OutFrame.DeviceTimestampUsec;
+    for (int32 b = 0; b < BodyCount; ++b)
+    {
+        FAzureTrackedBody& Body = OutFrame.Bodies.Bodies.AddDefaulted_GetRef();
+        *Reader << Body.BodyId << Body.PersonId;
+        Reader->Serialize(&Body.Skeleton, sizeof(k4abt_skeleton_t));
+        Body.FrameIndex = b;
+    }
+    return !Reader->IsError();
+}
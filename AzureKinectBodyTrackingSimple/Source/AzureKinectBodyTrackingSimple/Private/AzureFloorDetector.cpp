@@ -0,0 +1,218 @@
+#include "AzureFloorDetector.h"
+#include "AzureDepthRays.h"
+
+FAzureFloorDetector::FAzureFloorDetector()
+    : Random(0x4b34a)
+{
+}
+
+void FAzureFloorDetector::Reset()
+{
+    Estimate = FAzureFloorEstimate();
+    StableFrames = 0;
+    DisagreeFrames = 0;
+}
+
+void FAzureFloorDetector::ProcessDepthFrame(const uint16* Depth, int32 Width, int32 Height,
+                                            const FAzureDepthRayTable& Rays, const FVector3f* GravityDown)
+{
+    AzureDepth::SamplePointCloud(Depth, Width, Height, Rays, FramePoints);
+    ProcessPoints(FramePoints, GravityDown);
+}
+
+void FAzureFloorDetector::ProcessPoints(TArrayView<const FVector3f> Points, const FVector3f* GravityDown)
+{
+    const int32 Num = Points.Num();
+    if (Num < 3)
+    {
+        return;
+    }
+
+    // Without gravity, up is the depth camera's -Y with a looser limit for how the sensor is mounted
+    const FVector3f Up = GravityDown ? -*GravityDown : FVector3f(0.f, -1.f, 0.f);
+    const float MaxTilt = GravityDown ? Settings.MaxTiltFromGravityDegrees : Settings.MaxTiltWithoutGravityDegrees;
+    const float MinCosToUp = FMath::Cos(FMath::DegreesToRadians(MaxTilt));
+
+    // Start from last frame's answer so the estimate only ever gets replaced by something better
+    FFloorPlane Best;
+    int32 BestInliers = -1;
+    if (Estimate.bValid && FVector3f::DotProduct(Estimate.Up, Up) >= MinCosToUp)
+    {
+        Best.N = Estimate.Up;
+        Best.D = Estimate.HeightMm;
+        BestInliers = CountInliers(Best, Points);
+    }
+
+    for (int32 h = 0; h < Settings.HypothesesPerFrame; ++h)
+    {
+        const FVector3f& A = Points[Random.RandHelper(Num)];
+        const FVector3f& B = Points[Random.RandHelper(Num)];
+        const FVector3f& C = Points[Random.RandHelper(Num)];
+
+        FVector3f N = FVector3f::CrossProduct(B - A, C - A);
+        const float Len = N.Size();
+        if (Len < 1.f) continue; // degenerate (collinear / repeated)
+        N /= Len;
+
+        // Orient so the sensor (origin) sits on the positive side
+        float D = -FVector3f::DotProduct(N, A);
+        if (D < 0.f)
+        {
+            N = -N;
+            D = -D;
+        }
+
+        if (FVector3f::DotProduct(N, Up) < MinCosToUp) continue; // wall, or too steep to be the floor
+
+        FFloorPlane Candidate;
+        Candidate.N = N;
+        Candidate.D = D;
+        const int32 Inliers = CountInliers(Candidate, Points);
+        if (IsBetter(Candidate, Inliers, Best, BestInliers))
+        {
+            Best = Candidate;
+            BestInliers = Inliers;
+        }
+    }
+
+    const float Ratio = (float)BestInliers / (float)Num;
+    if (BestInliers < 3 || Ratio < Settings.MinInlierRatio)
+    {
+        return; // nothing floor-like this frame, keep the previous estimate
+    }
+
+    Accept(Refine(Best, Points), Ratio);
+}
+
+int32 FAzureFloorDetector::CountInliers(const FFloorPlane& Plane, TArrayView<const FVector3f> Points) const
+{
+    int32 Count = 0;
+    const float T = Settings.InlierThresholdMm;
+    for (const FVector3f& P : Points)
+    {
+        Count += (FMath::Abs(FVector3f::DotProduct(Plane.N, P) + Plane.D) <= T) ? 1 : 0;
+    }
+    return Count;
+}
+
+bool FAzureFloorDetector::IsBetter(const FFloorPlane& Candidate, int32 CandidateInliers, const FFloorPlane& Best, int32 BestInliers) const
+{
+    if (BestInliers < 0) return true;
+
+    // The floor is the lowest large horizontal plane, not the biggest one (tables, beds...)
+    const float Margin = Settings.LowerPlaneMarginMm;
+    const float Frac = Settings.LowerPlaneMinInlierFraction;
+    if (Candidate.D > Best.D + Margin && CandidateInliers >= BestInliers * Frac) return true;
+    if (Best.D > Candidate.D + Margin && BestInliers >= CandidateInliers * Frac) return false;
+
+    return CandidateInliers > BestInliers;
+}
+
+FAzureFloorDetector::FFloorPlane FAzureFloorDetector::Refine(const FFloorPlane& Plane, TArrayView<const FVector3f> Points) const
+{
+    // Least-squares tilt correction in the plane's own frame: h = a*u + b*v + c
+    const FVector3f N = Plane.N;
+    const FVector3f U = FVector3f::CrossProduct(N, FMath::Abs(N.X) < 0.9f ? FVector3f(1.f, 0.f, 0.f) : FVector3f(0.f, 1.f, 0.f)).GetSafeNormal();
+    const FVector3f V = FVector3f::CrossProduct(N, U);
+
+    double Suu = 0, Suv = 0, Svv = 0, Su = 0, Sv = 0, Sn = 0;
+    double Suh = 0, Svh = 0, Sh = 0;
+    const float T = Settings.InlierThresholdMm;
+
+    for (const FVector3f& P : Points)
+    {
+        const double H = FVector3f::DotProduct(N, P) + Plane.D;
+        if (FMath::Abs(H) > T) continue;
+
+        const double u = FVector3f::DotProduct(U, P);
+        const double v = FVector3f::DotProduct(V, P);
+        Suu += u * u; Suv += u * v; Svv += v * v;
+        Su += u; Sv += v; Sn += 1.0;
+        Suh += u * H; Svh += v * H; Sh += H;
+    }
+
+    if (Sn < 3.0)
+    {
+        return Plane;
+    }
+
+    // Cramer's rule on the 3x3 normal equations
+    const double Det = Suu * (Svv * Sn - Sv * Sv) - Suv * (Suv * Sn - Sv * Su) + Su * (Suv * Sv - Svv * Su);
+    if (FMath::Abs(Det) < 1e-9)
+    {
+        return Plane;
+    }
+
+    const double a = (Suh * (Svv * Sn - Sv * Sv) - Suv * (Svh * Sn - Sv * Sh) + Su * (Svh * Sv - Svv * Sh)) / Det;
+    const double b = (Suu * (Svh * Sn - Sh * Sv) - Suh * (Suv * Sn - Sv * Su) + Su * (Suv * Sh - Svh * Su)) / Det;
+    const double c = (Suu * (Svv * Sh - Sv * Svh) - Suv * (Suv * Sh - Svh * Su) + Suh * (Suv * Sv - Svv * Su)) / Det;
+
+    // h - a*u - b*v - c = 0  =>  (N - aU - bV).p + (D - c) = 0
+    const FVector3f NewN = N - U * (float)a - V * (float)b;
+    const float Len = NewN.Size();
+    if (Len < KINDA_SMALL_NUMBER)
+    {
+        return Plane;
+    }
+
+    FFloorPlane Out;
+    Out.N = NewN / Len;
+    Out.D = (Plane.D - (float)c) / Len;
+    return Out;
+}
+
+void FAzureFloorDetector::Accept(const FFloorPlane& Plane, float InlierRatio)
+{
+    if (!Estimate.bValid)
+    {
+        Estimate.Up = Plane.N;
+        Estimate.HeightMm = Plane.D;
+        Estimate.InlierRatio = InlierRatio;
+        Estimate.bValid = true;
+        StableFrames = 0;
+        DisagreeFrames = 0;
+        return;
+    }
+
+    const float AngleToNew = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector3f::DotProduct(Estimate.Up, Plane.N), -1.f, 1.f)));
+    const float HeightToNew = FMath::Abs(Plane.D - Estimate.HeightMm);
+
+    // Converged and suddenly far off: either noise or the rig was bumped. Persisting means bumped.
+    if (Estimate.bConverged && (AngleToNew > Settings.JumpAngleDegrees || HeightToNew > Settings.JumpHeightMm))
+    {
+        if (++DisagreeFrames < Settings.FramesToAcceptJump)
+        {
+            return;
+        }
+
+        Estimate.Up = Plane.N;
+        Estimate.HeightMm = Plane.D;
+        Estimate.InlierRatio = InlierRatio;
+        Estimate.bConverged = false;
+        StableFrames = 0;
+        DisagreeFrames = 0;
+        return;
+    }
+    DisagreeFrames = 0;
+
+    const FVector3f PrevUp = Estimate.Up;
+    const float PrevHeight = Estimate.HeightMm;
+
+    const float Alpha = FMath::Clamp(Settings.Smoothing, 0.f, 1.f);
+    Estimate.Up = FMath::Lerp(Estimate.Up, Plane.N, Alpha).GetSafeNormal();
+    Estimate.HeightMm = FMath::Lerp(Estimate.HeightMm, Plane.D, Alpha);
+    Estimate.InlierRatio = InlierRatio;
+
+    const float StepAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector3f::DotProduct(PrevUp, Estimate.Up), -1.f, 1.f)));
+    const float StepHeight = FMath::Abs(Estimate.HeightMm - PrevHeight);
+    if (StepAngle < Settings.StableAngleDegrees && StepHeight < Settings.StableHeightMm)
+    {
+        ++StableFrames;
+    }
+    else
+    {
+        StableFrames = 0;
+    }
+
+    Estimate.bConverged = Estimate.bConverged || StableFrames >= Settings.StableFramesToConverge;
+}
@@ -0,0 +1,207 @@
+#include "AzureGestureEngine.h"
+#include "AzureGestureAsset.h"
+#include "AzureBodySnapshot.h"
+
+namespace
+{
+    // Bodies not seen for this long lose their gesture state
+    constexpr float StaleBodySeconds = 2.f;
+
+    FORCEINLINE FVector3f ToVector(const k4a_float3_t& P)
+    {
+        return FVector3f(P.xyz.x, P.xyz.y, P.xyz.z);
+    }
+}
+
+void FAzureGestureEngine::SetGestures(const TArray<UAzureGestureAsset*>& Assets)
+{
+    Predicates.Reset();
+    Steps.Reset();
+    Gestures.Reset();
+
+    for (const UAzureGestureAsset* Asset : Assets)
+    {
+        // Keep indices aligned with Assets even for empty slots
+        FCompiledGesture& G = Gestures.AddDefaulted_GetRef();
+        G.FirstStep = Steps.Num();
+        if (!Asset) continue;
+
+        G.CooldownSeconds = Asset->CooldownSeconds;
+        for (const FAzureGestureStep& SrcStep : Asset->Steps)
+        {
+            FCompiledStep& S = Steps.AddDefaulted_GetRef();
+            S.FirstPredicate = Predicates.Num();
+            S.NumPredicates = SrcStep.Predicates.Num();
+            S.HoldSeconds = SrcStep.HoldSeconds;
+            S.MaxSecondsToNext = SrcStep.MaxSecondsToNextStep;
+
+            for (const FAzureGesturePredicate& SrcPred : SrcStep.Predicates)
+            {
+                FCompiledPredicate& P = Predicates.AddDefaulted_GetRef();
+                P.Type = (uint8)SrcPred.Type;
+                P.JointA = (uint8)SrcPred.JointA;
+                P.JointB = (uint8)SrcPred.JointB;
+                P.Axis = (uint8)SrcPred.Axis;
+                P.bGreater = SrcPred.Comparison == EAzureGestureComparison::Greater;
+                P.ThresholdMm = SrcPred.ThresholdCm * 10.f;
+            }
+        }
+        G.NumSteps = Steps.Num() - G.FirstStep;
+    }
+
+    PredicateResults.SetNumZeroed(Predicates.Num());
+    StepResults.SetNumZeroed(Steps.Num());
+    Bodies.Reset(); // progress arrays are sized for the old gestures
+}
+
+void FAzureGestureEngine::Reset()
+{
+    // Slots are kept (and reused by FindOrAddBody) so people coming and going don't allocate
+    for (FBodyState& B : Bodies)
+    {
+        B.BodyId = -1;
+    }
+}
+
+FAzureGestureEngine::FBodyState& FAzureGestureEngine::FindOrAddBody(int32 BodyId)
+{
+    FBodyState* Free = nullptr;
+    for (FBodyState& B : Bodies)
+    {
+        if (B.BodyId == BodyId) return B;
+        if (B.BodyId < 0 && !Free) Free = &B;
+    }
+
+    FBodyState& B = Free ? *Free : Bodies.AddDefaulted_GetRef();
+    B.BodyId = BodyId;
+    B.LastSeen = 0.f;
+    B.PrevTime = 0.f;
+    B.bHasPrev = false;
+    B.PrevJoints.SetNumZeroed(K4ABT_JOINT_COUNT);
+    B.Progress.Reset();
+    B.Progress.SetNum(Gestures.Num());
+    return B;
+}
+
+void FAzureGestureEngine::Update(const FAzureFrameSnapshot& Snapshot, float NowSeconds, TArray<FAzureGestureEvent>& OutEvents)
+{
+    if (Gestures.Num() == 0)
+    {
+        return;
+    }
+
+    for (const FAzureTrackedBody& Body : Snapshot.Bodies)
+    {
+        FBodyState& State = FindOrAddBody(Body.PersonId);
+        const k4abt_joint_t* Joints = Body.Skeleton.joints;
+
+        // Body frame, once per body: Azure +Y is down; Forward = Up x Right in this right-handed frame
+        const FVector3f Up(0.f, -1.f, 0.f);
+        FVector3f Right = ToVector(Joints[K4ABT_JOINT_SHOULDER_RIGHT].position) - ToVector(Joints[K4ABT_JOINT_SHOULDER_LEFT].position);
+        Right = (Right - Up * FVector3f::DotProduct(Right, Up)).GetSafeNormal(KINDA_SMALL_NUMBER, FVector3f(-1.f, 0.f, 0.f));
+        const FVector3f Forward = FVector3f::CrossProduct(Up, Right);
+        const FVector3f Axes[3] = { Up, Right, Forward };
+
+        const float Dt = State.bHasPrev ? (NowSeconds - State.PrevTime) : 0.f;
+        const float InvDt = Dt > KINDA_SMALL_NUMBER ? 1.f / Dt : 0.f;
+
+        // 1) Every predicate, flat
+        for (int32 i = 0; i < Predicates.Num(); ++i)
+        {
+            const FCompiledPredicate& P = Predicates[i];
+            const FVector3f A = ToVector(Joints[P.JointA].position);
+
+            FVector3f Delta;
+            if (P.Type == (uint8)EAzureGesturePredicateType::JointRelation)
+            {
+                Delta = A - ToVector(Joints[P.JointB].position);
+            }
+            else
+            {
+                if (InvDt == 0.f) { PredicateResults[i] = false; continue; }
+                Delta = (A - State.PrevJoints[P.JointA]) * InvDt;
+            }
+
+            const float Value = (P.Axis == (uint8)EAzureGestureAxis::Distance)
+                ? Delta.Size()
+                : FVector3f::DotProduct(Delta, Axes[P.Axis]);
+
+            PredicateResults[i] = P.bGreater ? (Value > P.ThresholdMm) : (Value < P.ThresholdMm);
+        }
+
+        // 2) Every step: AND of its predicates
+        for (int32 s = 0; s < Steps.Num(); ++s)
+        {
+            const FCompiledStep& S = Steps[s];
+            bool bAll = true;
+            for (int32 p = 0; p < S.NumPredicates && bAll; ++p)
+            {
+                bAll = PredicateResults[S.FirstPredicate + p];
+            }
+            StepResults[s] = bAll;
+        }
+
+        // 3) Every gesture's step machine
+        for (int32 g = 0; g < Gestures.Num(); ++g)
+        {
+            const FCompiledGesture& G = Gestures[g];
+            if (G.NumSteps == 0) continue;
+
+            FGestureProgress& Prog = State.Progress[g];
+
+            // After firing, the first step has to be released before the gesture can start again
+            if (Prog.bWaitForRelease)
+            {
+                if (StepResults[G.FirstStep]) continue;
+                Prog.bWaitForRelease = false;
+            }
+
+            const FCompiledStep& S = Steps[G.FirstStep + Prog.Step];
+            if (StepResults[G.FirstStep + Prog.Step])
+            {
+                if (Prog.HoldStart < 0.f) Prog.HoldStart = NowSeconds;
+                if (NowSeconds - Prog.HoldStart < S.HoldSeconds) continue;
+
+                // Step complete
+                Prog.HoldStart = -1.f;
+                Prog.LastStepDoneAt = NowSeconds;
+                if (++Prog.Step < G.NumSteps) continue;
+
+                Prog.Step = 0;
+                Prog.bWaitForRelease = true;
+                if (NowSeconds - Prog.LastFiredAt >= G.CooldownSeconds)
+                {
+                    Prog.LastFiredAt = NowSeconds;
+                    FAzureGestureEvent& E = OutEvents.AddDefaulted_GetRef();
+                    E.BodyId = Body.PersonId;
+                    E.GestureIndex = g;
+                }
+            }
+            else
+            {
+                Prog.HoldStart = -1.f;
+                if (Prog.Step > 0 && NowSeconds - Prog.LastStepDoneAt > Steps[G.FirstStep + Prog.Step - 1].MaxSecondsToNext)
+                {
+                    Prog.Step = 0; // sequence timed out
+                }
+            }
+        }
+
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            State.PrevJoints[J] = ToVector(Joints[J].position);
+        }
+        State.PrevTime = NowSeconds;
+        State.bHasPrev = true;
+        State.LastSeen = NowSeconds;
+    }
+
+    // Free the slots of bodies that left
+    for (FBodyState& B : Bodies)
+    {
+        if (B.BodyId >= 0 && (NowSeconds - B.LastSeen) > StaleBodySeconds)
+        {
+            B.BodyId = -1;
+        }
+    }
+}
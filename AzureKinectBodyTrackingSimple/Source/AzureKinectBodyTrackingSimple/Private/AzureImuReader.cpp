@@ -0,0 +1,101 @@
+#include "AzureImuReader.h"
+#include "AzureBodyTrackingStats.h"
+#include "HAL/RunnableThread.h"
+
+namespace
+{
+    FMatrix RotationFromExtrinsics(const k4a_calibration_extrinsics_t& E)
+    {
+        // k4a stores a row-major 3x3; FMatrix::TransformVector treats rows as basis vectors,
+        // so the transpose goes in to get R * v.
+        const float* R = E.rotation;
+        return FMatrix(
+            FPlane(R[0], R[3], R[6], 0.f),
+            FPlane(R[1], R[4], R[7], 0.f),
+            FPlane(R[2], R[5], R[8], 0.f),
+            FPlane(0.f, 0.f, 0.f, 1.f));
+    }
+
+    FORCEINLINE FVector ToVector(const k4a_float3_t& V)
+    {
+        return FVector(V.xyz.x, V.xyz.y, V.xyz.z);
+    }
+}
+
+FAzureImuReader::FAzureImuReader(k4a_device_t InDevice, const k4a_calibration_t& Calibration)
+    : Device(InDevice)
+{
+    AccelToDepth = RotationFromExtrinsics(Calibration.extrinsics[K4A_CALIBRATION_TYPE_ACCEL][K4A_CALIBRATION_TYPE_DEPTH]);
+    GyroToDepth  = RotationFromExtrinsics(Calibration.extrinsics[K4A_CALIBRATION_TYPE_GYRO][K4A_CALIBRATION_TYPE_DEPTH]);
+}
+
+FAzureImuReader::~FAzureImuReader()
+{
+    Shutdown();
+}
+
+bool FAzureImuReader::Start()
+{
+    if (!Device || Thread)
+    {
+        return false;
+    }
+
+    if (k4a_device_start_imu(Device) != K4A_RESULT_SUCCEEDED)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: k4a_device_start_imu failed"));
+        return false;
+    }
+    bImuStarted = true;
+
+    bStopRequested = false;
+    Thread = FRunnableThread::Create(this, TEXT("AzureKinectImu"), 0, TPri_AboveNormal);
+    return Thread != nullptr;
+}
+
+void FAzureImuReader::Shutdown()
+{
+    if (Thread)
+    {
+        Thread->Kill(true); // calls Stop() and joins
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (bImuStarted)
+    {
+        k4a_device_stop_imu(Device);
+        bImuStarted = false;
+    }
+}
+
+uint32 FAzureImuReader::Run()
+{
+    while (!bStopRequested)
+    {
+        // Short timeout so Stop() is honoured promptly
+        k4a_imu_sample_t Raw;
+        const k4a_wait_result_t Wait = k4a_device_get_imu_sample(Device, &Raw, 10);
+        if (Wait == K4A_WAIT_RESULT_TIMEOUT)
+        {
+            continue;
+        }
+        if (Wait != K4A_WAIT_RESULT_SUCCEEDED)
+        {
+            UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: IMU read failed (%d), reader stopping"), (int)Wait);
+            break;
+        }
+
+        FAzureImuSample S;
+        S.Accel = AccelToDepth.TransformVector(ToVector(Raw.acc_sample));
+        S.Gyro = GyroToDepth.TransformVector(ToVector(Raw.gyro_sample));
+        S.TimestampUsec = Raw.acc_timestamp_usec;
+
+        // Never wait on the consumer: if it's a full ring behind, the sample is dropped
+        if (!Samples.Push(S))
+        {
+            DroppedSamples.Increment();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+// AzureImuReader.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include <k4a/k4a.h>
+
+#include "AzureImuFilter.h"
+#include "AzureSpscRing.h"
+
+class FRunnableThread;
+
+/**
+ * Owns a thread that drains k4a_device_get_imu_sample and pushes samples
+ * (rotated into the depth camera frame) into a lock-free ring for the game thread.
+ * Never touches the capture queue, so it can't stall camera capture.
+ */
+class FAzureImuReader : public FRunnable
+{
+public:
+    FAzureImuReader(k4a_device_t InDevice, const k4a_calibration_t& Calibration);
+    virtual ~FAzureImuReader() override;
+
+    /** Starts the IMU stream and the reader thread. Cameras must already be running. */
+    bool Start();
+
+    /** Stops the thread and the IMU stream. Safe to call twice. */
+    void Shutdown();
+
+    /** Consumer side (game thread). */
+    bool PopSample(FAzureImuSample& OutSample) { return Samples.Pop(OutSample); }
+
+    int32 GetDroppedSamples() const { return DroppedSamples.GetValue(); }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    k4a_device_t Device = nullptr;
+    FRunnableThread* Thread = nullptr;
+    FThreadSafeBool bStopRequested = false;
+    bool bImuStarted = false;
+
+    // Sensor extrinsics: IMU frames -> depth camera frame (rotation only)
+    FMatrix AccelToDepth = FMatrix::Identity;
+    FMatrix GyroToDepth = FMatrix::Identity;
+
+    // ~0.6 s of samples at 1.6 kHz
+    TAzureSpscRing<FAzureImuSample, 1024> Samples;
+    FThreadSafeCounter DroppedSamples;
+};
@@ -0,0 +1,1400 @@
+#include "AzureKinectBenchmarkCommandlet.h"
+#include "AzureBodyTrackingStats.h"
+#include "AzureCountingMalloc.h"
+#include "AzureKinectBodyTrackingComponent.h" // FBodyJointData
+#include "AzureKinectImageUtils.h"
+#include "AzureColorDecoder.h"
+#include "AzureKinectSelfTest.h"
+#include "AzureKinectSoak.h"
+#include "AzureDepthFilter.h"
+#include "AzureFloorDetector.h"
+#include "AzureOcclusionMesh.h"
+#include "AzureOccupancyGrid.h"
+#include "AzureDepthRays.h"
+#include "AzureKinectLookSolver.h"
+#include "AzureKinectSkeletonUtils.h"
+#include "AzureBodyFrameUtils.h"
+#include "AzureBodySpatialIndex.h"
+#include "AzureActiveSelector.h"
+#include "AzureScoredSelector.h"
+#include "AzureGestureEngine.h"
+#include "AzureGestureAsset.h"
+#include "AzureDepthCodec.h"
+#include "AzureDepthRecording.h"
+#include "AzureTakeFile.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProperties.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    constexpr int32 SyntheticDepthWidth = 640;  // NFOV unbinned
+    constexpr int32 SyntheticDepthHeight = 576;
+    constexpr int32 ColorWidth = 1280;          // 720p BGRA
+    constexpr int32 ColorHeight = 720;
+    constexpr int32 MaxDepthFrames = 16;        // distinct depth frames, cycled
+    constexpr int32 GestureCrowdBodies = 6;     // the tracker's maximum
+    constexpr int32 JpegQuality = 85;            // close to what the sensor's MJPEG modes send
+
+    /** The sensor's color resolutions, for the decode stages. */
+    struct FColorMode
+    {
+        const TCHAR* Name;
+        int32 Width;
+        int32 Height;
+    };
+    const FColorMode ColorModes[] =
+    {
+        { TEXT("720p"), 1280, 720 },
+        { TEXT("1080p"), 1920, 1080 },
+        { TEXT("1440p"), 2560, 1440 },
+        { TEXT("1536p"), 2048, 1536 },
+        { TEXT("2160p"), 3840, 2160 },
+        { TEXT("3072p"), 4096, 3072 },
+    };
+    constexpr double GestureBudgetMs = 0.1;     // whole gesture set, whole crowd, one frame
+
+    /** Stages whose scratch is reserved up front: once warm, a single allocation fails the run. */
+    const TCHAR* const AllocationFreeStages[] =
+    {
+        TEXT("DepthToGrayscale"),
+        TEXT("ColorCopy"),
+        TEXT("FindClosestBodyId"),
+        TEXT("ActiveSelector.WaveLastRaised"),
+        TEXT("ScoredSelector"),
+        TEXT("Gestures"),
+        TEXT("DepthFilter"),
+        TEXT("DepthFilter.SingleThread"),
+        TEXT("FloorDetector"),
+        TEXT("OccupancyGrid.Integrate"),
+    };
+
+    struct FStageResult
+    {
+        FString Name;
+        int32 Iterations = 0;
+        double MeanNs = 0.0;
+        double MedianNs = 0.0;
+        double P95Ns = 0.0;
+        double MinNs = 0.0;
+        double AllocsPerIteration = 0.0;
+        double AllocBytesPerIteration = 0.0;
+        double InputBytesPerIteration = 0.0; // 0 when throughput in bytes means nothing
+        TArray<TPair<FString, double>> Extra;
+    };
+
+    class FStageRunner
+    {
+    public:
+        FStageRunner(int32 InIterations, int32 InWarmup)
+            : Iterations(InIterations)
+            , Warmup(InWarmup)
+        {
+            Cycles.SetNumUninitialized(Iterations);
+        }
+
+        /** Body(i) is one frame's worth of work. Returns the result; valid until the next Run. */
+        template <typename FunctorType>
+        FStageResult& Run(const TCHAR* Name, double InputBytesPerIteration, FunctorType&& Body)
+        {
+            for (int32 i = 0; i < Warmup; ++i)
+            {
+                Body(i);
+            }
+
+            Counter.Calls = 0;
+            Counter.Bytes = 0;
+
+            Counter.Install();
+            for (int32 i = 0; i < Iterations; ++i)
+            {
+                const uint64 Start = FPlatformTime::Cycles64();
+                Body(i);
+                Cycles[i] = FPlatformTime::Cycles64() - Start;
+            }
+            Counter.Uninstall();
+
+            FStageResult& R = Results.AddDefaulted_GetRef();
+            R.Name = Name;
+            R.Iterations = Iterations;
+            R.InputBytesPerIteration = InputBytesPerIteration;
+            R.AllocsPerIteration = (double)Counter.Calls / Iterations;
+            R.AllocBytesPerIteration = (double)Counter.Bytes / Iterations;
+
+            const double NsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1e9;
+            Cycles.Sort();
+            uint64 Total = 0;
+            for (uint64 C : Cycles)
+            {
+                Total += C;
+            }
+            R.MeanNs = (double)Total / Iterations * NsPerCycle;
+            R.MedianNs = Cycles[Iterations / 2] * NsPerCycle;
+            R.P95Ns = Cycles[FMath::Min(Iterations - 1, Iterations * 95 / 100)] * NsPerCycle;
+            R.MinNs = Cycles[0] * NsPerCycle;
+
+            UE_LOG(LogAzureBodyTracking, Display, TEXT("  %-30s %12.0f ns  (p95 %12.0f)  %7.2f allocs"),
+                Name, R.MeanNs, R.P95Ns, R.AllocsPerIteration);
+            return R;
+        }
+
+        TArray<FStageResult> Results;
+
+    private:
+        int32 Iterations;
+        int32 Warmup;
+        TArray<uint64> Cycles;
+        FAzureCountingMalloc Counter;
+    };
+
+    struct FBenchmarkInputs
+    {
+        FString Source = TEXT("synthetic");
+        int32 DepthWidth = SyntheticDepthWidth;
+        int32 DepthHeight = SyntheticDepthHeight;
+        TArray<TArray<uint16>> Depth;
+        TArray<TArray<uint16>> CleanDepth; // synthetic only: Depth before noise, dropouts and flying pixels
+        TArray<TArray<uint8>> Color;
+        TArray<FAzureFrameSnapshot> Frames;
+    };
+
+    /** Rest pose relative to the pelvis, Azure camera space (mm, +Y down, subject facing the sensor). */
+    const FVector3f SkeletonTemplate[K4ABT_JOINT_COUNT] =
+    {
+        {    0.f,    0.f,    0.f }, // PELVIS
+        {    0.f, -200.f,    0.f }, // SPINE_NAVEL
+        {    0.f, -380.f,    0.f }, // SPINE_CHEST
+        {    0.f, -560.f,    0.f }, // NECK
+        {   40.f, -520.f,    0.f }, // CLAVICLE_LEFT
+        {  180.f, -500.f,    0.f }, // SHOULDER_LEFT
+        {  200.f, -250.f,    0.f }, // ELBOW_LEFT
+        {  210.f,  -20.f,    0.f }, // WRIST_LEFT
+        {  215.f,   40.f,    0.f }, // HAND_LEFT
+        {  220.f,  110.f,    0.f }, // HANDTIP_LEFT
+        {  190.f,   60.f,  -30.f }, // THUMB_LEFT
+        {  -40.f, -520.f,    0.f }, // CLAVICLE_RIGHT
+        { -180.f, -500.f,    0.f }, // SHOULDER_RIGHT
+        { -200.f, -250.f,    0.f }, // ELBOW_RIGHT
+        { -210.f,  -20.f,    0.f }, // WRIST_RIGHT
+        { -215.f,   40.f,    0.f }, // HAND_RIGHT
+        { -220.f,  110.f,    0.f }, // HANDTIP_RIGHT
+        { -190.f,   60.f,  -30.f }, // THUMB_RIGHT
+        {  100.f,   30.f,    0.f }, // HIP_LEFT
+        {  110.f,  450.f,    0.f }, // KNEE_LEFT
+        {  110.f,  850.f,    0.f }, // ANKLE_LEFT
+        {  110.f,  900.f, -120.f }, // FOOT_LEFT
+        { -100.f,   30.f,    0.f }, // HIP_RIGHT
+        { -110.f,  450.f,    0.f }, // KNEE_RIGHT
+        { -110.f,  850.f,    0.f }, // ANKLE_RIGHT
+        { -110.f,  900.f, -120.f }, // FOOT_RIGHT
+        {    0.f, -700.f,    0.f }, // HEAD
+        {    0.f, -680.f, -100.f }, // NOSE
+        {   35.f, -720.f,  -80.f }, // EYE_LEFT
+        {   75.f, -700.f,    0.f }, // EAR_LEFT
+        {  -35.f, -720.f,  -80.f }, // EYE_RIGHT
+        {  -75.f, -700.f,    0.f }, // EAR_RIGHT
+    };
+
+    /** People walking around in front of the sensor; each raises a hand now and then. */
+    void MakeSyntheticFrames(int32 NumFrames, int32 NumBodies, FRandomStream& Random, TArray<FAzureFrameSnapshot>& OutFrames)
+    {
+        OutFrames.SetNum(NumFrames);
+        for (int32 f = 0; f < NumFrames; ++f)
+        {
+            FAzureFrameSnapshot& Snapshot = OutFrames[f];
+            Snapshot.Reset();
+            Snapshot.DeviceTimestampUsec = (uint64)f * 33333;
+
+            const float T = f / 30.f;
+            for (int32 b = 0; b < NumBodies; ++b)
+            {
+                FAzureTrackedBody& Body = Snapshot.Bodies.AddDefaulted_GetRef();
+                Body.BodyId = b + 1;
+                Body.PersonId = b + 1;
+                Body.FrameIndex = b;
+
+                const FVector3f Pelvis(
+                    -700.f + 700.f * b + 250.f * FMath::Sin(T * 0.7f + b),
+                    0.f,
+                    1800.f + 400.f * b + 200.f * FMath::Cos(T * 0.5f + b));
+                const bool bRaiseLeft = ((f / 45 + b) % 4) == 0;
+
+                for (int32 j = 0; j < K4ABT_JOINT_COUNT; ++j)
+                {
+                    FVector3f P = Pelvis + SkeletonTemplate[j];
+                    if (bRaiseLeft && j >= K4ABT_JOINT_WRIST_LEFT && j <= K4ABT_JOINT_THUMB_LEFT)
+                    {
+                        P.Y = Pelvis.Y - 850.f - (j - K4ABT_JOINT_WRIST_LEFT) * 40.f;
+                    }
+                    P += FVector3f(Random.FRandRange(-5.f, 5.f), Random.FRandRange(-5.f, 5.f), Random.FRandRange(-5.f, 5.f));
+
+                    k4abt_joint_t& Joint = Body.Skeleton.joints[j];
+                    Joint.position.xyz.x = P.X;
+                    Joint.position.xyz.y = P.Y;
+                    Joint.position.xyz.z = P.Z;
+                    Joint.orientation.wxyz.w = 1.f;
+                    Joint.orientation.wxyz.x = 0.f;
+                    Joint.orientation.wxyz.y = 0.f;
+                    Joint.orientation.wxyz.z = 0.f;
+                    Joint.confidence_level = (Random.FRand() < 0.1f) ? K4ABT_JOINT_CONFIDENCE_LOW : K4ABT_JOINT_CONFIDENCE_MEDIUM;
+                }
+                AzureFrame::UpdateBodyWorld(Body, FTransform::Identity);
+            }
+        }
+    }
+
+    /** Camera-like color: smooth gradients with per-pixel grain, as NV12 and as MJPEG. */
+    void MakeSyntheticColor(int32 W, int32 H, FRandomStream& Random, IImageWrapperModule& ImageWrapper,
+                            TArray<uint8>& OutNv12, TArray64<uint8>& OutJpeg)
+    {
+        TArray64<uint8> Bgra;
+        Bgra.SetNumUninitialized((int64)W * H * 4);
+        OutNv12.SetNumUninitialized(W * H + W * H / 2);
+        uint8* UV = OutNv12.GetData() + W * H;
+        for (int32 y = 0; y < H; ++y)
+        {
+            for (int32 x = 0; x < W; ++x)
+            {
+                const int32 Grain = Random.RandRange(-6, 6);
+                const int64 p = (int64)y * W + x;
+                Bgra[p * 4 + 0] = (uint8)FMath::Clamp(255 * y / H + Grain, 0, 255);
+                Bgra[p * 4 + 1] = (uint8)FMath::Clamp(128 + Grain, 0, 255);
+                Bgra[p * 4 + 2] = (uint8)FMath::Clamp(255 * x / W + Grain, 0, 255);
+                Bgra[p * 4 + 3] = 255;
+                OutNv12[p] = (uint8)FMath::Clamp(16 + 219 * (x + y) / (W + H) + Grain, 16, 235);
+                if (((x | y) & 1) == 0)
+                {
+                    UV[(y / 2) * W + x] = (uint8)(16 + 224 * x / W);
+                    UV[(y / 2) * W + x + 1] = (uint8)(16 + 224 * y / H);
+                }
+            }
+        }
+
+        OutJpeg.Reset();
+        TSharedPtr<IImageWrapper> Wrapper = ImageWrapper.CreateImageWrapper(EImageFormat::JPEG);
+        if (Wrapper.IsValid() && Wrapper->SetRaw(Bgra.GetData(), Bgra.Num(), W, H, ERGBFormat::BGRA, 8))
+        {
+            OutJpeg = Wrapper->GetCompressed(JpegQuality);
+        }
+    }
+
+    /**
+     * 32 gestures: each hand against head, neck, chest and pelvis along every axis. Half are
+     * a held relation, half go on to a second step where the relation ends with the hand moving.
+     */
+    void MakeGestureSet(TArray<UAzureGestureAsset*>& OutGestures)
+    {
+        const EAzureKinectJoint Targets[] = { EAzureKinectJoint::Head, EAzureKinectJoint::Neck, EAzureKinectJoint::SpineChest, EAzureKinectJoint::Pelvis };
+        const EAzureGestureAxis Axes[] = { EAzureGestureAxis::Up, EAzureGestureAxis::Right, EAzureGestureAxis::Forward, EAzureGestureAxis::Distance };
+
+        for (const EAzureKinectJoint Hand : { EAzureKinectJoint::HandLeft, EAzureKinectJoint::HandRight })
+        {
+            for (int32 t = 0; t < UE_ARRAY_COUNT(Targets); ++t)
+            {
+                for (int32 a = 0; a < UE_ARRAY_COUNT(Axes); ++a)
+                {
+                    UAzureGestureAsset* Gesture = NewObject<UAzureGestureAsset>(GetTransientPackage());
+                    Gesture->GestureName = *FString::Printf(TEXT("Bench%d_%d_%d"), (int32)Hand, t, a);
+                    Gesture->CooldownSeconds = 0.5f;
+
+                    FAzureGesturePredicate Relation;
+                    Relation.JointA = Hand;
+                    Relation.JointB = Targets[t];
+                    Relation.Axis = Axes[a];
+                    Relation.ThresholdCm = 10.f + 10.f * a;
+
+                    FAzureGestureStep& First = Gesture->Steps.AddDefaulted_GetRef();
+                    First.Predicates.Add(Relation);
+                    First.HoldSeconds = 0.2f;
+
+                    if ((t + a) % 2)
+                    {
+                        // ...then back below it while the hand is still moving
+                        FAzureGesturePredicate Back = Relation;
+                        Back.Comparison = EAzureGestureComparison::Less;
+
+                        FAzureGesturePredicate Moving;
+                        Moving.Type = EAzureGesturePredicateType::JointVelocity;
+                        Moving.JointA = Hand;
+                        Moving.Axis = EAzureGestureAxis::Distance;
+                        Moving.ThresholdCm = 20.f;
+
+                        FAzureGestureStep& Second = Gesture->Steps.AddDefaulted_GetRef();
+                        Second.Predicates.Add(Back);
+                        Second.Predicates.Add(Moving);
+                    }
+                    OutGestures.Add(Gesture);
+                }
+            }
+        }
+    }
+
+    /**
+     * NFOV-like depth: octagonal valid area, a back wall, a floor and people-sized blobs, plus
+     * known defects: +-3 mm noise, 1% dropouts and flying pixels around the blobs' silhouettes.
+     * OutClean (optional) gets the same frame without the defects.
+     */
+    void MakeSyntheticDepth(int32 FrameIndex, int32 NumBodies, FRandomStream& Random, int32 W, int32 H,
+                            TArray<uint16>& OutDepth, TArray<uint16>* OutClean = nullptr)
+    {
+        OutDepth.SetNumUninitialized(W * H);
+        if (OutClean)
+        {
+            OutClean->SetNumUninitialized(W * H);
+        }
+        const float T = FrameIndex / 30.f;
+        const int32 Corner = W / 5;
+
+        for (int32 y = 0; y < H; ++y)
+        {
+            for (int32 x = 0; x < W; ++x)
+            {
+                const int32 i = y * W + x;
+
+                const int32 Dx = FMath::Min(x, W - 1 - x);
+                const int32 Dy = FMath::Min(y, H - 1 - y);
+                if (Dx + Dy < Corner)
+                {
+                    OutDepth[i] = 0;
+                    if (OutClean) (*OutClean)[i] = 0;
+                    continue;
+                }
+
+                float Background = 3500.f + 0.5f * x;
+                if (y > H / 2 + 20)
+                {
+                    Background = FMath::Min(Background, 1000.f * (H * 0.5f) / (y - H * 0.5f));
+                }
+
+                float Mm = Background;
+                float EdgeMm = 0.f; // foreground just outside this pixel
+                for (int32 b = 0; b < NumBodies; ++b)
+                {
+                    const float Cx = W * (0.3f + 0.2f * b) + 40.f * FMath::Sin(T + b);
+                    const float Nx = (x - Cx) / 50.f;
+                    const float Ny = (y - H * 0.45f) / 160.f;
+                    const float R2 = Nx * Nx + Ny * Ny;
+                    const float BodyMm = 1800.f + 400.f * b + 60.f * Nx * Nx;
+                    if (R2 < 1.f)
+                    {
+                        Mm = FMath::Min(Mm, BodyMm);
+                    }
+                    else if (R2 < 1.12f)
+                    {
+                        EdgeMm = BodyMm;
+                    }
+                }
+
+                if (OutClean)
+                {
+                    (*OutClean)[i] = (uint16)Mm;
+                }
+
+                if (Random.FRand() < 0.01f)
+                {
+                    OutDepth[i] = 0;
+                    continue;
+                }
+                if (EdgeMm > 0.f && EdgeMm < Mm && Random.FRand() < 0.4f)
+                {
+                    Mm = FMath::Lerp(EdgeMm, Mm, Random.FRand()); // mixed return between the two surfaces
+                }
+                OutDepth[i] = (uint16)FMath::Clamp(Mm + Random.FRandRange(-3.f, 3.f), 1.f, 65535.f);
+            }
+        }
+    }
+
+    struct FDepthQuality
+    {
+        double RmseMm = 0.0;   // over pixels valid in both
+        int32 Holes = 0;       // valid in the clean frame, missing here
+        int32 Outliers = 0;    // off by more than 100 mm (flying pixels)
+    };
+
+    FDepthQuality MeasureDepth(const TArray<uint16>& Depth, const TArray<uint16>& Clean)
+    {
+        FDepthQuality Q;
+        double SumSq = 0.0;
+        int32 Count = 0;
+        for (int32 i = 0; i < Clean.Num(); ++i)
+        {
+            if (Clean[i] == 0) continue;
+            if (Depth[i] == 0)
+            {
+                ++Q.Holes;
+                continue;
+            }
+
+            const double Err = (double)Depth[i] - Clean[i];
+            if (FMath::Abs(Err) > 100.0)
+            {
+                ++Q.Outliers;
+                continue;
+            }
+            SumSq += Err * Err;
+            ++Count;
+        }
+        Q.RmseMm = Count > 0 ? FMath::Sqrt(SumSq / Count) : 0.0;
+        return Q;
+    }
+
+    /** One in-order pass of a fresh filter over Depth; quality of the last frame before and after. */
+    void MeasureDepthFilter(const TArray<TArray<uint16>>& Depth, const TArray<TArray<uint16>>& Clean, int32 W, int32 H,
+                            FDepthQuality& OutRaw, FDepthQuality& OutFiltered)
+    {
+        FAzureDepthFilter Filter;
+        TArray<uint16> Filtered;
+        for (const TArray<uint16>& Frame : Depth)
+        {
+            Filter.Process(Frame.GetData(), W, H, Filtered);
+        }
+        OutRaw = MeasureDepth(Depth.Last(), Clean.Last());
+        OutFiltered = MeasureDepth(Filtered, Clean.Last());
+    }
+
+    /**
+     * Reports a stage against its per-frame budget and fails the run when the median is over.
+     * Debug builds are only reported: their timings say nothing about the shipped code.
+     */
+    void CheckBudget(FStageResult& R, double BudgetMs, TArray<FString>& OutFailures)
+    {
+        const double MedianMs = R.MedianNs / 1e6;
+        R.Extra.Emplace(TEXT("budget_ms"), BudgetMs);
+        R.Extra.Emplace(TEXT("share_of_budget"), MedianMs / BudgetMs);
+        if (MedianMs > BudgetMs && FApp::GetBuildConfiguration() != EBuildConfiguration::Debug)
+        {
+            OutFailures.Add(FString::Printf(TEXT("%s: %.3f ms per frame (median), over its %.2f ms budget"), *R.Name, MedianMs, BudgetMs));
+        }
+    }
+
+    bool LoadInputs(const FString& TakePath, const FString& DepthPath, int32 NumFrames, int32 NumBodies, FBenchmarkInputs& Out)
+    {
+        FRandomStream Random(1234);
+        TArray<FString> Sources;
+
+        if (!DepthPath.IsEmpty())
+        {
+            FAzureDepthRecordingReader Reader;
+            if (!Reader.Open(DepthPath) || Reader.NumFrames() == 0)
+            {
+                return false;
+            }
+            Out.DepthWidth = Reader.GetWidth();
+            Out.DepthHeight = Reader.GetHeight();
+
+            FAzureDepthRecordingFrame Frame;
+            TArray<uint8> Scratch;
+            for (int32 i = 0; i < Reader.NumFrames() && (Out.Depth.Num() < MaxDepthFrames || Out.Frames.Num() < NumFrames); ++i)
+            {
+                if (!Reader.ReadFrame(i, Frame))
+                {
+                    continue;
+                }
+                if (Out.Depth.Num() < MaxDepthFrames &&
+                    !Frame.DecodeDepth(Out.DepthWidth, Out.DepthHeight, Out.Depth.AddDefaulted_GetRef(), Scratch))
+                {
+                    Out.Depth.Pop();
+                }
+                if (TakePath.IsEmpty() && Out.Frames.Num() < NumFrames)
+                {
+                    Out.Frames.Add(Frame.Bodies);
+                }
+            }
+            Sources.Add(DepthPath);
+        }
+        else
+        {
+            for (int32 i = 0; i < MaxDepthFrames; ++i)
+            {
+                MakeSyntheticDepth(i, NumBodies, Random, Out.DepthWidth, Out.DepthHeight,
+                    Out.Depth.AddDefaulted_GetRef(), &Out.CleanDepth.AddDefaulted_GetRef());
+            }
+        }
+
+        if (!TakePath.IsEmpty())
+        {
+            FAzureTakeReader Reader;
+            if (!Reader.Open(TakePath) || Reader.NumFrames() == 0)
+            {
+                return false;
+            }
+            Out.Frames.SetNum(FMath::Min(NumFrames, Reader.NumFrames()));
+            for (int32 i = 0; i < Out.Frames.Num(); ++i)
+            {
+                Reader.ReadFrame(i, Out.Frames[i]);
+            }
+            Sources.Add(TakePath);
+        }
+
+        if (Out.Frames.Num() == 0)
+        {
+            MakeSyntheticFrames(NumFrames, NumBodies, Random, Out.Frames);
+        }
+        else
+        {
+            // Recordings don't store world joints
+            for (FAzureFrameSnapshot& Snapshot : Out.Frames)
+            {
+                for (FAzureTrackedBody& Body : Snapshot.Bodies)
+                {
+                    AzureFrame::UpdateBodyWorld(Body, FTransform::Identity);
+                }
+            }
+        }
+
+        // Color is always synthetic: two gradients so consecutive copies differ
+        for (int32 i = 0; i < 2; ++i)
+        {
+            TArray<uint8>& Pixels = Out.Color.AddDefaulted_GetRef();
+            Pixels.SetNumUninitialized(ColorWidth * ColorHeight * 4);
+            for (int32 p = 0; p < ColorWidth * ColorHeight; ++p)
+            {
+                Pixels[p * 4 + 0] = (uint8)(p + i * 64);
+                Pixels[p * 4 + 1] = (uint8)(p / ColorWidth);
+                Pixels[p * 4 + 2] = (uint8)(i * 128);
+                Pixels[p * 4 + 3] = 255;
+            }
+        }
+
+        if (Sources.Num() > 0)
+        {
+            Out.Source = FString::Join(Sources, TEXT(", "));
+        }
+        return Out.Depth.Num() > 0 && Out.Frames.Num() > 0;
+    }
+
+    /** Pinhole unprojection of every Step-th pixel, standing in for the calibrated ray tables. */
+    void MakePinholeRays(int32 Width, int32 Height, float Focal, int32 Step, FAzureDepthRayTable& Out)
+    {
+        Out.Width = Width;
+        Out.Height = Height;
+        Out.Step = Step;
+        Out.PixelIndex.Reset();
+        Out.Rays.Reset();
+        for (int32 y = Step / 2; y < Height; y += Step)
+        {
+            for (int32 x = Step / 2; x < Width; x += Step)
+            {
+                Out.PixelIndex.Add(y * Width + x);
+                Out.Rays.Add(FVector3f((x - 0.5f * Width) / Focal, (y - 0.5f * Height) / Focal, 1.f));
+            }
+        }
+    }
+
+    struct FFloorRun
+    {
+        int32 FramesToConverge = -1; // -1: didn't within MaxFrames
+        FAzureFloorEstimate Estimate;
+    };
+
+    /** Cold start of the floor detector over the depth frames in order, until it converges. */
+    FFloorRun RunFloorDetector(const FBenchmarkInputs& Inputs, const FAzureDepthRayTable& Rays, const FVector3f* GravityDown, int32 MaxFrames)
+    {
+        FAzureFloorDetector Detector;
+        TArray<FVector3f> Points;
+        FFloorRun Run;
+        for (int32 f = 0; f < MaxFrames; ++f)
+        {
+            AzureDepth::SamplePointCloud(Inputs.Depth[f % Inputs.Depth.Num()].GetData(), Inputs.DepthWidth, Inputs.DepthHeight, Rays, Points);
+            Detector.ProcessPoints(Points, GravityDown);
+            if (Detector.GetEstimate().bConverged)
+            {
+                Run.FramesToConverge = f + 1;
+                break;
+            }
+        }
+        Run.Estimate = Detector.GetEstimate();
+        return Run;
+    }
+
+    double AverageRatio(const FBenchmarkInputs& Inputs, EAzureDepthSecondStage SecondStage)
+    {
+        const int32 NumPixels = Inputs.DepthWidth * Inputs.DepthHeight;
+        TArray<uint8> Encoded;
+        TArray<uint8> Scratch;
+        double RawBytes = 0.0;
+        double EncodedBytes = 0.0;
+        for (const TArray<uint16>& Depth : Inputs.Depth)
+        {
+            AzureDepthCodec::Encode(Depth.GetData(), NumPixels, SecondStage, Encoded, Scratch);
+            RawBytes += NumPixels * sizeof(uint16);
+            EncodedBytes += Encoded.Num();
+        }
+        return EncodedBytes > 0.0 ? RawBytes / EncodedBytes : 0.0;
+    }
+
+    /**
+     * Lossless round trip of the depth codec with every second stage: the input frames plus
+     * frames that stress it (all invalid, all at the maximum, alternating extremes for the
+     * largest deltas and shortest runs, random values, an odd pixel count). A truncated stream
+     * has to be rejected. Adds a line to OutFailures per problem.
+     */
+    void CheckDepthCodec(const FBenchmarkInputs& Inputs, TArray<FString>& OutFailures)
+    {
+        const int32 NumPixels = Inputs.DepthWidth * Inputs.DepthHeight;
+        TArray<TPair<FString, TArray<uint16>>> Cases;
+        Cases.Reserve(Inputs.Depth.Num() + 6); // references into it are kept below
+        for (int32 i = 0; i < Inputs.Depth.Num(); ++i)
+        {
+            Cases.Emplace(FString::Printf(TEXT("input frame %d"), i), Inputs.Depth[i]);
+        }
+
+        FRandomStream Random(99);
+        TArray<uint16>& Zero = Cases.Emplace_GetRef(TEXT("all zero"), TArray<uint16>()).Value;
+        TArray<uint16>& Max = Cases.Emplace_GetRef(TEXT("all 65535"), TArray<uint16>()).Value;
+        TArray<uint16>& ZeroMax = Cases.Emplace_GetRef(TEXT("alternating 0/65535"), TArray<uint16>()).Value;
+        TArray<uint16>& OneMax = Cases.Emplace_GetRef(TEXT("alternating 1/65535"), TArray<uint16>()).Value;
+        TArray<uint16>& Noise = Cases.Emplace_GetRef(TEXT("random"), TArray<uint16>()).Value;
+        TArray<uint16>& Odd = Cases.Emplace_GetRef(TEXT("7 pixels"), TArray<uint16>()).Value;
+        for (int32 p = 0; p < NumPixels; ++p)
+        {
+            Zero.Add(0);
+            Max.Add(65535);
+            ZeroMax.Add((p & 1) ? 65535 : 0);
+            OneMax.Add((p & 1) ? 65535 : 1);
+            Noise.Add((uint16)Random.RandRange(0, 65535));
+        }
+        Odd = { 0, 65535, 1, 1, 0, 0, 40000 };
+
+        TArray<uint8> Encoded;
+        TArray<uint8> Scratch;
+        TArray<uint16> Decoded;
+        for (const EAzureDepthSecondStage Stage : { EAzureDepthSecondStage::None, EAzureDepthSecondStage::LZ4, EAzureDepthSecondStage::Oodle })
+        {
+            for (const TPair<FString, TArray<uint16>>& Case : Cases)
+            {
+                const int32 Num = Case.Value.Num();
+                AzureDepthCodec::Encode(Case.Value.GetData(), Num, Stage, Encoded, Scratch);
+                Decoded.SetNumUninitialized(Num, false);
+                if (!AzureDepthCodec::Decode(Encoded.GetData(), Encoded.Num(), Decoded.GetData(), Num, Scratch) ||
+                    FMemory::Memcmp(Decoded.GetData(), Case.Value.GetData(), Num * sizeof(uint16)) != 0)
+                {
+                    OutFailures.Add(FString::Printf(TEXT("DepthCodec: %s doesn't round-trip (second stage %d)"), *Case.Key, (int32)Stage));
+                }
+            }
+
+            AzureDepthCodec::Encode(Cases[0].Value.GetData(), NumPixels, Stage, Encoded, Scratch);
+            Decoded.SetNumUninitialized(NumPixels, false);
+            if (AzureDepthCodec::Decode(Encoded.GetData(), Encoded.Num() - 4, Decoded.GetData(), NumPixels, Scratch))
+            {
+                OutFailures.Add(FString::Printf(TEXT("DepthCodec: truncated stream accepted (second stage %d)"), (int32)Stage));
+            }
+        }
+    }
+
+    TSharedRef<FJsonObject> StageToJson(const FStageResult& R)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetStringField(TEXT("name"), R.Name);
+        Json->SetNumberField(TEXT("iterations"), R.Iterations);
+        Json->SetNumberField(TEXT("ns_mean"), R.MeanNs);
+        Json->SetNumberField(TEXT("ns_median"), R.MedianNs);
+        Json->SetNumberField(TEXT("ns_p95"), R.P95Ns);
+        Json->SetNumberField(TEXT("ns_min"), R.MinNs);
+        Json->SetNumberField(TEXT("allocs_per_iteration"), R.AllocsPerIteration);
+        Json->SetNumberField(TEXT("alloc_bytes_per_iteration"), R.AllocBytesPerIteration);
+        Json->SetNumberField(TEXT("iterations_per_second"), R.MeanNs > 0.0 ? 1e9 / R.MeanNs : 0.0);
+        if (R.InputBytesPerIteration > 0.0 && R.MeanNs > 0.0)
+        {
+            Json->SetNumberField(TEXT("megabytes_per_second"), R.InputBytesPerIteration / R.MeanNs * 1e3);
+        }
+        for (const TPair<FString, double>& E : R.Extra)
+        {
+            Json->SetNumberField(E.Key, E.Value);
+        }
+        return Json;
+    }
+}
+
+UAzureKinectBenchmarkCommandlet::UAzureKinectBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Times the Azure Kinect plugin's per-frame hot paths without a sensor and writes a JSON report.");
+    HelpUsage = TEXT("<Project> -run=AzureKinectBenchmark [-Iterations=600] [-Bodies=3] [-Take=<File.aktake>] [-Depth=<File.akdepth>] [-Output=<File.json>] [-SoakHours=<h>] [-SoakMaxGrowthMB=16] [-AllowCommandletRendering]");
+}
+
+int32 UAzureKinectBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 Iterations = 600;
+    int32 NumBodies = 3;
+    FString TakePath;
+    FString DepthPath;
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("AzureKinectBenchmark.json"));
+    double SoakHours = 0.0;
+    double SoakMaxGrowthMB = 16.0;
+
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("Bodies="), NumBodies);
+    FParse::Value(*Params, TEXT("Take="), TakePath);
+    FParse::Value(*Params, TEXT("Depth="), DepthPath);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    FParse::Value(*Params, TEXT("SoakHours="), SoakHours);
+    FParse::Value(*Params, TEXT("SoakMaxGrowthMB="), SoakMaxGrowthMB);
+    Iterations = FMath::Max(10, Iterations);
+    NumBodies = FMath::Clamp(NumBodies, 0, AzureTake::MaxBodies);
+
+    FBenchmarkInputs Inputs;
+    if (!LoadInputs(TakePath, DepthPath, Iterations, NumBodies, Inputs))
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: benchmark inputs could not be loaded"));
+        return 1;
+    }
+
+    const int32 NumPixels = Inputs.DepthWidth * Inputs.DepthHeight;
+    const double DepthBytes = NumPixels * sizeof(uint16);
+    const double ColorBytes = (double)ColorWidth * ColorHeight * 4;
+
+    int32 TotalBodies = 0;
+    for (const FAzureFrameSnapshot& Snapshot : Inputs.Frames)
+    {
+        TotalBodies += Snapshot.Bodies.Num();
+    }
+    const double BodiesPerFrame = (double)TotalBodies / Inputs.Frames.Num();
+
+    UE_LOG(LogAzureBodyTracking, Display, TEXT("BodyBT: benchmarking %d iterations, %s, %.1f bodies/frame, depth %dx%d"),
+        Iterations, *Inputs.Source, BodiesPerFrame, Inputs.DepthWidth, Inputs.DepthHeight);
+
+    // Everything the stages write into is allocated up front, like the components' members
+    TArray<FColor> Gray;
+    Gray.SetNumUninitialized(NumPixels);
+    TArray<uint8> ColorDest;
+    ColorDest.SetNumUninitialized(ColorWidth * ColorHeight * 4);
+    TArray<FBodyJointData> Joints;
+    Joints.Reserve(K4ABT_JOINT_COUNT);
+    TArray<FAzureBodySample> WaveSamples;
+    WaveSamples.Reserve(AzureTake::MaxBodies);
+    TArray<FAzureScoredBodySample> ScoredSamples;
+    ScoredSamples.Reserve(AzureTake::MaxBodies);
+    TArray<uint8> Encoded;
+    TArray<uint8> Scratch;
+    TArray<uint16> Decoded;
+    Decoded.SetNumUninitialized(NumPixels);
+
+    const int32 NumDepth = Inputs.Depth.Num();
+    const int32 NumFrames = Inputs.Frames.Num();
+    int64 Sink = 0; // keeps results alive
+    TArray<FString> Failures; // correctness checks and budgets that failed; any fails the run
+
+    // Known answers first: a stage that got faster by getting wrong shouldn't look like a win
+    const int32 NumChecks = AzureSelfTest::Run(Failures);
+    UE_LOG(LogAzureBodyTracking, Display, TEXT("BodyBT: %d self-test checks, %d failed"), NumChecks, Failures.Num());
+
+    FStageRunner Runner(Iterations, FMath::Max(1, Iterations / 10));
+
+    Runner.Run(TEXT("DepthToGrayscale"), DepthBytes, [&](int32 i)
+    {
+        AzureImage::DepthToGrayscale(Inputs.Depth[i % NumDepth].GetData(), NumPixels, Gray.GetData());
+        Sink += Gray[i % NumPixels].R;
+    });
+
+    Runner.Run(TEXT("ColorCopy"), ColorBytes, [&](int32 i)
+    {
+        AzureImage::CopyBgra(Inputs.Color[i & 1].GetData(), ColorWidth, ColorHeight, ColorDest.GetData());
+        Sink += ColorDest[i % ColorDest.Num()];
+    });
+
+    Runner.Run(TEXT("FillJointArrayFromSkeleton"), 0.0, [&](int32 i)
+    {
+        for (const FAzureTrackedBody& Body : Inputs.Frames[i % NumFrames].Bodies)
+        {
+            AzureSkel::FillJointArrayFromSkeleton(Body.Skeleton, FTransform::Identity, Joints);
+            Sink += Joints.Num();
+        }
+    }).Extra.Emplace(TEXT("bodies_per_iteration"), BodiesPerFrame);
+
+    Runner.Run(TEXT("FindClosestBodyId"), 0.0, [&](int32 i)
+    {
+        Sink += AzureFrame::FindClosestBodyId(Inputs.Frames[i % NumFrames]);
+    }).Extra.Emplace(TEXT("bodies_per_iteration"), BodiesPerFrame);
+
+    FAzureActiveSelector WaveSelector;
+    Runner.Run(TEXT("ActiveSelector.WaveLastRaised"), 0.0, [&](int32 i)
+    {
+        const float Now = i / 30.f;
+        WaveSamples.Reset();
+        for (const FAzureTrackedBody& Body : Inputs.Frames[i % NumFrames].Bodies)
+        {
+            const k4abt_skeleton_t& Skel = Body.Skeleton;
+            FAzureBodySample& S = WaveSamples.AddDefaulted_GetRef();
+            S.BodyId = Body.PersonId;
+            S.HeadY_mm = Skel.joints[K4ABT_JOINT_HEAD].position.xyz.y;
+            S.LHandY_mm = Skel.joints[K4ABT_JOINT_HAND_LEFT].position.xyz.y;
+            S.RHandY_mm = Skel.joints[K4ABT_JOINT_HAND_RIGHT].position.xyz.y;
+            S.SeenAtSeconds = Now;
+        }
+        Sink += WaveSelector.UpdateWaveLastRaised(WaveSamples, Now);
+    });
+
+    FAzureScoredSelector ScoredSelector;
+    ScoredSelector.Configure(FAzureScoredSelectorSettings());
+    Runner.Run(TEXT("ScoredSelector"), 0.0, [&](int32 i)
+    {
+        ScoredSamples.Reset();
+        for (const FAzureTrackedBody& Body : Inputs.Frames[i % NumFrames].Bodies)
+        {
+            ScoredSamples.Add(FAzureScoredSelector::MakeSample(Body));
+        }
+        Sink += ScoredSelector.Update(ScoredSamples, i / 30.f);
+    });
+
+    // Every gesture against a full crowd, whatever the input: the cost grows with both
+    {
+        TArray<UAzureGestureAsset*> GestureSet;
+        MakeGestureSet(GestureSet);
+        FAzureGestureEngine GestureEngine;
+        GestureEngine.SetGestures(GestureSet);
+
+        FRandomStream CrowdRandom(31);
+        TArray<FAzureFrameSnapshot> Crowd;
+        MakeSyntheticFrames(300, GestureCrowdBodies, CrowdRandom, Crowd);
+
+        TArray<FAzureGestureEvent> GestureEvents;
+        GestureEvents.Reserve(GestureCrowdBodies * GestureSet.Num());
+        int64 NumEvents = 0;
+        FStageResult& GestureStage = Runner.Run(TEXT("Gestures"), 0.0, [&](int32 i)
+        {
+            GestureEvents.Reset();
+            GestureEngine.Update(Crowd[i % Crowd.Num()], i / 30.f, GestureEvents);
+            NumEvents += GestureEvents.Num();
+        });
+        Sink += NumEvents;
+        GestureStage.Extra.Emplace(TEXT("bodies_per_iteration"), GestureCrowdBodies);
+        GestureStage.Extra.Emplace(TEXT("gestures"), GestureSet.Num());
+        CheckBudget(GestureStage, GestureBudgetMs, Failures);
+    }
+
+    // Spatial index by crowd size: the per-frame build, then single queries at random points in
+    // and around the crowd. Nearest-joint answers are checked against a scan of every joint first.
+    for (const int32 NumCrowd : { 1, 3, 6, 12, 24 })
+    {
+        FRandomStream IndexRandom(53 + NumCrowd);
+        TArray<FAzureFrameSnapshot> Crowd;
+        MakeSyntheticFrames(60, NumCrowd, IndexRandom, Crowd);
+
+        FBox CrowdBox(ForceInit);
+        for (const FAzureTrackedBody& Body : Crowd[0].Bodies)
+        {
+            CrowdBox += Body.WorldBounds;
+        }
+        CrowdBox = CrowdBox.ExpandBy(50.0);
+        TArray<FVector> Points;
+        for (int32 p = 0; p < 256; ++p)
+        {
+            Points.Add(IndexRandom.RandPointInBox(CrowdBox));
+        }
+
+        FAzureBodySpatialIndex Index;
+        Index.Build(Crowd[0]);
+        int32 Mismatches = 0;
+        for (const FVector& P : Points)
+        {
+            int32 BodyId = -1, JointId = -1;
+            FVector Position;
+            float Distance = 0.f;
+            Index.FindNearestJoint(P, FAzureBodySpatialIndex::AllJoints, BodyId, JointId, Position, Distance);
+
+            double BestDistance = TNumericLimits<double>::Max();
+            for (const FAzureTrackedBody& Body : Crowd[0].Bodies)
+            {
+                for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+                {
+                    BestDistance = FMath::Min(BestDistance, FVector::Dist(P, Body.JointsWorld[J]));
+                }
+            }
+            Mismatches += FMath::Abs(Distance - BestDistance) > 0.01 ? 1 : 0;
+        }
+        if (Mismatches > 0)
+        {
+            Failures.Add(FString::Printf(TEXT("SpatialIndex/%d: %d of %d nearest-joint queries disagree with a full scan"), NumCrowd, Mismatches, Points.Num()));
+        }
+
+        TArray<int32> BoxIds;
+        BoxIds.Reserve(NumCrowd);
+        const int32 FirstIndexStage = Runner.Results.Num();
+        Runner.Run(*FString::Printf(TEXT("SpatialIndex.Build/%d"), NumCrowd), 0.0, [&](int32 i)
+        {
+            Index.Build(Crowd[i % Crowd.Num()]);
+            Sink += Index.NumBodies();
+        });
+
+        Index.Build(Crowd[0]);
+        Runner.Run(*FString::Printf(TEXT("SpatialIndex.NearestJoint/%d"), NumCrowd), 0.0, [&](int32 i)
+        {
+            int32 BodyId = -1, JointId = -1;
+            FVector Position;
+            float Distance = 0.f;
+            Index.FindNearestJoint(Points[i % Points.Num()], FAzureBodySpatialIndex::AllJoints, BodyId, JointId, Position, Distance);
+            Sink += JointId;
+        });
+
+        const uint32 HandMask = (1u << K4ABT_JOINT_HAND_LEFT) | (1u << K4ABT_JOINT_HAND_RIGHT);
+        Runner.Run(*FString::Printf(TEXT("SpatialIndex.NearestHand/%d"), NumCrowd), 0.0, [&](int32 i)
+        {
+            int32 BodyId = -1, JointId = -1;
+            FVector Position;
+            float Distance = 0.f;
+            Index.FindNearestJoint(Points[i % Points.Num()], HandMask, BodyId, JointId, Position, Distance);
+            Sink += BodyId;
+        });
+
+        Runner.Run(*FString::Printf(TEXT("SpatialIndex.BodiesInBox/%d"), NumCrowd), 0.0, [&](int32 i)
+        {
+            Sink += Index.FindBodiesInBox(FBox::BuildAABB(Points[i % Points.Num()], FVector(100.0)), BoxIds);
+        });
+
+        for (int32 r = FirstIndexStage; r < Runner.Results.Num(); ++r)
+        {
+            FStageResult& Stage = Runner.Results[r];
+            Stage.Extra.Emplace(TEXT("bodies"), NumCrowd);
+            if (Stage.AllocsPerIteration > 0.0)
+            {
+                Failures.Add(FString::Printf(TEXT("%s: %.2f allocations per frame once warm (expected none)"), *Stage.Name, Stage.AllocsPerIteration));
+            }
+        }
+    }
+
+    // Depth filter with its defaults, on the task graph and on one thread. The budget is for one
+    // core: 2 ms for an NFOV unbinned frame, scaled by pixel count for other recordings.
+    FAzureDepthFilter DepthFilter;
+    TArray<uint16> FilteredDepth;
+    // Runner.Results grows with every Run, so the parallel stage is looked up again afterwards.
+    const int32 FilterStageIndex = Runner.Results.Num();
+    Runner.Run(TEXT("DepthFilter"), DepthBytes, [&](int32 i)
+    {
+        DepthFilter.Process(Inputs.Depth[i % NumDepth].GetData(), Inputs.DepthWidth, Inputs.DepthHeight, FilteredDepth);
+        Sink += FilteredDepth[i % NumPixels];
+    });
+
+    FAzureDepthFilter::FSettings SingleThreadSettings;
+    SingleThreadSettings.bParallel = false;
+    FAzureDepthFilter SingleThreadFilter;
+    SingleThreadFilter.Configure(SingleThreadSettings);
+    FStageResult& SingleThreadStage = Runner.Run(TEXT("DepthFilter.SingleThread"), DepthBytes, [&](int32 i)
+    {
+        SingleThreadFilter.Process(Inputs.Depth[i % NumDepth].GetData(), Inputs.DepthWidth, Inputs.DepthHeight, FilteredDepth);
+        Sink += FilteredDepth[i % NumPixels];
+    });
+    CheckBudget(SingleThreadStage, 2.0 * NumPixels / (SyntheticDepthWidth * SyntheticDepthHeight), Failures);
+    FStageResult& FilterStage = Runner.Results[FilterStageIndex];
+    FilterStage.Extra.Emplace(TEXT("parallel_speedup"), SingleThreadStage.MedianNs / FMath::Max(FilterStage.MedianNs, 1.0));
+
+    // Quality on synthetic depth, against the frames without noise/defects: the benchmark's
+    // people moving, and the same scene empty (nothing moves, so every dropout can be held or
+    // filled). The filter has to improve on the raw frame in every measure.
+    if (Inputs.CleanDepth.Num() == NumDepth)
+    {
+        TArray<TArray<uint16>> StaticDepth;
+        TArray<TArray<uint16>> StaticClean;
+        FRandomStream StaticRandom(99);
+        for (int32 i = 0; i < MaxDepthFrames; ++i)
+        {
+            MakeSyntheticDepth(i, 0, StaticRandom, Inputs.DepthWidth, Inputs.DepthHeight,
+                StaticDepth.AddDefaulted_GetRef(), &StaticClean.AddDefaulted_GetRef());
+        }
+
+        struct FQualityCase
+        {
+            const TCHAR* Name;
+            const TArray<TArray<uint16>>& Depth;
+            const TArray<TArray<uint16>>& Clean;
+            double MaxRmseRatio;     // filtered / raw, each bound has to be met
+            double MaxHolesRatio;
+            double MaxOutliersRatio;
+        };
+        const FQualityCase Cases[] =
+        {
+            { TEXT("moving"), Inputs.Depth, Inputs.CleanDepth, 0.98, 0.5, 0.6 },
+            { TEXT("static"), StaticDepth, StaticClean, 0.75, 0.05, 0.6 },
+        };
+
+        for (const FQualityCase& Case : Cases)
+        {
+            FDepthQuality Raw;
+            FDepthQuality Filtered;
+            MeasureDepthFilter(Case.Depth, Case.Clean, Inputs.DepthWidth, Inputs.DepthHeight, Raw, Filtered);
+
+            FilterStage.Extra.Emplace(FString::Printf(TEXT("rmse_mm_raw_%s"), Case.Name), Raw.RmseMm);
+            FilterStage.Extra.Emplace(FString::Printf(TEXT("rmse_mm_filtered_%s"), Case.Name), Filtered.RmseMm);
+            FilterStage.Extra.Emplace(FString::Printf(TEXT("holes_raw_%s"), Case.Name), Raw.Holes);
+            FilterStage.Extra.Emplace(FString::Printf(TEXT("holes_filtered_%s"), Case.Name), Filtered.Holes);
+            FilterStage.Extra.Emplace(FString::Printf(TEXT("outliers_raw_%s"), Case.Name), Raw.Outliers);
+            FilterStage.Extra.Emplace(FString::Printf(TEXT("outliers_filtered_%s"), Case.Name), Filtered.Outliers);
+
+            UE_LOG(LogAzureBodyTracking, Display, TEXT("    %s: rmse %.2f -> %.2f mm, holes %d -> %d, outliers %d -> %d"),
+                Case.Name, Raw.RmseMm, Filtered.RmseMm, Raw.Holes, Filtered.Holes, Raw.Outliers, Filtered.Outliers);
+
+            if (Filtered.RmseMm > Case.MaxRmseRatio * Raw.RmseMm ||
+                Filtered.Holes > Case.MaxHolesRatio * Raw.Holes ||
+                Filtered.Outliers > Case.MaxOutliersRatio * Raw.Outliers)
+            {
+                Failures.Add(FString::Printf(TEXT("DepthFilter (%s): rmse %.2f -> %.2f mm, holes %d -> %d, outliers %d -> %d (expected at most x%.2f, x%.2f, x%.2f)"),
+                    Case.Name, Raw.RmseMm, Filtered.RmseMm, Raw.Holes, Filtered.Holes, Raw.Outliers, Filtered.Outliers,
+                    Case.MaxRmseRatio, Case.MaxHolesRatio, Case.MaxOutliersRatio));
+            }
+        }
+    }
+
+    // Floor detection on every 8th pixel, like the component. From a cold start it has to settle
+    // on the floor and not the back wall, with and without gravity from the IMU. Synthetic depth
+    // is seen from an NFOV-like pinhole, level, with the floor 1000 * (H/2) / Focal mm down.
+    const float Focal = 0.79f * Inputs.DepthWidth;
+    {
+        FAzureDepthRayTable FloorRays;
+        MakePinholeRays(Inputs.DepthWidth, Inputs.DepthHeight, Focal, 8, FloorRays);
+        const FVector3f GravityDown(0.f, 1.f, 0.f);
+
+        FAzureFloorDetector FloorDetector;
+        TArray<FVector3f> FloorPoints;
+        FStageResult& FloorStage = Runner.Run(TEXT("FloorDetector"), DepthBytes, [&](int32 i)
+        {
+            AzureDepth::SamplePointCloud(Inputs.Depth[i % NumDepth].GetData(), Inputs.DepthWidth, Inputs.DepthHeight, FloorRays, FloorPoints);
+            FloorDetector.ProcessPoints(FloorPoints, &GravityDown);
+            Sink += (int64)FloorDetector.GetEstimate().HeightMm;
+        });
+
+        const bool bKnownFloor = Inputs.CleanDepth.Num() == NumDepth;
+        const float TrueHeightMm = 1000.f * (0.5f * Inputs.DepthHeight) / Focal;
+        constexpr int32 MaxFramesToConverge = 60;
+        constexpr float MaxTiltErrorDegrees = 2.f;
+        constexpr float MaxHeightErrorMm = 20.f;
+
+        for (const bool bGravity : { true, false })
+        {
+            const FFloorRun Run = RunFloorDetector(Inputs, FloorRays, bGravity ? &GravityDown : nullptr, 10 * MaxFramesToConverge);
+            const float TiltDegrees = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector3f::DotProduct(Run.Estimate.Up, FVector3f(0.f, -1.f, 0.f)), -1.f, 1.f)));
+            const TCHAR* Suffix = bGravity ? TEXT("imu") : TEXT("no_imu");
+            FloorStage.Extra.Emplace(FString::Printf(TEXT("frames_to_converge_%s"), Suffix), Run.FramesToConverge);
+            FloorStage.Extra.Emplace(FString::Printf(TEXT("tilt_degrees_%s"), Suffix), TiltDegrees);
+            FloorStage.Extra.Emplace(FString::Printf(TEXT("height_mm_%s"), Suffix), Run.Estimate.HeightMm);
+
+            UE_LOG(LogAzureBodyTracking, Display, TEXT("    %s: converged after %d frames, tilt %.2f deg, height %.1f mm"),
+                Suffix, Run.FramesToConverge, TiltDegrees, Run.Estimate.HeightMm);
+
+            if (bKnownFloor && (Run.FramesToConverge < 0 || Run.FramesToConverge > MaxFramesToConverge ||
+                TiltDegrees > MaxTiltErrorDegrees || FMath::Abs(Run.Estimate.HeightMm - TrueHeightMm) > MaxHeightErrorMm))
+            {
+                Failures.Add(FString::Printf(TEXT("FloorDetector (%s): %d frames to converge, tilt %.2f deg, height %.1f mm (expected <= %d frames, level, %.1f mm)"),
+                    Suffix, Run.FramesToConverge, TiltDegrees, Run.Estimate.HeightMm, MaxFramesToConverge, TrueHeightMm));
+            }
+        }
+    }
+
+    // Occlusion mesh on an NFOV-like pinhole: everything rebuilt vs only the tiles that changed
+    FAzureOcclusionMeshBuilder Occlusion;
+    Occlusion.Initialize(Inputs.DepthWidth, Inputs.DepthHeight, [&](float X, float Y, FVector3f& OutRay)
+    {
+        OutRay = FVector3f((X - 0.5f * Inputs.DepthWidth) / Focal, (Y - 0.5f * Inputs.DepthHeight) / Focal, 1.f);
+        return true;
+    }, FAzureOcclusionMeshBuilder::FSettings());
+    TArray<int32> ChangedTiles;
+
+    Runner.Run(TEXT("OcclusionMesh.FullRebuild"), DepthBytes, [&](int32 i)
+    {
+        Occlusion.Reset();
+        Sink += Occlusion.Update(Inputs.Depth[i % NumDepth].GetData(), Inputs.DepthWidth, Inputs.DepthHeight, ChangedTiles);
+    }).Extra.Emplace(TEXT("triangles"), Occlusion.GetTriangleCount());
+
+    int64 TilesRebuilt = 0;
+    int32 IncrementalRuns = 0;
+    FStageResult& IncrementalStage = Runner.Run(TEXT("OcclusionMesh.Incremental"), DepthBytes, [&](int32 i)
+    {
+        TilesRebuilt += Occlusion.Update(Inputs.Depth[i % NumDepth].GetData(), Inputs.DepthWidth, Inputs.DepthHeight, ChangedTiles);
+        ++IncrementalRuns;
+    });
+    IncrementalStage.Extra.Emplace(TEXT("tiles"), Occlusion.NumTiles());
+    IncrementalStage.Extra.Emplace(TEXT("tiles_rebuilt_per_frame"), IncrementalRuns > 0 ? (double)TilesRebuilt / IncrementalRuns : 0.0);
+    Sink += TilesRebuilt;
+
+    // Occupancy grid at the component's ray density (every 4th pixel), one frame per 1/30 s.
+    // The identity placement puts depth along +X, the volume encloses the synthetic scene.
+    FAzureDepthRayTable OccupancyRays;
+    MakePinholeRays(Inputs.DepthWidth, Inputs.DepthHeight, Focal, 4, OccupancyRays);
+
+    FAzureOccupancyGrid::FSettings OccupancyCfg;
+    OccupancyCfg.Volume = FBox(FVector(50.f, -250.f, -150.f), FVector(450.f, 250.f, 150.f));
+    FAzureOccupancyGrid Occupancy;
+    Occupancy.Configure(OccupancyCfg);
+
+    const FBox OccupancyZone(FVector(100.f, -250.f, -150.f), FVector(300.f, 250.f, 150.f));
+    FStageResult& OccupancyStage = Runner.Run(TEXT("OccupancyGrid.Integrate"), DepthBytes, [&](int32 i)
+    {
+        Occupancy.Integrate(Inputs.Depth[i % NumDepth].GetData(), Inputs.DepthWidth, Inputs.DepthHeight,
+            OccupancyRays, FTransform::Identity, i / 30.0);
+        Sink += Occupancy.QueryZone(OccupancyZone).People;
+    });
+    const FAzureOccupancyZoneResult ZoneResult = Occupancy.QueryZone(OccupancyZone);
+    OccupancyStage.Extra.Emplace(TEXT("rays"), OccupancyRays.Rays.Num());
+    OccupancyStage.Extra.Emplace(TEXT("voxels"), Occupancy.NumVoxels());
+    OccupancyStage.Extra.Emplace(TEXT("occupied_voxels"), Occupancy.NumOccupiedVoxels());
+    OccupancyStage.Extra.Emplace(TEXT("zone_people"), ZoneResult.People);
+    OccupancyStage.Extra.Emplace(TEXT("share_of_30fps_frame"), OccupancyStage.MeanNs / (1e9 / 30.0));
+
+    // Static background: the empty synthetic scene still has floor and back wall in the zone.
+    // Once learned (5 s with a 1 s time constant) they must not count as people, while the
+    // benchmark's people walking in afterwards must.
+    if (Inputs.CleanDepth.Num() == NumDepth)
+    {
+        FAzureOccupancyGrid::FSettings LearnCfg = OccupancyCfg;
+        LearnCfg.BackgroundSeconds = 1.f;
+        FAzureOccupancyGrid Learner;
+        Learner.Configure(LearnCfg);
+
+        TArray<uint16> EmptyDepth;
+        FRandomStream EmptyRandom(7);
+        int32 Frame = 0;
+        int32 UnlearnedPeople = 0;
+        for (; Frame < 150; ++Frame)
+        {
+            MakeSyntheticDepth(Frame, 0, EmptyRandom, Inputs.DepthWidth, Inputs.DepthHeight, EmptyDepth);
+            Learner.Integrate(EmptyDepth.GetData(), Inputs.DepthWidth, Inputs.DepthHeight, OccupancyRays, FTransform::Identity, Frame / 30.0);
+            if (Frame == 5)
+            {
+                UnlearnedPeople = Learner.QueryZone(OccupancyZone).People;
+            }
+        }
+        const FAzureOccupancyZoneResult Empty = Learner.QueryZone(OccupancyZone);
+
+        for (int32 i = 0; i < 15; ++i, ++Frame)
+        {
+            Learner.Integrate(Inputs.Depth[i % NumDepth].GetData(), Inputs.DepthWidth, Inputs.DepthHeight,
+                OccupancyRays, FTransform::Identity, Frame / 30.0);
+        }
+        const FAzureOccupancyZoneResult Crowd = Learner.QueryZone(OccupancyZone);
+
+        OccupancyStage.Extra.Emplace(TEXT("zone_people_empty_unlearned"), UnlearnedPeople);
+        OccupancyStage.Extra.Emplace(TEXT("zone_people_empty"), Empty.People);
+        OccupancyStage.Extra.Emplace(TEXT("zone_background_voxels_empty"), Empty.BackgroundVoxels);
+        OccupancyStage.Extra.Emplace(TEXT("zone_people_after_background"), Crowd.People);
+        UE_LOG(LogAzureBodyTracking, Display, TEXT("    occupancy: empty scene %d people before the background is learned, %d after (%d background voxels), %d with people"),
+            UnlearnedPeople, Empty.People, Empty.BackgroundVoxels, Crowd.People);
+
+        if (Empty.People != 0 || (NumBodies > 0 && Crowd.People == 0))
+        {
+            Failures.Add(FString::Printf(TEXT("OccupancyGrid: %d people in the learned empty scene (expected none), %d once %d people walk in (expected some)"),
+                Empty.People, Crowd.People, NumBodies));
+        }
+    }
+
+    // Look targets for a crowd: one call per avatar vs the batch, serial and with smoothing,
+    // clamps and the ParallelFor forced on
+    {
+        const FVector ViewerHead(0.2, -0.1, 2.0);
+        const FTransform KinectToWorld(FRotator(0.0, 180.0, 0.0), FVector(0.0, 0.0, 150.0));
+        const FTransform CameraWorld(FRotator(-5.0, 0.0, 0.0), FVector(-400.0, 0.0, 170.0));
+
+        FRandomStream CrowdRandom(7);
+        for (const int32 NumAvatars : { 1, 10, 100, 1000 })
+        {
+            TArray<FVector> Heads;
+            TArray<FVector> Forwards;
+            for (int32 a = 0; a < NumAvatars; ++a)
+            {
+                Heads.Add(FVector(CrowdRandom.FRandRange(200.f, 3000.f), CrowdRandom.FRandRange(-1500.f, 1500.f), 170.f));
+                Forwards.Add(FVector(-1.f, CrowdRandom.FRandRange(-0.5f, 0.5f), 0.f).GetSafeNormal());
+            }
+            TArray<FVector> Targets;
+            Targets.SetNumUninitialized(NumAvatars);
+            TArray<FVector> AimState;
+            AimState.SetNumZeroed(NumAvatars);
+
+            Runner.Run(*FString::Printf(TEXT("LookTargets.PerAvatar/%d"), NumAvatars), 0.0, [&](int32 i)
+            {
+                for (int32 a = 0; a < NumAvatars; ++a)
+                {
+                    Targets[a] = AzureLook::ComputeLookTargetFromKinectHead(ViewerHead, KinectToWorld, CameraWorld, Heads[a]);
+                }
+                Sink += (int64)Targets[i % NumAvatars].X;
+            }).Extra.Emplace(TEXT("avatars"), NumAvatars);
+
+            FAzureLookBatchSettings Plain;
+            Plain.MinAvatarsForParallel = MAX_int32;
+            Runner.Run(*FString::Printf(TEXT("LookTargets.Batch/%d"), NumAvatars), 0.0, [&](int32 i)
+            {
+                AzureLook::ComputeLookTargetsBatch(ViewerHead, KinectToWorld, CameraWorld, Heads, {}, Plain, 1.f / 30.f, {}, Targets);
+                Sink += (int64)Targets[i % NumAvatars].X;
+            }).Extra.Emplace(TEXT("avatars"), NumAvatars);
+
+            FAzureLookBatchSettings Full;
+            Full.SmoothingSeconds = 0.2f;
+            Full.MaxYawDegrees = 60.f;
+            Full.MaxPitchDegrees = 30.f;
+            Full.MinAvatarsForParallel = 1;
+            Runner.Run(*FString::Printf(TEXT("LookTargets.BatchParallelSmoothedClamped/%d"), NumAvatars), 0.0, [&](int32 i)
+            {
+                AzureLook::ComputeLookTargetsBatch(ViewerHead, KinectToWorld, CameraWorld, Heads, Forwards, Full, 1.f / 30.f, AimState, Targets);
+                Sink += (int64)Targets[i % NumAvatars].X;
+            }).Extra.Emplace(TEXT("avatars"), NumAvatars);
+        }
+    }
+
+    // Color decode at every sensor resolution: NV12 through the converter the decoder's workers
+    // run, MJPEG through the decoder's own JPEG path. Fewer iterations: these are whole frames.
+    {
+        IImageWrapperModule& ImageWrapper = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+        FAzureColorDecoder ColorDecoder(1);
+        FStageRunner ColorRunner(FMath::Max(1, Iterations / 20), 2);
+        FRandomStream ColorRandom(17);
+        TArray<uint8> Nv12;
+        TArray64<uint8> Jpeg;
+        TArray64<uint8> Bgra;
+        for (const FColorMode& Mode : ColorModes)
+        {
+            MakeSyntheticColor(Mode.Width, Mode.Height, ColorRandom, ImageWrapper, Nv12, Jpeg);
+            const double PixelBytes = (double)Mode.Width * Mode.Height * 4;
+            Bgra.SetNumUninitialized((int64)PixelBytes);
+
+            FStageResult& Nv12Stage = ColorRunner.Run(*FString::Printf(TEXT("ColorDecode.NV12/%s"), Mode.Name), Nv12.Num(), [&](int32 i)
+            {
+                FAzureColorDecoder::ConvertNv12ToBgra(Nv12.GetData(), Mode.Width, Mode.Height, Mode.Width, Bgra.GetData());
+                Sink += Bgra[i % Bgra.Num()];
+            });
+            Nv12Stage.Extra.Emplace(TEXT("share_of_30fps_frame"), Nv12Stage.MeanNs / (1e9 / 30.0));
+            if (Nv12Stage.AllocsPerIteration > 0.0)
+            {
+                Failures.Add(FString::Printf(TEXT("%s: %.2f allocations per frame once warm (expected none)"), *Nv12Stage.Name, Nv12Stage.AllocsPerIteration));
+            }
+
+            if (Jpeg.Num() == 0)
+            {
+                Failures.Add(FString::Printf(TEXT("ColorDecode.MJPEG/%s: could not encode the test frame"), Mode.Name));
+                continue;
+            }
+            int32 DecodedWidth = 0;
+            int32 DecodedHeight = 0;
+            int32 DecodeFailures = 0;
+            FStageResult& JpegStage = ColorRunner.Run(*FString::Printf(TEXT("ColorDecode.MJPEG/%s"), Mode.Name), Jpeg.Num(), [&](int32 i)
+            {
+                DecodeFailures += ColorDecoder.DecodeJpegToBgra(Jpeg.GetData(), Jpeg.Num(), Bgra, DecodedWidth, DecodedHeight) ? 0 : 1;
+                Sink += Bgra.Num() > 0 ? Bgra[i % Bgra.Num()] : 0;
+            });
+            JpegStage.Extra.Emplace(TEXT("share_of_30fps_frame"), JpegStage.MeanNs / (1e9 / 30.0));
+            JpegStage.Extra.Emplace(TEXT("compression_ratio"), PixelBytes / Jpeg.Num());
+            if (DecodeFailures > 0 || DecodedWidth != Mode.Width || DecodedHeight != Mode.Height)
+            {
+                Failures.Add(FString::Printf(TEXT("%s: %d failed decodes, %dx%d (expected %dx%d)"),
+                    *JpegStage.Name, DecodeFailures, DecodedWidth, DecodedHeight, Mode.Width, Mode.Height));
+            }
+        }
+        Runner.Results.Append(ColorRunner.Results);
+    }
+
+    // Depth codec (lossless recording path); the round trip is checked before it's timed
+    CheckDepthCodec(Inputs, Failures);
+
+    Runner.Run(TEXT("DepthCodec.RvlEncode"), DepthBytes, [&](int32 i)
+    {
+        AzureDepthCodec::Encode(Inputs.Depth[i % NumDepth].GetData(), NumPixels, EAzureDepthSecondStage::None, Encoded, Scratch);
+        Sink += Encoded.Num();
+    }).Extra.Emplace(TEXT("compression_ratio"), AverageRatio(Inputs, EAzureDepthSecondStage::None));
+
+    AzureDepthCodec::Encode(Inputs.Depth[0].GetData(), NumPixels, EAzureDepthSecondStage::None, Encoded, Scratch);
+    Runner.Run(TEXT("DepthCodec.RvlDecode"), DepthBytes, [&](int32 i)
+    {
+        Sink += AzureDepthCodec::Decode(Encoded.GetData(), Encoded.Num(), Decoded.GetData(), NumPixels, Scratch) ? 1 : 0;
+    });
+
+    Runner.Run(TEXT("DepthCodec.RvlLz4Encode"), DepthBytes, [&](int32 i)
+    {
+        AzureDepthCodec::Encode(Inputs.Depth[i % NumDepth].GetData(), NumPixels, EAzureDepthSecondStage::LZ4, Encoded, Scratch);
+        Sink += Encoded.Num();
+    }).Extra.Emplace(TEXT("compression_ratio"), AverageRatio(Inputs, EAzureDepthSecondStage::LZ4));
+
+    AzureDepthCodec::Encode(Inputs.Depth[0].GetData(), NumPixels, EAzureDepthSecondStage::LZ4, Encoded, Scratch);
+    Runner.Run(TEXT("DepthCodec.RvlLz4Decode"), DepthBytes, [&](int32 i)
+    {
+        Sink += AzureDepthCodec::Decode(Encoded.GetData(), Encoded.Num(), Decoded.GetData(), NumPixels, Scratch) ? 1 : 0;
+    });
+
+    for (const FStageResult& R : Runner.Results)
+    {
+        for (const TCHAR* Name : AllocationFreeStages)
+        {
+            if (R.Name == Name && R.AllocsPerIteration > 0.0)
+            {
+                Failures.Add(FString::Printf(TEXT("%s: %.2f allocations per frame once warm (expected none)"), Name, R.AllocsPerIteration));
+            }
+        }
+    }
+
+    // Soak: hours of frames through the components themselves, see AzureSoak::Run
+    TSharedPtr<FJsonObject> SoakJson;
+    if (SoakHours > 0.0)
+    {
+        FAzureSoakSettings Soak;
+        Soak.Hours = SoakHours;
+        Soak.MaxGrowthMB = SoakMaxGrowthMB;
+        Soak.TakePath = TakePath;
+        Soak.Frames = &Inputs.Frames;
+        Soak.Depth = &Inputs.Depth;
+        Soak.DepthWidth = Inputs.DepthWidth;
+        Soak.DepthHeight = Inputs.DepthHeight;
+        SoakJson = AzureSoak::Run(Soak, Failures);
+    }
+
+    // Report
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("benchmark"), TEXT("AzureKinect"));
+    Root->SetStringField(TEXT("sdk"), WITH_AZUREKINECT_SDK ? TEXT("k4a") : TEXT("stand-in"));
+    Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+    Root->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand());
+    Root->SetStringField(TEXT("configuration"), LexToString(FApp::GetBuildConfiguration()));
+    Root->SetStringField(TEXT("source"), Inputs.Source);
+    Root->SetNumberField(TEXT("iterations"), Iterations);
+    Root->SetNumberField(TEXT("bodies_per_frame"), BodiesPerFrame);
+    Root->SetNumberField(TEXT("depth_width"), Inputs.DepthWidth);
+    Root->SetNumberField(TEXT("depth_height"), Inputs.DepthHeight);
+    Root->SetNumberField(TEXT("color_width"), ColorWidth);
+    Root->SetNumberField(TEXT("color_height"), ColorHeight);
+    Root->SetNumberField(TEXT("checksum"), (double)Sink);
+    Root->SetNumberField(TEXT("self_test_checks"), NumChecks);
+
+    TArray<TSharedPtr<FJsonValue>> Stages;
+    for (const FStageResult& R : Runner.Results)
+    {
+        Stages.Add(MakeShared<FJsonValueObject>(StageToJson(R)));
+    }
+    Root->SetArrayField(TEXT("stages"), Stages);
+    if (SoakJson.IsValid())
+    {
+        Root->SetObjectField(TEXT("soak"), SoakJson);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> FailureValues;
+    for (const FString& Failure : Failures)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: %s"), *Failure);
+        FailureValues.Add(MakeShared<FJsonValueString>(Failure));
+    }
+    Root->SetArrayField(TEXT("failures"), FailureValues);
+    Root->SetBoolField(TEXT("passed"), Failures.Num() == 0);
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+    if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: can't write benchmark report '%s'"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogAzureBodyTracking, Display, TEXT("BodyBT: benchmark report written to %s"), *OutputPath);
+    return Failures.Num() > 0 ? 1 : 0;
+}
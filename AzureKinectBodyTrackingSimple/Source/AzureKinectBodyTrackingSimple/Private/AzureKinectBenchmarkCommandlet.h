@@ -0,0 +1,37 @@
+// AzureKinectBenchmarkCommandlet.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AzureKinectBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless benchmark of the per-frame hot paths (depth/color conversion, NV12/MJPEG color
+ * decode at every sensor resolution, skeleton fill, closest body, selectors, gestures, body
+ * spatial index by crowd size, depth filter, floor detection, occlusion mesh, occupancy grid,
+ * depth codec), fed with synthetic frames or recordings.
+ * Needs no sensor or GPU, so it also runs on the Linux stand-in build:
+ *
+ *   UnrealEditor-Cmd <Project> -run=AzureKinectBenchmark -nullrhi [-Iterations=600] [-Bodies=3]
+ *       [-Take=<File.aktake>] [-Depth=<File.akdepth>] [-Output=<File.json>]
+ *       [-SoakHours=<h>] [-SoakMaxGrowthMB=16] [-AllowCommandletRendering]
+ *
+ * Writes ns/frame (mean, median, p95, min), allocations and throughput per stage as JSON.
+ * Correctness checks run too: known answers for the skeleton, selector and stream helpers
+ * (AzureSelfTest::Run), depth codec round trip, depth filter quality and single-core budget,
+ * gesture budget (32 gestures, six people),
+ * floor convergence, occupancy background learning, no allocations in the stages that reserve their scratch. Any failure
+ * makes the exit code 1.
+ * -SoakHours additionally plays h hours of 30 fps frames through the components (see
+ * AzureSoak::Run) and fails if they allocate, leak textures or keep growing after warm-up;
+ * -AllowCommandletRendering gives the textures a render resource so uploads run too.
+ */
+UCLASS()
+class UAzureKinectBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAzureKinectBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -1,10 +1,56 @@
 ﻿#include "AzureKinectBodyTrackingComponent.h"
+#include "AzureBodyTrackingStats.h"
 #include <k4abt.h>      // for k4abt_tracker_create and k4abt_result_t
 #include <k4a/k4a.h>   // for k4a_device_get_calibration, etc.
 #include "AzureKinectLookSolver.h"
 #include "AzureActiveSelector.h"
 #include "AzureKinectSkeletonUtils.h"
 #include "AzureBodyFrameUtils.h"
+#include "AzureBodyQueries.h"
+#include "AzureTextureUtils.h"
+#include "AzureImuReader.h"
+#include "AzureBodyTrackingWorker.h"
+#include "AzureKinectLiveLinkSource.h"
+#include "AzureSkeletonPublisher.h"
+#include "AzureDepthRecorder.h"
+#include "AzureTakeRecorder.h"
+#include "AzureTakeFile.h"
+#include "ILiveLinkClient.h"
+#include "Features/IModularFeatures.h"
+#include "AzureGestureAsset.h"
+#include "ProceduralMeshComponent.h"
+#include "Async/Async.h"
+
+namespace
+{
+    // Floor, occlusion and occupancy each run one thread pool job at a time
+    bool IsJobRunning(const TFuture<void>& Job)
+    {
+        return Job.IsValid() && !Job.IsReady();
+    }
+
+    // Copies into To's arrays, which only grow until they fit the largest version of the tile
+    void CopyOcclusionTile(const FAzureOcclusionTile& From, FAzureOcclusionTile& To)
+    {
+        To.Vertices.Reset();
+        To.Vertices.Append(From.Vertices);
+        To.Triangles.Reset();
+        To.Triangles.Append(From.Triangles);
+    }
+
+    // A new reference to the frame's depth image for a job, which releases it; null without depth
+    k4a_image_t GetFrameDepthImage(k4abt_frame_t Frame)
+    {
+        k4a_capture_t FrameCapture = k4abt_frame_get_capture(Frame);
+        if (!FrameCapture)
+        {
+            return nullptr;
+        }
+        k4a_image_t DepthImg = k4a_capture_get_depth_image(FrameCapture);
+        k4a_capture_release(FrameCapture);
+        return DepthImg;
+    }
+}
 
 UAzureKinectBodyTrackingComponent::UAzureKinectBodyTrackingComponent()
 {
@@ -14,7 +60,7 @@ UAzureKinectBodyTrackingComponent::UAzureKinectBodyTrackingComponent()
 void UAzureKinectBodyTrackingComponent::BeginPlay()
 {
     Super::BeginPlay();
-    UE_LOG(LogTemp, Log, TEXT("BodyBT: Hello World"));
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: Hello World"));
 
     // only open the device if we are running a Play-in-Editor or Standalone game:
 #if WITH_EDITOR
@@ -33,43 +79,68 @@ void UAzureKinectBodyTrackingComponent::BeginPlay()
     }
 #endif
     ActiveSelector.Configure(AboveHeadMarginMM, RaiseHoldSeconds, ActiveStickySeconds);
+    GestureEngine.SetGestures(Gestures);
 
-    UE_LOG(LogTemp, Log, TEXT("BodyBT: BeginPlay"));
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: BeginPlay"));
 
     // 1) Open the sensor:
     if (K4A_RESULT_SUCCEEDED != k4a_device_open(0, &Device))
     {
-        UE_LOG(LogTemp, Error, TEXT("BodyBT: k4a_device_open failed"));
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: k4a_device_open failed"));
         return;
     }
 
-    // 2) Start its cameras (depth + color):
+    // 2) Start its cameras (depth; color only when the index map is warped into it):
     k4a_device_configuration_t Config = K4A_DEVICE_CONFIG_INIT_DISABLE_ALL;
     Config.depth_mode = K4A_DEPTH_MODE_NFOV_UNBINNED;
-    Config.color_resolution = K4A_COLOR_RESOLUTION_720P;
+    Config.color_resolution = bWarpBodyIndexToColor ? K4A_COLOR_RESOLUTION_720P : K4A_COLOR_RESOLUTION_OFF;
     if (K4A_RESULT_SUCCEEDED != k4a_device_start_cameras(Device, &Config))
     {
-        UE_LOG(LogTemp, Error, TEXT("BodyBT: k4a_device_start_cameras failed"));
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: k4a_device_start_cameras failed"));
         k4a_device_close(Device);
         Device = nullptr;
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("BodyBT: camera started"));
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: camera started"));
     startTracking();
+
+    if (bEnableImu)
+    {
+        StartImu();
+    }
 }
 
 void UAzureKinectBodyTrackingComponent::EndPlay(const EEndPlayReason::Type Reason)
 {
-    // 1) Tear down the tracker
-    if (Tracker)
+    // 0) Stop the tracking thread, then drop the last body frame and any warp scratch images
+    StopTake();
+    stopTracking();
+    if (FrameData)
     {
-        k4abt_tracker_shutdown(Tracker);
-        k4abt_tracker_destroy(Tracker);
-        Tracker = nullptr;
+        k4abt_frame_release(FrameData);
+        FrameData = nullptr;
+    }
+    Snapshot.Reset();
+    BodySpatialIndex.Reset();
+    ReleaseWarpImages();
+
+    AzureTex::ReleaseTexture(BodyIndexTexture);
+    AzureTex::ReleaseTexture(ActiveBodyMaskTexture);
+    AzureTex::ReleaseTexture(OccupancyHeatmapTexture);
+
+    // IMU thread and floor/occlusion jobs must be gone before the device closes
+    ImuReader.Reset();
+    WaitForFloorJob();
+    WaitForOcclusionJob();
+    WaitForOccupancyJob();
+    if (OcclusionMesh)
+    {
+        OcclusionMesh->DestroyComponent();
+        OcclusionMesh = nullptr;
     }
 
-    // 2) Stop & close the sensor
+    // 1) Stop & close the sensor
     if (Device)
     {
         k4a_device_stop_cameras(Device);
@@ -83,55 +154,117 @@ void UAzureKinectBodyTrackingComponent::EndPlay(const EEndPlayReason::Type Reaso
 void UAzureKinectBodyTrackingComponent::TickComponent(float DeltaTime, ELevelTick Tick, FActorComponentTickFunction* ThisTickFunc)
 {
     Super::TickComponent(DeltaTime, Tick, ThisTickFunc);
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_Tick);
 
-    if (!bIsTracking || !Tracker || !Device)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Not tracking or no tracker or no device!"));
-        return;
-    }
+    UpdateImu();
 
-    k4a_capture_t sensorCapture = nullptr;
-    if (k4a_device_get_capture(Device, &sensorCapture, 0) != K4A_WAIT_RESULT_SUCCEEDED)
+    bool bNewFrame = false;
+    if (TakeReader)
     {
-        return; // no new camera frame
+        bNewFrame = AdvanceTake(DeltaTime);
     }
-
-    if (k4abt_tracker_enqueue_capture(Tracker, sensorCapture, 0) != K4A_RESULT_SUCCEEDED)
+    else
     {
-        UE_LOG(LogTemp, Error, TEXT("BodyBT: enqueue failed"));
-        k4a_capture_release(sensorCapture);
-        return;
+        if (!bIsTracking || !Tracker || !Device || !TrackingWorker)
+        {
+            UE_LOG(LogAzureBodyTracking, Verbose, TEXT("Not tracking or no tracker or no device!"));
+            return;
+        }
+
+        // Capture and tracking run on the worker; pick up whatever it finished since last Tick.
+        // The snapshot arrives already built (and re-identified), so the SDK is read once per frame.
+        TrackingWorker->SetCameraTransform(AzureCameraTransform);
+
+        k4abt_frame_t newBodyFrame = nullptr;
+        if (TrackingWorker->ConsumeLatest(newBodyFrame, Snapshot))
+        {
+            bNewFrame = true;
+            if (FrameData)
+            {
+                k4abt_frame_release(FrameData);
+            }
+
+            FrameData = newBodyFrame;
+
+            // Both stamps come from the host's monotonic clock
+            if (Snapshot.SystemTimestampNsec != 0)
+            {
+                const double NowSeconds = FPlatformTime::Cycles64() * FPlatformTime::GetSecondsPerCycle64();
+                SensorToGameLatencyMs = (float)((NowSeconds - Snapshot.SystemTimestampNsec * 1e-9) * 1000.0);
+                TRACE_COUNTER_SET(AzureBT_SensorToGameLatencyMs, SensorToGameLatencyMs);
+            }
+        }
+        TRACE_COUNTER_SET(AzureBT_DroppedFrames, TrackingWorker->GetDroppedFrames());
     }
 
-    k4abt_frame_t newBodyFrame = nullptr;
-    if (k4abt_tracker_pop_result(Tracker, &newBodyFrame, 0) == K4A_RESULT_SUCCEEDED)
+    if (bNewFrame)
     {
-        if (FrameData)
         {
-            k4abt_frame_release(FrameData);
+            SCOPE_CYCLE_COUNTER(STAT_AzureBT_SpatialIndex);
+            BodySpatialIndex.Build(Snapshot);
         }
-
-        FrameData = newBodyFrame;
-        TrackedBodyCount = static_cast<int32>(k4abt_frame_get_num_bodies(FrameData));
+        TrackedBodyCount = Snapshot.Bodies.Num();
+        findClosestTrackedBody();
     }
-    else
+
+    if (bNewFrame)
     {
-        // no body frame ready yet
-        TrackedBodyCount = 0;
+        UpdateGestures();
     }
 
     // Update selection based on chosen mode
     UpdateActiveBodyFromFrame();
 
-    // Release sensor capture
-    k4a_capture_release(sensorCapture);
+    // Segmentation matte follows the (possibly new) active body
+    const bool bBodyIndexWanted = !bGateBodyIndexOnDemand
+        || BodyIndexDemand.IsWanted(BodyIndexTexture, BodyIndexIdleSeconds)
+        || BodyIndexDemand.IsWanted(ActiveBodyMaskTexture, BodyIndexIdleSeconds);
+    if (bNewFrame && bOutputBodyIndexMap && bBodyIndexWanted && FrameData)
+    {
+        UpdateBodyIndexTextures();
+    }
+
+    if (bNewFrame && bAutoCalibrateFloor && FrameData)
+    {
+        SubmitFloorFrame();
+    }
+    UpdateFloor();
+
+    if (bNewFrame && bBuildOcclusionMesh && FrameData)
+    {
+        SubmitOcclusionFrame();
+    }
+    UpdateOcclusionMesh();
+
+    if (bNewFrame && bTrackOccupancy && FrameData)
+    {
+        SubmitOccupancyFrame();
+    }
+    UpdateOccupancy();
+
+    if (LiveLinkSource)
+    {
+        LiveLinkSource->SetActivePersonId(ActiveBodyId);
+    }
+    if (SkeletonPublisher)
+    {
+        // Receivers mirror the selection and the scores behind it (-1 outside Scored mode)
+        StreamBodyScores.Reset();
+        for (const FAzureTrackedBody& Body : Snapshot.Bodies)
+        {
+            StreamBodyScores.Add(TPair<int32, float>(Body.PersonId, ScoredSelector.GetScore(Body.PersonId)));
+        }
+        SkeletonPublisher->SetSelection(ActiveBodyId, TrackedBodyId, StreamBodyScores);
+    }
 }
 
 void UAzureKinectBodyTrackingComponent::UpdateActiveBodyFromFrame()
 {
-    const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.f;
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_Selection);
 
-    if (!FrameData)
+    const float Now = (float)GetSelectionTimeSeconds();
+
+    if (!FrameData && !TakeReader)
     {
         SetActiveBody(-1);
         return;
@@ -144,50 +277,112 @@ void UAzureKinectBodyTrackingComponent::UpdateActiveBodyFromFrame()
         return;
     }
 
-    // WaveLastRaised: build a compact list of samples for this frame
-    TArray<FAzureBodySample> Samples;
-    const uint32 Num = k4abt_frame_get_num_bodies(FrameData);
-    Samples.Reserve(Num);
+    if (SelectionMode == EActiveSelectionMode::LastGesture)
+    {
+        if (GestureActivatedBodyId >= 0)
+        {
+            SetActiveBody(GestureActivatedBodyId);
+            GestureActivatedBodyId = -1;
+            ActiveLastSeenSeconds = Now;
+        }
+        else if (Snapshot.FindPerson(ActiveBodyId))
+        {
+            ActiveLastSeenSeconds = Now;
+        }
+        else if (ActiveBodyId >= 0 && (Now - ActiveLastSeenSeconds) > ActiveStickySeconds)
+        {
+            SetActiveBody(-1);
+        }
+        return;
+    }
 
-    for (uint32 i = 0; i < Num; ++i)
+    if (SelectionMode == EActiveSelectionMode::Scored)
     {
-        const int32 BodyId = (int32)k4abt_frame_get_body_id(FrameData, i);
-        if (BodyId < 0) continue;
+        FAzureScoredSelectorSettings Cfg;
+        Cfg.DistanceWeight = ScoreDistanceWeight;
+        Cfg.ZoneWeight = ScoreZoneWeight;
+        Cfg.FacingWeight = ScoreFacingWeight;
+        Cfg.ConfidenceWeight = ScoreConfidenceWeight;
+        Cfg.DwellWeight = ScoreDwellWeight;
+        Cfg.ZoneCenterWorld = FVector3f(InteractionZoneCenter);
+        Cfg.ZoneRadiusCm = InteractionZoneRadius;
+        Cfg.SwitchMargin = ScoreSwitchMargin;
+        Cfg.MinHoldSeconds = ScoreMinHoldSeconds;
+        Cfg.StickySeconds = ActiveStickySeconds;
+        ScoredSelector.Configure(Cfg);
+
+        ScoredSamples.Reset();
+        for (const FAzureTrackedBody& Body : Snapshot.Bodies)
+        {
+            ScoredSamples.Add(FAzureScoredSelector::MakeSample(Body));
+        }
+
+        SetActiveBody(ScoredSelector.Update(ScoredSamples, Now));
+        return;
+    }
+
+    // WaveLastRaised: build a compact list of samples for this frame
+    WaveSamples.Reset();
 
-        k4abt_skeleton_t Skel;
-        if (k4abt_frame_get_body_skeleton(FrameData, i, &Skel) != K4A_RESULT_SUCCEEDED) continue;
+    for (const FAzureTrackedBody& Body : Snapshot.Bodies)
+    {
+        const k4abt_skeleton_t& Skel = Body.Skeleton;
 
         FAzureBodySample S;
-        S.BodyId = BodyId;
+        S.BodyId = Body.PersonId;
         S.HeadY_mm = Skel.joints[K4ABT_JOINT_HEAD].position.xyz.y;
         S.LHandY_mm = Skel.joints[K4ABT_JOINT_HAND_LEFT].position.xyz.y;
         S.RHandY_mm = Skel.joints[K4ABT_JOINT_HAND_RIGHT].position.xyz.y;
         S.SeenAtSeconds = Now;
 
-        Samples.Add(S);
+        WaveSamples.Add(S);
     }
 
-    const int32 SuggestedId = ActiveSelector.UpdateWaveLastRaised(Samples, Now);
+    const int32 SuggestedId = ActiveSelector.UpdateWaveLastRaised(WaveSamples, Now);
     SetActiveBody(SuggestedId); // this fires your Blueprint event and sets bHasActive
 }
 
+double UAzureKinectBodyTrackingComponent::GetSelectionTimeSeconds() const
+{
+    // A take is timed by its own clock, so a replay selects the same bodies and recognizes the
+    // same gestures at any playback rate or when stepped every tick
+    if (TakeReader && TakeFrameIndex >= 0)
+    {
+        return TakeReader->GetFrameTimeUsec(TakeFrameIndex) * 1e-6;
+    }
+    return GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+}
+
+void UAzureKinectBodyTrackingComponent::ResetSelection()
+{
+    ActiveSelector.Reset();
+    ScoredSelector.Reset();
+    GestureEngine.Reset();
+    GestureActivatedBodyId = -1;
+    ActiveLastSeenSeconds = 0.f;
+    SetActiveBody(-1);
+}
+
 void UAzureKinectBodyTrackingComponent::startTracking()
 {
     if (!Device)
     {
-        UE_LOG(LogTemp, Error, TEXT("BodyBT: startTracking called before device open!"));
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: startTracking called before device open!"));
+        return;
+    }
+    if (bIsTracking)
+    {
         return;
     }
 
     // 3) Grab the calibration from the live camera stream:
-    k4a_calibration_t Calibration;
     if (K4A_RESULT_SUCCEEDED != k4a_device_get_calibration(
         Device,
         K4A_DEPTH_MODE_NFOV_UNBINNED,
         K4A_COLOR_RESOLUTION_720P,
         &Calibration))
     {
-        UE_LOG(LogTemp, Error, TEXT("BodyBT: k4a_device_get_calibration failed"));
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: k4a_device_get_calibration failed"));
         return;
     }
 
@@ -196,156 +391,1062 @@ void UAzureKinectBodyTrackingComponent::startTracking()
     k4a_result_t BodyRes = k4abt_tracker_create(&Calibration, TrackerConfig, &Tracker);
     if (BodyRes != K4A_RESULT_SUCCEEDED)
     {
-        UE_LOG(LogTemp, Error, TEXT("BodyBT: k4abt_tracker_create failed (code = %d)"), (int)BodyRes);
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: k4abt_tracker_create failed (code = %d)"), (int)BodyRes);
+        return;
+    }
+
+    // Subsampled unprojection for floor detection (~6k rays at NFOV)
+    AzureDepth::BuildRayTable(Calibration, 8, FloorRays);
+
+    // Denser one for the occupancy grid (~23k rays at NFOV)
+    AzureDepth::BuildRayTable(Calibration, 4, OccupancyRays);
+
+    // Only needed when the index map is warped into the color camera
+    if (bWarpBodyIndexToColor)
+    {
+        Transformation = k4a_transformation_create(&Calibration);
+        if (!Transformation)
+        {
+            UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: k4a_transformation_create failed, body index stays depth-aligned"));
+        }
+    }
+
+    PreallocateFrameMemory();
+
+    // 5) Capture -> tracker -> snapshot loop on its own thread
+    FAzureBodyTrackingWorker::FSettings WorkerSettings;
+    WorkerSettings.ExpectedMaxBodies = ExpectedMaxBodies;
+    WorkerSettings.bReidentify = bEnableReidentification;
+    WorkerSettings.Reidentification.WindowSeconds = ReidentificationWindowSeconds;
+
+    TrackingWorker = MakeShared<FAzureBodyTrackingWorker>(Device, Tracker, WorkerSettings);
+    TrackingWorker->SetCameraTransform(AzureCameraTransform);
+    if (bPublishLiveLink)
+    {
+        StartLiveLink();
+        TrackingWorker->SetLiveLinkSource(LiveLinkSource);
+    }
+    if (bStreamSkeletons)
+    {
+        SkeletonPublisher = MakeShared<FAzureSkeletonPublisher>();
+        if (SkeletonPublisher->Open(StreamAddress, StreamPort, StreamKeyframeInterval))
+        {
+            TrackingWorker->SetSkeletonPublisher(SkeletonPublisher);
+        }
+        else
+        {
+            SkeletonPublisher.Reset();
+        }
+    }
+
+    if (!TrackingWorker->Start())
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: tracking thread failed to start"));
+        stopTracking();
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("BodyBT: tracker initialized!"));
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: tracker initialized!"));
     bIsTracking = true;
 }
 
 
 void UAzureKinectBodyTrackingComponent::stopTracking()
 {
-    // Implementation for stopping the body tracking
-    UE_LOG(LogTemp, Log, TEXT("Stopping body tracking..."));
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("Stopping body tracking..."));
+    bIsTracking = false;
+
+    // Worker first: it uses the tracker and feeds the outputs
+    StopDepthRecording();
+    StopTakeRecording();
+    TrackingWorker.Reset();
+    StopLiveLink();
+    SkeletonPublisher.Reset();
+
+    if (Tracker)
+    {
+        k4abt_tracker_shutdown(Tracker);
+        k4abt_tracker_destroy(Tracker);
+        Tracker = nullptr;
+    }
+}
 
-    // Here you would typically stop the body tracking process and clean up resources.
-    // For example:
-    // k4a_device_stop_body_tracker(Device);
-    // k4a_device_close(Device);
+int32 UAzureKinectBodyTrackingComponent::GetDroppedBodyFrames() const
+{
+    return TrackingWorker ? TrackingWorker->GetDroppedFrames() : 0;
 }
 
-bool UAzureKinectBodyTrackingComponent::getBodySkeleton(TArray<FBodyJointData>& OutJoints) const
+void UAzureKinectBodyTrackingComponent::GetStreamStats(float& OutKilobitsPerSecond, int32& OutPacketsSent) const
 {
-    OutJoints.Reset();
+    OutKilobitsPerSecond = SkeletonPublisher ? SkeletonPublisher->GetKilobitsPerSecond() : 0.f;
+    OutPacketsSent = SkeletonPublisher ? SkeletonPublisher->GetPacketsSent() : 0;
+}
 
-    if (!FrameData)
+bool UAzureKinectBodyTrackingComponent::StartDepthRecording(const FString& FilePath)
+{
+    if (!TrackingWorker)
     {
-        UE_LOG(LogTemp, Warning, TEXT("BodyBT: no FrameData"));
+        UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: StartDepthRecording needs a running tracker"));
         return false;
     }
+    StopDepthRecording();
 
-    // how many bodies?
-    uint32 NumBodies = k4abt_frame_get_num_bodies(FrameData);
-    UE_LOG(LogTemp, Log, TEXT("BodyBT: NumBodies=%u TrackedBodyId=%d"), NumBodies, TrackedBodyId);
-    if (NumBodies == 0) return false;
+    const EAzureDepthSecondStage Stage = bDepthRecordingSecondStage ? EAzureDepthSecondStage::LZ4 : EAzureDepthSecondStage::None;
+    TSharedPtr<FAzureDepthRecorder> Recorder = MakeShared<FAzureDepthRecorder>();
+    if (!Recorder->Start(FilePath,
+        Calibration.depth_camera_calibration.resolution_width,
+        Calibration.depth_camera_calibration.resolution_height,
+        Stage, bVerifyDepthRecording))
+    {
+        return false;
+    }
 
-    // grab skeleton for the closest body
-    k4abt_skeleton_t Skeleton;
-    bool bFound = false;
+    DepthRecorder = Recorder;
+    TrackingWorker->SetDepthRecorder(DepthRecorder);
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: recording depth to %s"), *FilePath);
+    return true;
+}
 
-    for (uint32 i = 0; i < NumBodies; ++i)
+void UAzureKinectBodyTrackingComponent::StopDepthRecording()
+{
+    if (!DepthRecorder)
     {
-        if (TrackedBodyId != static_cast<int32>(k4abt_frame_get_body_id(FrameData, i)))
-        {
-            continue;
-        }
+        return;
+    }
 
-        if (k4abt_frame_get_body_skeleton(FrameData, i, &Skeleton) == K4A_RESULT_SUCCEEDED)
-        {
-            bFound = true;
-        }
+    // Detach first so the worker can't submit into a closing file
+    if (TrackingWorker)
+    {
+        TrackingWorker->SetDepthRecorder(nullptr);
+    }
+    DepthRecorder->Shutdown();
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: depth recording stopped, %d frames (%d dropped), %.2fx"),
+        DepthRecorder->GetFramesWritten(), DepthRecorder->GetFramesDropped(), DepthRecorder->GetCompressionRatio());
+    DepthRecorder.Reset();
+}
+
+void UAzureKinectBodyTrackingComponent::GetDepthRecordingStats(int32& OutFramesWritten, int32& OutFramesDropped, float& OutCompressionRatio) const
+{
+    OutFramesWritten = DepthRecorder ? DepthRecorder->GetFramesWritten() : 0;
+    OutFramesDropped = DepthRecorder ? DepthRecorder->GetFramesDropped() : 0;
+    OutCompressionRatio = DepthRecorder ? DepthRecorder->GetCompressionRatio() : 0.f;
+}
 
-        break;
+bool UAzureKinectBodyTrackingComponent::StartTakeRecording(const FString& FilePath)
+{
+    if (!TrackingWorker)
+    {
+        UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: StartTakeRecording needs a running tracker"));
+        return false;
     }
+    StopTakeRecording();
 
-    if (!bFound)
+    TSharedPtr<FAzureTakeRecorder> Recorder = MakeShared<FAzureTakeRecorder>();
+    if (!Recorder->Start(FilePath))
     {
-        UE_LOG(LogTemp, Warning, TEXT("BodyBT: requested BodyId %d not in frame"), TrackedBodyId);
         return false;
     }
 
-    AzureSkel::FillJointArrayFromSkeleton(Skeleton, AzureCameraTransform, OutJoints);
+    TakeRecorder = Recorder;
+    TrackingWorker->SetTakeRecorder(TakeRecorder);
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: recording take to %s"), *FilePath);
     return true;
 }
 
-bool UAzureKinectBodyTrackingComponent::getBoneDataByName(const FString& BoneName, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const
+void UAzureKinectBodyTrackingComponent::StopTakeRecording()
 {
-    for (const FBodyJointData& Joint : Joints)
+    if (!TakeRecorder)
     {
-        if (Joint.JointName.Equals(BoneName, ESearchCase::IgnoreCase))
-        {
-            OutJointData = Joint;
-            return true;
-        }
+        return;
     }
-    UE_LOG(LogTemp, Warning, TEXT("BodyBT: bone '%s' not found in provided skeleton"), *BoneName);
-    return false;
+
+    if (TrackingWorker)
+    {
+        TrackingWorker->SetTakeRecorder(nullptr);
+    }
+    TakeRecorder->Shutdown();
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: take recording stopped, %d frames (%d dropped)"),
+        TakeRecorder->GetFramesWritten(), TakeRecorder->GetFramesDropped());
+    TakeRecorder.Reset();
 }
 
-bool UAzureKinectBodyTrackingComponent::getBoneDataByEnum(EAzureKinectJoint JointEnum, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const
+bool UAzureKinectBodyTrackingComponent::PlayTake(const FString& FilePath)
 {
-    int32 WantedId = static_cast<int32>(JointEnum);
-    for (const FBodyJointData& Joint : Joints)
+    TSharedPtr<FAzureTakeReader> Reader = MakeShared<FAzureTakeReader>();
+    if (!Reader->Open(FilePath) || Reader->NumFrames() == 0)
     {
-        if (Joint.JointId == WantedId)
-        {
-            OutJointData = Joint;
-            return true;
-        }
+        return false;
     }
-    UE_LOG(LogTemp, Warning, TEXT("BodyBT: joint enum '%d' not found in provided skeleton"), WantedId);
-    return false;
+
+    // Live frame data would describe a different moment than the take
+    if (FrameData)
+    {
+        k4abt_frame_release(FrameData);
+        FrameData = nullptr;
+    }
+
+    TakeReader = Reader;
+    TakeFrameIndex = -1;
+    TakePositionSeconds = 0.f;
+    ResetSelection();
+    bIsPlayingTake = true;
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: playing take %s (%d frames, %.1f s)"), *FilePath, Reader->NumFrames(), Reader->GetDurationSeconds());
+    return true;
 }
 
-void UAzureKinectBodyTrackingComponent::findClosestTrackedBody()
+void UAzureKinectBodyTrackingComponent::StopTake()
+{
+    if (!TakeReader)
+    {
+        return;
+    }
+
+    TakeReader.Reset();
+    TakeFrameIndex = -1;
+    bIsPlayingTake = false;
+    Snapshot.Reset();
+    BodySpatialIndex.Reset();
+    TrackedBodyCount = 0;
+    TrackedBodyId = -1;
+    ResetSelection();
+}
+
+void UAzureKinectBodyTrackingComponent::SeekTake(float Seconds)
 {
-    TrackedBodyId = AzureFrame::FindClosestBodyId(FrameData);
+    if (TakeReader)
+    {
+        TakePositionSeconds = FMath::Clamp(Seconds, 0.f, (float)TakeReader->GetDurationSeconds());
+        TakeFrameIndex = -1; // force a read even if the frame doesn't change
+        ResetSelection();
+    }
 }
 
-FVector UAzureKinectBodyTrackingComponent::ComputeLookTargetFromKinectHead(
-    const FVector& HeadPosMeters_Kinect,
-    const FTransform& KinectToWorld,
-    const FTransform& CameraWorld,
-    const FVector& AvatarHeadWorld,
-    float AimDistance) const
+float UAzureKinectBodyTrackingComponent::GetTakeDuration() const
 {
-    return AzureLook::ComputeLookTargetFromKinectHead(
-        HeadPosMeters_Kinect, KinectToWorld, CameraWorld, AvatarHeadWorld, AimDistance);
+    return TakeReader ? (float)TakeReader->GetDurationSeconds() : 0.f;
 }
 
-bool UAzureKinectBodyTrackingComponent::GetSkeletonByBodyId(int32 BodyId, k4abt_skeleton_t& OutSkel) const
+bool UAzureKinectBodyTrackingComponent::AdvanceTake(float DeltaTime)
 {
-    if (!FrameData || BodyId < 0) return false;
+    const int32 NumFrames = TakeReader->NumFrames();
+    const float Duration = (float)TakeReader->GetDurationSeconds();
 
-    const uint32 NumBodies = k4abt_frame_get_num_bodies(FrameData);
-    for (uint32 i = 0; i < NumBodies; ++i)
+    int32 Index;
+    if (bTakeStepEveryTick)
     {
-        uint32 ThisId = k4abt_frame_get_body_id(FrameData, i);
-        if (ThisId == K4ABT_INVALID_BODY_ID) continue;
-        if (static_cast<int32>(ThisId) != BodyId) continue;
-
-        if (k4abt_frame_get_body_skeleton(FrameData, i, &OutSkel) == K4A_RESULT_SUCCEEDED)
+        Index = TakeFrameIndex + 1;
+        if (Index >= NumFrames)
         {
-            return true;
+            Index = bLoopTake ? 0 : NumFrames - 1;
         }
-        break;
+        TakePositionSeconds = TakeReader->GetFrameTimeUsec(Index) * 1e-6f;
     }
-    return false;
+    else
+    {
+        TakePositionSeconds += DeltaTime * TakePlaybackRate;
+        if (TakePositionSeconds > Duration)
+        {
+            TakePositionSeconds = (bLoopTake && Duration > 0.f) ? FMath::Fmod(TakePositionSeconds, Duration) : Duration;
+        }
+        Index = TakeReader->FindFrameAtTime((uint64)(TakePositionSeconds * 1e6));
+    }
+
+    if (Index == TakeFrameIndex || !TakeReader->ReadFrame(Index, Snapshot))
+    {
+        return false;
+    }
+    if (Index < TakeFrameIndex)
+    {
+        // Looped or sought back: the take clock went backwards, start selection over
+        ResetSelection();
+    }
+    TakeFrameIndex = Index;
+
+    // Recorded skeletons are sensor-space; place them with the current transform
+    for (FAzureTrackedBody& Body : Snapshot.Bodies)
+    {
+        AzureFrame::UpdateBodyWorld(Body, AzureCameraTransform);
+    }
+    return true;
 }
 
-bool UAzureKinectBodyTrackingComponent::GetActiveBodySkeleton(TArray<FBodyJointData>& OutJoints) const
+void UAzureKinectBodyTrackingComponent::StartLiveLink()
 {
-    if (SelectionMode == EActiveSelectionMode::Closest)
+    IModularFeatures& Features = IModularFeatures::Get();
+    if (!Features.IsModularFeatureAvailable(ILiveLinkClient::ModularFeatureName))
     {
-        // Preserve current behavior for convenience (use closest)
-        return getBodySkeleton(OutJoints);
+        UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: Live Link not available, is the plugin enabled?"));
+        return;
     }
 
-    k4abt_skeleton_t Skel;
-    if (!GetSkeletonByBodyId(ActiveBodyId, Skel)) return false;
+    ILiveLinkClient& Client = Features.GetModularFeature<ILiveLinkClient>(ILiveLinkClient::ModularFeatureName);
+    LiveLinkSource = MakeShared<FAzureKinectLiveLinkSource>(LiveLinkSubjectPrefix, bLiveLinkActiveBodyOnly);
+    Client.AddSource(LiveLinkSource);
+}
 
-    AzureSkel::FillJointArrayFromSkeleton(Skel, AzureCameraTransform, OutJoints);
-    return true;
+void UAzureKinectBodyTrackingComponent::StopLiveLink()
+{
+    if (!LiveLinkSource)
+    {
+        return;
+    }
+
+    IModularFeatures& Features = IModularFeatures::Get();
+    if (Features.IsModularFeatureAvailable(ILiveLinkClient::ModularFeatureName))
+    {
+        Features.GetModularFeature<ILiveLinkClient>(ILiveLinkClient::ModularFeatureName).RemoveSource(LiveLinkSource);
+    }
+    LiveLinkSource.Reset();
 }
 
-void UAzureKinectBodyTrackingComponent::SetActiveBody(int32 NewId)
+bool UAzureKinectBodyTrackingComponent::getBodySkeleton(TArray<FBodyJointData>& OutJoints) const
 {
-    if (ActiveBodyId == NewId) return;
-    const int32 Old = ActiveBodyId;
-    ActiveBodyId = NewId;
-    bHasActive = (ActiveBodyId >= 0);
-    OnActiveBodyChanged.Broadcast(Old, ActiveBodyId);
+    OutJoints.Reset();
+
+    if (!FrameData && !TakeReader)
+    {
+        UE_LOG(LogAzureBodyTracking, Verbose, TEXT("BodyBT: no FrameData"));
+        return false;
+    }
+
+    // how many bodies?
+    const int32 NumBodies = Snapshot.Bodies.Num();
+    UE_LOG(LogAzureBodyTracking, VeryVerbose, TEXT("BodyBT: NumBodies=%d TrackedBodyId=%d"), NumBodies, TrackedBodyId);
+    if (NumBodies == 0) return false;
+
+    // grab skeleton for the closest body
+    return AzureQuery::GetPersonJoints(Snapshot, TrackedBodyId, AzureCameraTransform, OutJoints);
+}
+
+bool UAzureKinectBodyTrackingComponent::getBoneDataByName(const FString& BoneName, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const
+{
+    return AzureQuery::FindJointByName(Joints, BoneName, OutJointData);
+}
+
+bool UAzureKinectBodyTrackingComponent::getBoneDataByEnum(EAzureKinectJoint JointEnum, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const
+{
+    return AzureQuery::FindJointById(Joints, JointEnum, OutJointData);
+}
+
+void UAzureKinectBodyTrackingComponent::findClosestTrackedBody()
+{
+    TrackedBodyId = AzureFrame::FindClosestBodyId(Snapshot);
+}
+
+bool UAzureKinectBodyTrackingComponent::FindNearestBodyToPoint(const FVector& WorldPoint, int32& OutBodyId, float& OutDistance) const
+{
+    return AzureQuery::FindNearestBody(BodySpatialIndex, WorldPoint, OutBodyId, OutDistance);
 }
 
+bool UAzureKinectBodyTrackingComponent::FindNearestJointToPoint(const FVector& WorldPoint, EAzureKinectJoint Joint, int32& OutBodyId, FVector& OutJointPosition, float& OutDistance) const
+{
+    return AzureQuery::FindNearestJoint(BodySpatialIndex, WorldPoint, Joint, OutBodyId, OutJointPosition, OutDistance);
+}
+
+bool UAzureKinectBodyTrackingComponent::FindNearestHandToPoint(const FVector& WorldPoint, int32& OutBodyId, EAzureKinectJoint& OutHand, FVector& OutHandPosition, float& OutDistance) const
+{
+    return AzureQuery::FindNearestHand(BodySpatialIndex, WorldPoint, OutBodyId, OutHand, OutHandPosition, OutDistance);
+}
+
+int32 UAzureKinectBodyTrackingComponent::GetBodiesInBox(const FBox& WorldBox, TArray<int32>& OutBodyIds, bool bFullyInside) const
+{
+    return BodySpatialIndex.FindBodiesInBox(WorldBox, OutBodyIds, bFullyInside);
+}
+
+bool UAzureKinectBodyTrackingComponent::GetBodyWorldBounds(int32 BodyId, FBox& OutBounds) const
+{
+    return BodySpatialIndex.GetBodyBounds(BodyId, OutBounds);
+}
+
+FVector UAzureKinectBodyTrackingComponent::ComputeLookTargetFromKinectHead(
+    const FVector& HeadPosMeters_Kinect,
+    const FTransform& KinectToWorld,
+    const FTransform& CameraWorld,
+    const FVector& AvatarHeadWorld,
+    float AimDistance) const
+{
+    return AzureLook::ComputeLookTargetFromKinectHead(
+        HeadPosMeters_Kinect, KinectToWorld, CameraWorld, AvatarHeadWorld, AimDistance);
+}
+
+void UAzureKinectBodyTrackingComponent::ComputeLookTargetsFromKinectHead(
+    const FVector& HeadPosMeters_Kinect,
+    const FTransform& KinectToWorld,
+    const FTransform& CameraWorld,
+    const TArray<FVector>& AvatarHeadsWorld,
+    const TArray<FVector>& AvatarForwardsWorld,
+    TArray<FVector>& OutTargets,
+    float AimDistance,
+    float SmoothingSeconds,
+    float MaxYawDegrees,
+    float MaxPitchDegrees,
+    FName CrowdKey)
+{
+    FAzureLookBatchSettings Settings;
+    Settings.AimDistance = AimDistance;
+    Settings.SmoothingSeconds = SmoothingSeconds;
+    Settings.MaxYawDegrees = MaxYawDegrees;
+    Settings.MaxPitchDegrees = MaxPitchDegrees;
+
+    // Each crowd keeps its own aims; a different crowd size starts everyone unsmoothed.
+    // Smoothing advances once per frame, however often the crowd is asked for.
+    TArray<FVector>* AimDirections = nullptr;
+    float DeltaSeconds = GetWorld() ? GetWorld()->GetDeltaSeconds() : 0.f;
+    if (SmoothingSeconds > 0.f)
+    {
+        FLookCrowdState& Crowd = LookCrowds.FindOrAdd(CrowdKey);
+        AimDirections = &Crowd.AimDirections;
+        if (AimDirections->Num() != AvatarHeadsWorld.Num())
+        {
+            AimDirections->SetNumZeroed(AvatarHeadsWorld.Num());
+        }
+        if (Crowd.LastFrame == GFrameCounter)
+        {
+            DeltaSeconds = 0.f;
+        }
+        Crowd.LastFrame = GFrameCounter;
+    }
+
+    OutTargets.SetNumUninitialized(AvatarHeadsWorld.Num());
+    AzureLook::ComputeLookTargetsBatch(HeadPosMeters_Kinect, KinectToWorld, CameraWorld,
+        AvatarHeadsWorld, AvatarForwardsWorld, Settings, DeltaSeconds,
+        AimDirections ? TArrayView<FVector>(*AimDirections) : TArrayView<FVector>(),
+        OutTargets);
+}
+
+void UAzureKinectBodyTrackingComponent::ResetLookSmoothing(FName CrowdKey)
+{
+    LookCrowds.Remove(CrowdKey);
+}
+
+void UAzureKinectBodyTrackingComponent::ResetAllLookSmoothing()
+{
+    LookCrowds.Empty();
+}
+
+int32 UAzureKinectBodyTrackingComponent::FindBodyIndexInFrame(int32 BodyId) const
+{
+    const FAzureTrackedBody* Body = Snapshot.FindPerson(BodyId);
+    return Body ? Body->FrameIndex : -1;
+}
+
+bool UAzureKinectBodyTrackingComponent::GetActiveBodySkeleton(TArray<FBodyJointData>& OutJoints) const
+{
+    if (SelectionMode == EActiveSelectionMode::Closest)
+    {
+        // Preserve current behavior for convenience (use closest)
+        return getBodySkeleton(OutJoints);
+    }
+
+    return AzureQuery::GetPersonJoints(Snapshot, ActiveBodyId, AzureCameraTransform, OutJoints);
+}
+
+void UAzureKinectBodyTrackingComponent::SetActiveBody(int32 NewId)
+{
+    if (ActiveBodyId == NewId) return;
+    const int32 Old = ActiveBodyId;
+    ActiveBodyId = NewId;
+    bHasActive = (ActiveBodyId >= 0);
+    OnActiveBodyChanged.Broadcast(Old, ActiveBodyId);
+}
+
+void UAzureKinectBodyTrackingComponent::UpdateBodyIndexTextures()
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_BodyIndexTextures);
+
+    k4a_image_t IndexMap = k4abt_frame_get_body_index_map(FrameData);
+    if (!IndexMap)
+    {
+        return;
+    }
+
+    // Optionally resample into the color camera; falls back to depth alignment on failure
+    k4a_image_t Source = IndexMap;
+    if (Transformation)
+    {
+        if (k4a_image_t Warped = WarpBodyIndexToColor(IndexMap))
+        {
+            Source = Warped;
+        }
+    }
+
+    const int32 W = k4a_image_get_width_pixels(Source);
+    const int32 H = k4a_image_get_height_pixels(Source);
+    const uint8* Indices = k4a_image_get_buffer(Source);
+
+    if (Indices && W > 0 && H > 0)
+    {
+        const int32 NumPixels = W * H;
+
+        // Textures are only recreated on resolution change; every frame is a region update
+        AzureTex::EnsureTexture(BodyIndexTexture, W, H, PF_G8);
+        AzureTex::EnsureTexture(ActiveBodyMaskTexture, W, H, PF_G8);
+
+        AzureTex::UploadTexture(BodyIndexTexture, Indices, W, H, 1);
+
+        // Matte for the active body: the map stores frame indices, not body ids
+        const int32 ActiveIndex = FindBodyIndexInFrame(ActiveBodyId);
+        ActiveMaskBuffer.SetNumUninitialized(NumPixels, false);
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            ActiveMaskBuffer[i] = (ActiveIndex >= 0 && Indices[i] == ActiveIndex) ? 255 : 0;
+        }
+        AzureTex::UploadTexture(ActiveBodyMaskTexture, ActiveMaskBuffer.GetData(), W, H, 1);
+    }
+
+    k4a_image_release(IndexMap);
+}
+
+k4a_image_t UAzureKinectBodyTrackingComponent::WarpBodyIndexToColor(k4a_image_t IndexMap)
+{
+    k4a_capture_t FrameCapture = k4abt_frame_get_capture(FrameData);
+    if (!FrameCapture)
+    {
+        return nullptr;
+    }
+
+    k4a_image_t DepthImg = k4a_capture_get_depth_image(FrameCapture);
+    k4a_capture_release(FrameCapture);
+    if (!DepthImg)
+    {
+        return nullptr;
+    }
+
+    // Output images are allocated once and reused every frame
+    const int32 ColorW = Calibration.color_camera_calibration.resolution_width;
+    const int32 ColorH = Calibration.color_camera_calibration.resolution_height;
+    if (!WarpedDepthImage)
+    {
+        k4a_image_create(K4A_IMAGE_FORMAT_DEPTH16, ColorW, ColorH, ColorW * (int32)sizeof(uint16), &WarpedDepthImage);
+    }
+    if (!WarpedIndexImage)
+    {
+        k4a_image_create(K4A_IMAGE_FORMAT_CUSTOM8, ColorW, ColorH, ColorW * (int32)sizeof(uint8), &WarpedIndexImage);
+    }
+
+    k4a_image_t Result = nullptr;
+    if (WarpedDepthImage && WarpedIndexImage &&
+        k4a_transformation_depth_image_to_color_camera_custom(
+            Transformation, DepthImg, IndexMap,
+            WarpedDepthImage, WarpedIndexImage,
+            K4A_TRANSFORMATION_INTERPOLATION_TYPE_NEAREST,
+            K4ABT_BODY_INDEX_MAP_BACKGROUND) == K4A_RESULT_SUCCEEDED)
+    {
+        Result = WarpedIndexImage;
+    }
+
+    k4a_image_release(DepthImg);
+    return Result;
+}
+
+void UAzureKinectBodyTrackingComponent::ReleaseWarpImages()
+{
+    if (WarpedDepthImage)
+    {
+        k4a_image_release(WarpedDepthImage);
+        WarpedDepthImage = nullptr;
+    }
+    if (WarpedIndexImage)
+    {
+        k4a_image_release(WarpedIndexImage);
+        WarpedIndexImage = nullptr;
+    }
+    if (Transformation)
+    {
+        k4a_transformation_destroy(Transformation);
+        Transformation = nullptr;
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::PreallocateFrameMemory()
+{
+    // Sized once here so a steady stream of frames doesn't allocate in Tick or the jobs
+    const int32 DepthW = Calibration.depth_camera_calibration.resolution_width;
+    const int32 DepthH = Calibration.depth_camera_calibration.resolution_height;
+
+    Snapshot.Bodies.Reserve(ExpectedMaxBodies);
+    ScoredSamples.Reserve(ExpectedMaxBodies);
+    WaveSamples.Reserve(ExpectedMaxBodies);
+    FloorPoints.Reserve(FloorRays.Rays.Num());
+
+    if (bOutputBodyIndexMap)
+    {
+        // Index map and active body matte, aligned to depth or warped to color
+        const int32 W = Transformation ? Calibration.color_camera_calibration.resolution_width : DepthW;
+        const int32 H = Transformation ? Calibration.color_camera_calibration.resolution_height : DepthH;
+        ActiveMaskBuffer.Reserve(W * H);
+        AzureTex::PreallocateStaging(W, H, 1, 2 * StagingFramesInFlight);
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::StartImu()
+{
+    k4a_calibration_t ImuCalibration;
+    if (K4A_RESULT_SUCCEEDED != k4a_device_get_calibration(
+        Device,
+        K4A_DEPTH_MODE_NFOV_UNBINNED,
+        K4A_COLOR_RESOLUTION_720P,
+        &ImuCalibration))
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: no calibration, IMU disabled"));
+        return;
+    }
+
+    ImuFilter.Configure(ImuFilterTimeConstant, 0.15f);
+    ImuFilter.Reset();
+
+    ImuReader = MakeShared<FAzureImuReader>(Device, ImuCalibration);
+    if (!ImuReader->Start())
+    {
+        ImuReader.Reset();
+        return;
+    }
+
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: IMU started"));
+}
+
+void UAzureKinectBodyTrackingComponent::UpdateImu()
+{
+    if (!ImuReader)
+    {
+        return;
+    }
+
+    // Run the filter over every sample since last tick (~50 at 30 fps)
+    ImuFilter.Configure(ImuFilterTimeConstant, 0.15f);
+    TRACE_COUNTER_SET(AzureBT_ImuDroppedSamples, ImuReader->GetDroppedSamples());
+
+    FAzureImuSample Sample;
+    while (ImuReader->PopSample(Sample))
+    {
+        ImuFilter.AddSample(Sample);
+    }
+
+    if (!ImuFilter.IsInitialized())
+    {
+        return;
+    }
+
+    SensorPitchDegrees = ImuFilter.GetPitchDegrees();
+    SensorRollDegrees = ImuFilter.GetRollDegrees();
+    SensorGravityDirection = AzureSkel::RemapKinectAxes(ImuFilter.GetDown());
+
+    if (bAutoLevelFromImu)
+    {
+        ApplySensorLevel(ImuFilter.GetDown());
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::setAzureCameraTransform(const FTransform& NewTransform)
+{
+    AzureCameraBaseTransform = NewTransform;
+    AzureCameraTransform = NewTransform;
+}
+
+void UAzureKinectBodyTrackingComponent::ApplySensorLevel(const FVector& DownDepthCamera)
+{
+    // Rotate measured gravity onto the level-sensor gravity (+Y down in Azure axes),
+    // then place the levelled sensor with the Blueprint transform.
+    const FVector MeasuredDown = AzureSkel::RemapKinectAxes(DownDepthCamera).GetSafeNormal();
+    const FVector LevelDown = AzureSkel::RemapKinectAxes(FVector(0.f, 1.f, 0.f));
+    const FQuat Level = FQuat::FindBetweenNormals(MeasuredDown, LevelDown);
+
+    AzureCameraTransform = FTransform(Level) * AzureCameraBaseTransform;
+}
+
+void UAzureKinectBodyTrackingComponent::SubmitFloorFrame()
+{
+    if (IsJobRunning(FloorJob) || !FloorRays.IsValid())
+    {
+        return; // previous frame still being processed, skip this one
+    }
+
+    k4a_capture_t FrameCapture = k4abt_frame_get_capture(FrameData);
+    if (!FrameCapture)
+    {
+        return;
+    }
+
+    // Only the subsampled points leave the game thread, not the whole depth image
+    FloorPoints.Reset();
+    if (k4a_image_t DepthImg = k4a_capture_get_depth_image(FrameCapture))
+    {
+        AzureDepth::SamplePointCloud(
+            reinterpret_cast<const uint16*>(k4a_image_get_buffer(DepthImg)),
+            k4a_image_get_width_pixels(DepthImg),
+            k4a_image_get_height_pixels(DepthImg),
+            FloorRays, FloorPoints);
+        k4a_image_release(DepthImg);
+    }
+    k4a_capture_release(FrameCapture);
+
+    if (FloorPoints.Num() == 0)
+    {
+        return;
+    }
+
+    const bool bHasGravity = ImuReader.IsValid() && ImuFilter.IsInitialized();
+    const FVector3f GravityDown = FVector3f(ImuFilter.GetDown());
+
+    FloorJob = Async(EAsyncExecution::ThreadPool, [this, bHasGravity, GravityDown]()
+    {
+        if (bFloorResetRequested)
+        {
+            FloorDetector.Reset();
+            bFloorResetRequested = false;
+        }
+
+        FloorDetector.ProcessPoints(FloorPoints, bHasGravity ? &GravityDown : nullptr);
+
+        {
+            FScopeLock Lock(&FloorLock);
+            FloorEstimate = FloorDetector.GetEstimate();
+        }
+    });
+}
+
+void UAzureKinectBodyTrackingComponent::UpdateFloor()
+{
+    FAzureFloorEstimate Estimate;
+    {
+        FScopeLock Lock(&FloorLock);
+        Estimate = FloorEstimate;
+    }
+
+    bFloorConverged = Estimate.bConverged;
+    FloorInlierRatio = Estimate.InlierRatio;
+    if (!Estimate.bValid)
+    {
+        return;
+    }
+    FloorSensorHeightCm = Estimate.HeightMm * 0.1f;
+
+    if (!bAutoCalibrateFloor)
+    {
+        return;
+    }
+
+    // Floor gives tilt and height; it overrides the IMU-only levelling
+    ApplySensorLevel(-FVector(Estimate.Up));
+    FVector Location = AzureCameraTransform.GetLocation();
+    Location.Z = FloorWorldZ + FloorSensorHeightCm;
+    AzureCameraTransform.SetLocation(Location);
+}
+
+void UAzureKinectBodyTrackingComponent::ResetFloorCalibration()
+{
+    // The detector belongs to the worker while a job runs; reset there
+    bFloorResetRequested = true;
+
+    FScopeLock Lock(&FloorLock);
+    FloorEstimate = FAzureFloorEstimate();
+}
+
+void UAzureKinectBodyTrackingComponent::WaitForFloorJob()
+{
+    if (FloorJob.IsValid())
+    {
+        FloorJob.Wait();
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::SubmitOcclusionFrame()
+{
+    if (IsJobRunning(OcclusionJob))
+    {
+        return; // previous frame still being processed, skip this one
+    }
+
+    // The job reads the depth in place and releases the image when it's done
+    k4a_image_t DepthImg = GetFrameDepthImage(FrameData);
+    if (!DepthImg)
+    {
+        return;
+    }
+
+    if (!OcclusionMesh)
+    {
+        OcclusionMesh = NewObject<UProceduralMeshComponent>(GetOwner());
+        OcclusionMesh->bUseAsyncCooking = true;
+        OcclusionMesh->SetMobility(EComponentMobility::Movable);
+        OcclusionMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        OcclusionMesh->SetCastShadow(false);
+        OcclusionMesh->RegisterComponent();
+        OcclusionMesh->SetWorldTransform(AzureCameraTransform);
+    }
+
+    // Settings only change with a fresh builder: every tile is rebuilt anyway
+    const bool bInitialize = bOcclusionResetRequested || !OcclusionBuilder.IsInitialized();
+    bOcclusionResetRequested = false;
+
+    FAzureOcclusionMeshBuilder::FSettings Cfg;
+    Cfg.TileSize = OcclusionTileSize;
+    Cfg.ChangeThresholdMm = OcclusionChangeThresholdMm;
+    Cfg.PlanarToleranceMm = OcclusionPlanarToleranceMm;
+    Cfg.MaxEdgeJumpMm = OcclusionMaxEdgeJumpMm;
+
+    OcclusionJob = Async(EAsyncExecution::ThreadPool, [this, Cfg, bInitialize, DepthImg]()
+    {
+        if (bInitialize)
+        {
+            OcclusionBuilder.Initialize(Calibration, Cfg);
+
+            const int32 NumTiles = OcclusionBuilder.NumTiles();
+            FScopeLock Lock(&OcclusionLock);
+            PendingOcclusionTiles.SetNum(NumTiles);
+            PendingOcclusionIndices.Reset(NumTiles);
+            PendingOcclusionMask.Init(false, NumTiles);
+        }
+
+        const int32 NumChanged = OcclusionBuilder.Update(
+            reinterpret_cast<const uint16*>(k4a_image_get_buffer(DepthImg)),
+            k4a_image_get_width_pixels(DepthImg), k4a_image_get_height_pixels(DepthImg), OcclusionChangedScratch);
+        k4a_image_release(DepthImg);
+        TRACE_COUNTER_SET(AzureBT_OcclusionTilesRebuilt, NumChanged);
+
+        {
+            // A tile changed again before the game thread took it: the newer one wins
+            FScopeLock Lock(&OcclusionLock);
+            for (const int32 Index : OcclusionChangedScratch)
+            {
+                if (!PendingOcclusionMask[Index])
+                {
+                    PendingOcclusionMask[Index] = true;
+                    PendingOcclusionIndices.Add(Index);
+                }
+                CopyOcclusionTile(OcclusionBuilder.GetTile(Index), PendingOcclusionTiles[Index]);
+            }
+            PendingOcclusionTriangles = OcclusionBuilder.GetTriangleCount();
+            PendingOcclusionTilesRebuilt = NumChanged;
+        }
+    });
+}
+
+void UAzureKinectBodyTrackingComponent::UpdateOcclusionMesh()
+{
+    if (!OcclusionMesh)
+    {
+        return;
+    }
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_OcclusionUpload);
+
+    // Vertices are sensor-local, so moving the sensor never rebuilds anything
+    if (!OcclusionMesh->GetComponentTransform().Equals(AzureCameraTransform))
+    {
+        OcclusionMesh->SetWorldTransform(AzureCameraTransform);
+    }
+    OcclusionMesh->SetVisibility(bBuildOcclusionMesh);
+
+    // Copy the changed tiles out, so the job isn't held up while the sections are created
+    UploadOcclusionIndices.Reset();
+    {
+        FScopeLock Lock(&OcclusionLock);
+        OcclusionTriangleCount = PendingOcclusionTriangles;
+        OcclusionTilesRebuilt = PendingOcclusionTilesRebuilt;
+        if (PendingOcclusionIndices.Num() == 0)
+        {
+            return;
+        }
+        if (UploadOcclusionTiles.Num() < PendingOcclusionTiles.Num())
+        {
+            UploadOcclusionTiles.SetNum(PendingOcclusionTiles.Num());
+        }
+        for (const int32 Index : PendingOcclusionIndices)
+        {
+            CopyOcclusionTile(PendingOcclusionTiles[Index], UploadOcclusionTiles[Index]);
+            PendingOcclusionMask[Index] = false;
+        }
+        UploadOcclusionIndices.Append(PendingOcclusionIndices);
+        PendingOcclusionIndices.Reset();
+    }
+
+    // Only the changed tiles' sections are recreated
+    const TArray<FVector> NoNormals;
+    const TArray<FVector2D> NoUVs;
+    const TArray<FColor> NoColors;
+    const TArray<FProcMeshTangent> NoTangents;
+    for (const int32 Index : UploadOcclusionIndices)
+    {
+        const FAzureOcclusionTile& Tile = UploadOcclusionTiles[Index];
+        if (Tile.Triangles.Num() == 0)
+        {
+            OcclusionMesh->ClearMeshSection(Index);
+            continue;
+        }
+
+        OcclusionMesh->CreateMeshSection(Index, Tile.Vertices, Tile.Triangles,
+            NoNormals, NoUVs, NoColors, NoTangents, false);
+        if (OcclusionMaterial)
+        {
+            OcclusionMesh->SetMaterial(Index, OcclusionMaterial);
+        }
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::ResetOcclusionMesh()
+{
+    // The builder belongs to the job while it runs; the next submit starts a fresh one
+    WaitForOcclusionJob();
+    bOcclusionResetRequested = true;
+    {
+        FScopeLock Lock(&OcclusionLock);
+        PendingOcclusionIndices.Reset();
+        PendingOcclusionMask.Init(false, PendingOcclusionMask.Num());
+    }
+    if (OcclusionMesh)
+    {
+        OcclusionMesh->ClearAllMeshSections();
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::WaitForOcclusionJob()
+{
+    if (OcclusionJob.IsValid())
+    {
+        OcclusionJob.Wait();
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::SubmitOccupancyFrame()
+{
+    if (IsJobRunning(OccupancyJob) || !OccupancyRays.IsValid())
+    {
+        return; // previous frame still being processed, skip this one
+    }
+
+    // Like the occlusion job: depth read in place, the image released by the job
+    k4a_image_t DepthImg = GetFrameDepthImage(FrameData);
+    if (!DepthImg)
+    {
+        return;
+    }
+
+    FAzureOccupancyGrid::FSettings Cfg;
+    Cfg.Volume = OccupancyVolume;
+    Cfg.VoxelSizeCm = OccupancyVoxelSizeCm;
+    Cfg.HalfLifeSeconds = OccupancyHalfLifeSeconds;
+    Cfg.PersonFootprintCm2 = OccupancyPersonFootprintCm2;
+    Cfg.BackgroundSeconds = OccupancyBackgroundSeconds;
+
+    const FTransform SensorToWorld = AzureCameraTransform;
+    const double NowSeconds = FPlatformTime::Seconds();
+    const bool bReset = bOccupancyResetRequested;
+    const bool bHeatmap = bOutputOccupancyHeatmap;
+    bOccupancyResetRequested = false;
+    OccupancyJobZones = OccupancyZones;
+
+    OccupancyJob = Async(EAsyncExecution::ThreadPool, [this, Cfg, SensorToWorld, NowSeconds, bReset, bHeatmap, DepthImg]()
+    {
+        OccupancyGrid.Configure(Cfg);
+        if (bReset)
+        {
+            OccupancyGrid.Reset();
+        }
+        OccupancyGrid.Integrate(reinterpret_cast<const uint16*>(k4a_image_get_buffer(DepthImg)),
+            k4a_image_get_width_pixels(DepthImg), k4a_image_get_height_pixels(DepthImg), OccupancyRays, SensorToWorld, NowSeconds);
+        k4a_image_release(DepthImg);
+
+        const TArray<FAzureOccupancyZone>& Zones = OccupancyJobZones;
+        TArray<FAzureZoneOccupancy>& Results = OccupancyJobResults;
+        Results.SetNum(Zones.Num(), false);
+        for (int32 i = 0; i < Zones.Num(); ++i)
+        {
+            const FAzureOccupancyZoneResult Zone = OccupancyGrid.QueryZone(Zones[i].Bounds);
+            Results[i].Name = Zones[i].Name;
+            Results[i].People = Zone.People;
+            Results[i].OccupiedVoxels = Zone.OccupiedVoxels;
+            Results[i].OccupiedFloorFraction = Zone.TotalColumns > 0 ? (float)Zone.OccupiedColumns / Zone.TotalColumns : 0.f;
+        }
+
+        {
+            FScopeLock Lock(&OccupancyLock);
+            Swap(PendingZoneOccupancy, Results); // the three result arrays rotate, keeping their allocations
+            if (bHeatmap)
+            {
+                PendingOccupancyHeatmap.Reset();
+                PendingOccupancyHeatmap.Append(OccupancyGrid.GetHeatmap());
+                PendingOccupancyHeatmapSize = FIntPoint(OccupancyGrid.GetHeatmapWidth(), OccupancyGrid.GetHeatmapHeight());
+            }
+            bOccupancyResultReady = true;
+        }
+    });
+}
+
+void UAzureKinectBodyTrackingComponent::UpdateOccupancy()
+{
+    FScopeLock Lock(&OccupancyLock);
+    if (!bOccupancyResultReady)
+    {
+        return;
+    }
+    bOccupancyResultReady = false;
+
+    Swap(ZoneOccupancy, PendingZoneOccupancy);
+
+    const FIntPoint Size = PendingOccupancyHeatmapSize;
+    if (bOutputOccupancyHeatmap && Size.X > 0 && Size.Y > 0 && PendingOccupancyHeatmap.Num() == Size.X * Size.Y)
+    {
+        AzureTex::EnsureTexture(OccupancyHeatmapTexture, Size.X, Size.Y, PF_G8);
+        AzureTex::UploadTexture(OccupancyHeatmapTexture, PendingOccupancyHeatmap.GetData(), Size.X, Size.Y, 1);
+    }
+}
+
+bool UAzureKinectBodyTrackingComponent::GetZoneOccupancy(FName ZoneName, FAzureZoneOccupancy& OutOccupancy) const
+{
+    for (const FAzureZoneOccupancy& Zone : ZoneOccupancy)
+    {
+        if (Zone.Name == ZoneName)
+        {
+            OutOccupancy = Zone;
+            return true;
+        }
+    }
+    return false;
+}
+
+void UAzureKinectBodyTrackingComponent::ResetOccupancy()
+{
+    // The grid belongs to the job while it runs; reset there
+    bOccupancyResetRequested = true;
+}
+
+void UAzureKinectBodyTrackingComponent::WaitForOccupancyJob()
+{
+    if (OccupancyJob.IsValid())
+    {
+        OccupancyJob.Wait();
+    }
+}
+
+void UAzureKinectBodyTrackingComponent::SetGestures(const TArray<UAzureGestureAsset*>& NewGestures)
+{
+    Gestures = NewGestures;
+    GestureEngine.SetGestures(Gestures);
+}
+
+void UAzureKinectBodyTrackingComponent::UpdateGestures()
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_Gestures);
+
+    if (GestureEngine.NumGestures() == 0)
+    {
+        return;
+    }
+
+    const float Now = (float)GetSelectionTimeSeconds();
+
+    GestureEvents.Reset();
+    GestureEngine.Update(Snapshot, Now, GestureEvents);
+
+    for (const FAzureGestureEvent& E : GestureEvents)
+    {
+        UAzureGestureAsset* Gesture = Gestures.IsValidIndex(E.GestureIndex) ? Gestures[E.GestureIndex] : nullptr;
+        if (!Gesture) continue;
+
+        if (Gesture == ActivationGesture)
+        {
+            GestureActivatedBodyId = E.BodyId; // last one wins
+        }
+        OnGestureRecognized.Broadcast(E.BodyId, Gesture->GestureName, Gesture);
+    }
+}
@@ -0,0 +1,163 @@
+#include "AzureKinectLiveLinkSource.h"
+#include "AzureBodyTrackingStats.h"
+#include "AzureKinectBodyTrackingComponent.h" // EAzureKinectJoint
+#include "AzureBodySnapshot.h"
+#include "AzureKinectSkeletonUtils.h"
+#include "ILiveLinkClient.h"
+#include "Roles/LiveLinkAnimationRole.h"
+#include "Roles/LiveLinkAnimationTypes.h"
+#include "Misc/QualifiedFrameTime.h"
+
+#define LOCTEXT_NAMESPACE "AzureKinectLiveLinkSource"
+
+namespace
+{
+    // Subjects that stop receiving data are removed after this long
+    constexpr double StaleSubjectSeconds = 5.0;
+
+    // Key of the single subject in active-only mode; never a PersonId
+    constexpr int32 ActiveSubjectId = MIN_int32;
+
+    // Scene timecode counts sensor frames at the camera's full rate, with the remainder as subframes
+    const FFrameRate SensorTimecodeRate(30, 1);
+}
+
+FAzureKinectLiveLinkSource::FAzureKinectLiveLinkSource(FName InSubjectPrefix, bool bInActiveBodyOnly)
+    : SubjectPrefix(InSubjectPrefix)
+    , bActiveBodyOnly(bInActiveBodyOnly)
+    , ActivePersonId(-1)
+    , ActiveSubjectName(*FString::Printf(TEXT("%s_Active"), *InSubjectPrefix.ToString()))
+{
+    // Bone names come from the joint enum, resolved here on the game thread
+    const UEnum* JointEnum = StaticEnum<EAzureKinectJoint>();
+    BoneNames.Reserve(K4ABT_JOINT_COUNT);
+    BoneParents.Reserve(K4ABT_JOINT_COUNT);
+    for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+    {
+        BoneNames.Add(FName(*JointEnum->GetNameStringByValue(J)));
+        BoneParents.Add(AzureSkel::GetParentJoint(J));
+    }
+}
+
+void FAzureKinectLiveLinkSource::ReceiveClient(ILiveLinkClient* InClient, FGuid InSourceGuid)
+{
+    FScopeLock Lock(&ClientLock);
+    Client = InClient;
+    SourceGuid = InSourceGuid;
+}
+
+bool FAzureKinectLiveLinkSource::IsSourceStillValid() const
+{
+    FScopeLock Lock(&ClientLock);
+    return Client != nullptr;
+}
+
+bool FAzureKinectLiveLinkSource::RequestSourceShutdown()
+{
+    FScopeLock Lock(&ClientLock);
+    Client = nullptr;
+    return true;
+}
+
+FText FAzureKinectLiveLinkSource::GetSourceType() const
+{
+    return LOCTEXT("SourceType", "Azure Kinect Body Tracking");
+}
+
+FText FAzureKinectLiveLinkSource::GetSourceMachineName() const
+{
+    return FText::FromString(FPlatformProcess::ComputerName());
+}
+
+FText FAzureKinectLiveLinkSource::GetSourceStatus() const
+{
+    return IsSourceStillValid() ? LOCTEXT("Active", "Active") : LOCTEXT("Inactive", "Inactive");
+}
+
+void FAzureKinectLiveLinkSource::PushStaticData(const FLiveLinkSubjectKey& Key)
+{
+    FLiveLinkStaticDataStruct StaticData(FLiveLinkSkeletonStaticData::StaticStruct());
+    FLiveLinkSkeletonStaticData& Skeleton = *StaticData.Cast<FLiveLinkSkeletonStaticData>();
+    Skeleton.SetBoneNames(BoneNames);
+    Skeleton.SetBoneParents(BoneParents);
+
+    Client->PushSubjectStaticData_AnyThread(Key, ULiveLinkAnimationRole::StaticClass(), MoveTemp(StaticData));
+}
+
+void FAzureKinectLiveLinkSource::PushSnapshot_AnyThread(const FAzureFrameSnapshot& Snapshot, const FTransform& AzureCameraTransform)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AzureBT_LiveLinkPush);
+
+    FScopeLock Lock(&ClientLock);
+    if (!Client)
+    {
+        return;
+    }
+
+    // Sensor clock -> engine clock, fixed on the first frame so relative timing is the sensor's
+    const double SensorSeconds = Snapshot.DeviceTimestampUsec * 1e-6;
+    const double EngineNow = FPlatformTime::Seconds();
+    if (!bHasClockOffset)
+    {
+        SensorToEngineOffset = EngineNow - SensorSeconds;
+        bHasClockOffset = true;
+    }
+
+    const int32 ActiveId = ActivePersonId.GetValue();
+    const FQualifiedFrameTime SceneTime(FFrameTime::FromDecimal(SensorSeconds * SensorTimecodeRate.AsDecimal()), SensorTimecodeRate);
+    FTransform ComponentSpace[K4ABT_JOINT_COUNT];
+
+    for (const FAzureTrackedBody& Body : Snapshot.Bodies)
+    {
+        if (bActiveBodyOnly && Body.PersonId != ActiveId) continue;
+
+        // Names are built once per subject, not per frame
+        const int32 SubjectId = bActiveBodyOnly ? ActiveSubjectId : Body.PersonId;
+        FSubject* Subject = Subjects.Find(SubjectId);
+        if (!Subject)
+        {
+            Subject = &Subjects.Add(SubjectId);
+            Subject->Name = bActiveBodyOnly
+                ? ActiveSubjectName
+                : FName(*FString::Printf(TEXT("%s_%d"), *SubjectPrefix.ToString(), Body.PersonId));
+            PushStaticData(FLiveLinkSubjectKey(SourceGuid, Subject->Name));
+        }
+        Subject->LastSeen = EngineNow;
+        const FLiveLinkSubjectKey Key(SourceGuid, Subject->Name);
+
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            const k4abt_joint_t& Joint = Body.Skeleton.joints[J];
+            ComponentSpace[J] = FTransform(
+                AzureSkel::JointOrientationToWorld(Joint.orientation, AzureCameraTransform),
+                Body.JointsWorld[J]);
+        }
+
+        // Live Link wants parent-relative transforms
+        FLiveLinkFrameDataStruct FrameData(FLiveLinkAnimationFrameData::StaticStruct());
+        FLiveLinkAnimationFrameData& Anim = *FrameData.Cast<FLiveLinkAnimationFrameData>();
+        Anim.WorldTime = FLiveLinkWorldTime(SensorSeconds, SensorToEngineOffset);
+        Anim.MetaData.SceneTime = SceneTime;
+        Anim.Transforms.SetNumUninitialized(K4ABT_JOINT_COUNT);
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            const int32 Parent = BoneParents[J];
+            Anim.Transforms[J] = Parent >= 0
+                ? ComponentSpace[J].GetRelativeTransform(ComponentSpace[Parent])
+                : ComponentSpace[J];
+        }
+
+        Client->PushSubjectFrameData_AnyThread(Key, MoveTemp(FrameData));
+    }
+
+    for (auto It = Subjects.CreateIterator(); It; ++It)
+    {
+        if (EngineNow - It->Value.LastSeen > StaleSubjectSeconds)
+        {
+            Client->RemoveSubject_AnyThread(FLiveLinkSubjectKey(SourceGuid, It->Value.Name));
+            It.RemoveCurrent();
+        }
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
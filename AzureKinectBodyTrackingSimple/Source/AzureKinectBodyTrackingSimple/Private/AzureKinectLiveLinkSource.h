@@ -0,0 +1,62 @@
+// AzureKinectLiveLinkSource.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "ILiveLinkSource.h"
+#include "LiveLinkTypes.h"
+#include "HAL/ThreadSafeCounter.h"
+
+class ILiveLinkClient;
+struct FAzureFrameSnapshot;
+
+/**
+ * Live Link source fed straight from the tracking worker thread.
+ * Each body (or only the active one) becomes an animation subject: skeleton
+ * static data is sent once per subject, frame data on every tracker frame,
+ * stamped with the sensor's device clock (world time and scene timecode).
+ */
+class FAzureKinectLiveLinkSource : public ILiveLinkSource
+{
+public:
+    FAzureKinectLiveLinkSource(FName InSubjectPrefix, bool bInActiveBodyOnly);
+
+    /** Worker thread. Joints are pushed in world space (AzureCameraTransform applied). */
+    void PushSnapshot_AnyThread(const FAzureFrameSnapshot& Snapshot, const FTransform& AzureCameraTransform);
+
+    /** Game thread: which PersonId the "active" subject follows. */
+    void SetActivePersonId(int32 PersonId) { ActivePersonId.Set(PersonId); }
+
+    // ILiveLinkSource
+    virtual void ReceiveClient(ILiveLinkClient* InClient, FGuid InSourceGuid) override;
+    virtual bool IsSourceStillValid() const override;
+    virtual bool RequestSourceShutdown() override;
+    virtual FText GetSourceType() const override;
+    virtual FText GetSourceMachineName() const override;
+    virtual FText GetSourceStatus() const override;
+
+private:
+    void PushStaticData(const FLiveLinkSubjectKey& Key);
+
+    // Client/guid are set and cleared from the game thread while the worker pushes
+    mutable FCriticalSection ClientLock;
+    ILiveLinkClient* Client = nullptr;
+    FGuid SourceGuid;
+
+    FName SubjectPrefix;
+    bool bActiveBodyOnly = false;
+    FThreadSafeCounter ActivePersonId;
+
+    TArray<FName> BoneNames;
+    TArray<int32> BoneParents;
+
+    struct FSubject
+    {
+        FName Name;
+        double LastSeen = 0.0;
+    };
+
+    // Worker-thread only
+    TMap<int32, FSubject> Subjects;     // by PersonId (ActiveSubjectId in active-only mode), static data sent
+    FName ActiveSubjectName;
+    double SensorToEngineOffset = 0.0;
+    bool bHasClockOffset = false;
+};
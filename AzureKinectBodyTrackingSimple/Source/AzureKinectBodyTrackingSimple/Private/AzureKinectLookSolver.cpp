@@ -1,5 +1,38 @@
 // AzureKinectLookSolver.cpp
 #include "AzureKinectLookSolver.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr int32 AvatarsPerChunk = 64;
+
+    /** Limits Dir to MaxYaw/MaxPitch around Forward (world Z up). Both unit length. */
+    FVector ClampAim(const FVector& Dir, const FVector& Forward, double MaxYawRad, double MaxPitchRad)
+    {
+        FVector Flat(Forward.X, Forward.Y, 0.f);
+        if (!Flat.Normalize())
+        {
+            Flat = FVector::ForwardVector; // looking straight up/down: any heading will do
+        }
+        const FVector Right = FVector::CrossProduct(FVector::UpVector, Flat);
+
+        const double BasePitch = FMath::Asin(FMath::Clamp(Forward.Z, -1.0, 1.0));
+        const double Yaw = FMath::Atan2(FVector::DotProduct(Dir, Right), FVector::DotProduct(Dir, Flat));
+        const double Pitch = FMath::Asin(FMath::Clamp(Dir.Z, -1.0, 1.0));
+
+        const double ClampedYaw = FMath::Clamp(Yaw, -MaxYawRad, MaxYawRad);
+        const double ClampedPitch = FMath::Clamp(Pitch, BasePitch - MaxPitchRad, BasePitch + MaxPitchRad);
+        if (ClampedYaw == Yaw && ClampedPitch == Pitch)
+        {
+            return Dir;
+        }
+
+        double SinYaw, CosYaw, SinPitch, CosPitch;
+        FMath::SinCos(&SinYaw, &CosYaw, ClampedYaw);
+        FMath::SinCos(&SinPitch, &CosPitch, ClampedPitch);
+        return (Flat * CosYaw + Right * SinYaw) * CosPitch + FVector::UpVector * SinPitch;
+    }
+}
 
 namespace AzureLook
 {
@@ -11,12 +44,10 @@ namespace AzureLook
             P_m.Z * 100.f); // UE +Z
     }
 
-    FVector ComputeLookTargetFromKinectHead(
+    FVector ComputeLookRayPoint(
         const FVector& HeadPosMeters_Kinect,
         const FTransform& KinectToWorld,
-        const FTransform& CameraWorld,
-        const FVector& AvatarHeadWorld,
-        float            AimDistance)
+        const FTransform& CameraWorld)
     {
         // 1) Kinect -> UE sensor-local (cm)
         const FVector HeadLocalUE_cm = AzureToUE_SensorLocal_cm(HeadPosMeters_Kinect);
@@ -30,10 +61,85 @@ namespace AzureLook
 
         // 4) Camera dir -> World dir; point on camera ray
         const FVector DirWorldFromCam = CameraWorld.TransformVectorNoScale(DirCam);
-        const FVector WorldPointOnRay = CameraWorld.GetLocation() + DirWorldFromCam * 1000.f;
+        return CameraWorld.GetLocation() + DirWorldFromCam * 1000.f;
+    }
+
+    FVector ComputeLookTargetFromKinectHead(
+        const FVector& HeadPosMeters_Kinect,
+        const FTransform& KinectToWorld,
+        const FTransform& CameraWorld,
+        const FVector& AvatarHeadWorld,
+        float            AimDistance)
+    {
+        const FVector WorldPointOnRay = ComputeLookRayPoint(HeadPosMeters_Kinect, KinectToWorld, CameraWorld);
 
         // 5) Build final target along that world ray from the avatar head
         const FVector AimDirWorld = (WorldPointOnRay - AvatarHeadWorld).GetSafeNormal();
         return AvatarHeadWorld + AimDirWorld * AimDistance;
     }
+
+    void ComputeLookTargetsBatch(
+        const FVector& HeadPosMeters_Kinect,
+        const FTransform& KinectToWorld,
+        const FTransform& CameraWorld,
+        TArrayView<const FVector> AvatarHeadsWorld,
+        TArrayView<const FVector> AvatarForwardsWorld,
+        const FAzureLookBatchSettings& Settings,
+        float DeltaSeconds,
+        TArrayView<FVector> InOutAimDirections,
+        TArrayView<FVector> OutTargets)
+    {
+        const int32 Num = AvatarHeadsWorld.Num();
+        check(OutTargets.Num() == Num);
+        // A partial array would otherwise quietly turn clamping/smoothing off for everyone
+        ensureMsgf(AvatarForwardsWorld.Num() == 0 || AvatarForwardsWorld.Num() == Num,
+            TEXT("ComputeLookTargetsBatch: %d forwards for %d heads, not clamping"), AvatarForwardsWorld.Num(), Num);
+        ensureMsgf(InOutAimDirections.Num() == 0 || InOutAimDirections.Num() == Num,
+            TEXT("ComputeLookTargetsBatch: %d aim directions for %d heads, not smoothing"), InOutAimDirections.Num(), Num);
+
+        // Steps 1-4 are the same for every avatar
+        const FVector WorldPointOnRay = ComputeLookRayPoint(HeadPosMeters_Kinect, KinectToWorld, CameraWorld);
+
+        const bool bSmooth = Settings.SmoothingSeconds > 0.f && InOutAimDirections.Num() == Num;
+        const float Alpha = bSmooth ? 1.f - FMath::Exp(-FMath::Max(0.f, DeltaSeconds) / Settings.SmoothingSeconds) : 1.f;
+        const bool bClamp = AvatarForwardsWorld.Num() == Num && (Settings.MaxYawDegrees < 180.f || Settings.MaxPitchDegrees < 90.f);
+        const double MaxYawRad = FMath::DegreesToRadians((double)FMath::Clamp(Settings.MaxYawDegrees, 0.f, 180.f));
+        const double MaxPitchRad = FMath::DegreesToRadians((double)FMath::Clamp(Settings.MaxPitchDegrees, 0.f, 90.f));
+        const float AimDistance = Settings.AimDistance;
+
+        const int32 NumChunks = FMath::DivideAndRoundUp(Num, AvatarsPerChunk);
+        const EParallelForFlags Flags = Num >= Settings.MinAvatarsForParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+        ParallelFor(NumChunks, [&](int32 Chunk)
+        {
+            const int32 End = FMath::Min(Num, (Chunk + 1) * AvatarsPerChunk);
+            for (int32 i = Chunk * AvatarsPerChunk; i < End; ++i)
+            {
+                const FVector& Head = AvatarHeadsWorld[i];
+                FVector Dir = (WorldPointOnRay - Head).GetSafeNormal();
+
+                if (bSmooth)
+                {
+                    const FVector& Prev = InOutAimDirections[i];
+                    if (!Prev.IsNearlyZero())
+                    {
+                        Dir = (Prev + (Dir - Prev) * Alpha).GetSafeNormal(UE_SMALL_NUMBER, Dir);
+                    }
+                }
+                if (bClamp)
+                {
+                    const FVector Forward = AvatarForwardsWorld[i].GetSafeNormal();
+                    if (!Forward.IsNearlyZero())
+                    {
+                        Dir = ClampAim(Dir, Forward, MaxYawRad, MaxPitchRad);
+                    }
+                }
+                if (bSmooth)
+                {
+                    InOutAimDirections[i] = Dir;
+                }
+
+                OutTargets[i] = Head + Dir * AimDistance;
+            }
+        }, Flags);
+    }
 }
@@ -0,0 +1,571 @@
+#include "AzureKinectSelfTest.h"
+#include "AzureKinectBodyTrackingComponent.h" // FBodyJointData
+#include "AzureKinectSkeletonUtils.h"
+#include "AzureBodyFrameUtils.h"
+#include "AzureBodySnapshot.h"
+#include "AzureActiveSelector.h"
+#include "AzureScoredSelector.h"
+#include "AzureSkeletonStream.h"
+#include "AzureSkeletonPublisher.h"
+#include "AzureSkeletonSubscriber.h"
+#include "AzureColorDecoder.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    struct FChecks
+    {
+        TArray<FString>& Failures;
+        int32 Num = 0;
+
+        explicit FChecks(TArray<FString>& InFailures) : Failures(InFailures) {}
+
+        /** Adds What to Failures unless bOk. */
+        void Expect(bool bOk, const FString& What)
+        {
+            ++Num;
+            if (!bOk)
+            {
+                Failures.Add(What);
+            }
+        }
+    };
+
+    /** Upright, every joint straight above the pelvis, identity orientations. */
+    FAzureTrackedBody MakeBody(int32 PersonId, const FVector3f& PelvisMm)
+    {
+        FAzureTrackedBody Body;
+        Body.BodyId = PersonId + 100; // tracker ids and identities differ after re-identification
+        Body.PersonId = PersonId;
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            k4abt_joint_t& Joint = Body.Skeleton.joints[J];
+            Joint.position.xyz.x = PelvisMm.X;
+            Joint.position.xyz.y = PelvisMm.Y - 20.f * J;
+            Joint.position.xyz.z = PelvisMm.Z;
+            Joint.orientation.wxyz.w = 1.f;
+            Joint.orientation.wxyz.x = 0.f;
+            Joint.orientation.wxyz.y = 0.f;
+            Joint.orientation.wxyz.z = 0.f;
+            Joint.confidence_level = K4ABT_JOINT_CONFIDENCE_MEDIUM;
+        }
+        AzureFrame::UpdateBodyWorld(Body, FTransform::Identity);
+        return Body;
+    }
+
+    void CheckSkeletonFill(FChecks& C)
+    {
+        k4abt_skeleton_t Skel;
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            k4abt_joint_t& Joint = Skel.joints[J];
+            Joint.position.xyz.x = 100.f + J;
+            Joint.position.xyz.y = -200.f - 2.f * J;
+            Joint.position.xyz.z = 1500.f + 3.f * J;
+            Joint.orientation.wxyz.w = 1.f;
+            Joint.orientation.wxyz.x = 0.f;
+            Joint.orientation.wxyz.y = 0.f;
+            Joint.orientation.wxyz.z = 0.f;
+            Joint.confidence_level = K4ABT_JOINT_CONFIDENCE_MEDIUM;
+        }
+
+        // Sensor space: mm -> cm, UE.X = Kinect.Z, UE.Y = Kinect.X, UE.Z = Kinect.Y; then the placement
+        const FTransform Placement(FRotator(0.0, 90.0, 0.0), FVector(100.0, -50.0, 200.0));
+        TArray<FBodyJointData> Joints;
+        for (const FTransform& Transform : { FTransform::Identity, Placement })
+        {
+            AzureSkel::FillJointArrayFromSkeleton(Skel, Transform, Joints);
+            C.Expect(Joints.Num() == K4ABT_JOINT_COUNT,
+                FString::Printf(TEXT("FillJointArrayFromSkeleton: %d joints (expected %d)"), Joints.Num(), (int32)K4ABT_JOINT_COUNT));
+            if (Joints.Num() != K4ABT_JOINT_COUNT) return;
+
+            for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+            {
+                const k4a_float3_t& P = Skel.joints[J].position;
+                const FVector Expected = Transform.TransformPosition(FVector(P.xyz.z, P.xyz.x, P.xyz.y) * 0.1);
+                C.Expect(Joints[J].JointId == J && Joints[J].Position.Equals(Expected, 1e-3) &&
+                         Joints[J].Orientation.Equals(Transform.GetRotation(), 1e-4),
+                    FString::Printf(TEXT("FillJointArrayFromSkeleton: joint %d is %d at %s rot %s (expected %s rot %s)"),
+                        J, Joints[J].JointId, *Joints[J].Position.ToString(), *Joints[J].Orientation.ToString(),
+                        *Expected.ToString(), *Transform.GetRotation().ToString()));
+            }
+        }
+
+        // Names whose display name and enum name agree, so this holds with and without editor data
+        const TPair<int32, const TCHAR*> Names[] =
+        {
+            { K4ABT_JOINT_PELVIS, TEXT("Pelvis") }, { K4ABT_JOINT_HEAD, TEXT("Head") }, { K4ABT_JOINT_NOSE, TEXT("Nose") },
+        };
+        for (const TPair<int32, const TCHAR*>& Name : Names)
+        {
+            C.Expect(Joints[Name.Key].JointName == Name.Value,
+                FString::Printf(TEXT("FillJointArrayFromSkeleton: joint %d is named '%s' (expected '%s')"), Name.Key, *Joints[Name.Key].JointName, Name.Value));
+        }
+    }
+
+    void CheckClosestBody(FChecks& C)
+    {
+        FAzureFrameSnapshot Snapshot;
+        C.Expect(AzureFrame::FindClosestBodyId(Snapshot) == -1, TEXT("FindClosestBodyId: an empty frame doesn't return -1"));
+
+        Snapshot.Bodies.Add(MakeBody(7, FVector3f(0.f, 0.f, 3000.f)));
+        Snapshot.Bodies.Add(MakeBody(3, FVector3f(400.f, -200.f, 1500.f)));
+        Snapshot.Bodies.Add(MakeBody(9, FVector3f(-1600.f, 0.f, 900.f))); // closer in depth, further away
+        const int32 Closest = AzureFrame::FindClosestBodyId(Snapshot);
+        C.Expect(Closest == 3, FString::Printf(TEXT("FindClosestBodyId: %d (expected person 3)"), Closest));
+    }
+
+    void CheckActiveSelector(FChecks& C)
+    {
+        FAzureActiveSelector Selector;
+        Selector.Configure(120, 0.15f, 2.f);
+
+        // Azure +Y is down: a hand above the head has the smaller Y
+        auto Sample = [](int32 BodyId, bool bLeftUp, bool bRightUp, float Now)
+        {
+            FAzureBodySample S;
+            S.BodyId = BodyId;
+            S.HeadY_mm = -700.f;
+            S.LHandY_mm = bLeftUp ? -900.f : -100.f;
+            S.RHandY_mm = bRightUp ? -900.f : -100.f;
+            S.SeenAtSeconds = Now;
+            return S;
+        };
+
+        struct FStep
+        {
+            float Now;
+            TArray<FAzureBodySample> Bodies;
+            int32 Expected;
+            const TCHAR* What;
+        };
+        const FStep Steps[] =
+        {
+            { 0.f, { Sample(1, false, false, 0.f), Sample(2, false, false, 0.f) }, -1, TEXT("nobody raised a hand") },
+            { 1.f, { Sample(1, false, false, 1.f), Sample(2, false, true, 1.f) }, 2, TEXT("2 raised the right hand") },
+            { 2.f, { Sample(1, true, false, 2.f), Sample(2, false, false, 2.f) }, 1, TEXT("1 raised the left hand last") },
+            { 3.f, { Sample(1, false, false, 3.f), Sample(2, false, false, 3.f) }, 1, TEXT("hands down, 1 still in view") },
+            { 6.f, { Sample(2, false, false, 6.f) }, -1, TEXT("1 gone for longer than sticky") },
+        };
+        for (const FStep& Step : Steps)
+        {
+            const int32 Active = Selector.UpdateWaveLastRaised(Step.Bodies, Step.Now);
+            C.Expect(Active == Step.Expected,
+                FString::Printf(TEXT("ActiveSelector (%s): %d (expected %d)"), Step.What, Active, Step.Expected));
+        }
+    }
+
+    void CheckScoredSelector(FChecks& C)
+    {
+        FAzureScoredSelector Selector;
+        Selector.Configure(FAzureScoredSelectorSettings()); // 0.1 switch margin, 1 s hold, 2 s sticky
+
+        auto Sample = [](int32 BodyId, float DistanceMm, bool bFacing)
+        {
+            FAzureScoredBodySample S;
+            S.BodyId = BodyId;
+            S.Pelvis_mm = FVector3f(0.f, 0.f, DistanceMm);
+            S.Facing = FVector3f(0.f, 0.f, bFacing ? -1.f : 1.f);
+            S.Confidence = 1.f;
+            return S;
+        };
+
+        struct FStep
+        {
+            float Now;
+            TArray<FAzureScoredBodySample> Bodies;
+            int32 Expected;
+            const TCHAR* What;
+        };
+        const FStep Steps[] =
+        {
+            { 0.0f, { Sample(1, 1500.f, true), Sample(2, 4000.f, false) }, 1, TEXT("1 close and facing") },
+            { 0.5f, { Sample(1, 4000.f, false), Sample(2, 1500.f, true) }, 1, TEXT("2 better before the hold time") },
+            { 1.5f, { Sample(1, 4000.f, false), Sample(2, 1500.f, true) }, 2, TEXT("2 better after the hold time") },
+            { 3.0f, { Sample(1, 1400.f, true), Sample(2, 1500.f, true) }, 2, TEXT("1 better within the switch margin") },
+            { 4.0f, { Sample(1, 1400.f, true) }, 2, TEXT("2 out of view within sticky") },
+            { 5.5f, { Sample(1, 1400.f, true) }, 1, TEXT("2 out of view for longer than sticky") },
+        };
+        for (const FStep& Step : Steps)
+        {
+            const int32 Active = Selector.Update(Step.Bodies, Step.Now);
+            C.Expect(Active == Step.Expected,
+                FString::Printf(TEXT("ScoredSelector (%s): %d (expected %d)"), Step.What, Active, Step.Expected));
+        }
+
+        const FAzureScoredSelectorSettings Settings;
+        const float Facing = FAzureScoredSelector::Score(Sample(1, 2000.f, true), 0.f, Settings);
+        const float Away = FAzureScoredSelector::Score(Sample(1, 2000.f, false), 0.f, Settings);
+        const float Far = FAzureScoredSelector::Score(Sample(1, 4000.f, true), 0.f, Settings);
+        C.Expect(Facing > Away && Facing > Far && Facing <= 1.f && Away >= 0.f,
+            FString::Printf(TEXT("ScoredSelector: scores facing %.3f, away %.3f, far %.3f (expected facing best, all in 0..1)"), Facing, Away, Far));
+    }
+
+    /** Sent and received agree within the wire format's precision (0.25 mm, 10-bit quaternions). */
+    void CompareStreamed(FChecks& C, const TCHAR* What, const FAzureFrameSnapshot& Sent, const FAzureFrameSnapshot& Received)
+    {
+        C.Expect(Received.Bodies.Num() == Sent.Bodies.Num() && Received.DeviceTimestampUsec == Sent.DeviceTimestampUsec,
+            FString::Printf(TEXT("SkeletonStream (%s): %d bodies at %llu us (expected %d at %llu us)"),
+                What, Received.Bodies.Num(), Received.DeviceTimestampUsec, Sent.Bodies.Num(), Sent.DeviceTimestampUsec));
+        if (Received.Bodies.Num() != Sent.Bodies.Num()) return;
+
+        for (int32 b = 0; b < Sent.Bodies.Num(); ++b)
+        {
+            const FAzureTrackedBody& S = Sent.Bodies[b];
+            const FAzureTrackedBody& R = Received.Bodies[b];
+            float MaxPositionError = 0.f;
+            float MaxAngleError = 0.f;
+            bool bConfidence = true;
+            for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+            {
+                const k4abt_joint_t& A = S.Skeleton.joints[J];
+                const k4abt_joint_t& B = R.Skeleton.joints[J];
+                for (int32 Axis = 0; Axis < 3; ++Axis)
+                {
+                    MaxPositionError = FMath::Max(MaxPositionError, FMath::Abs(A.position.v[Axis] - B.position.v[Axis]));
+                }
+                const FQuat Qa(A.orientation.wxyz.x, A.orientation.wxyz.y, A.orientation.wxyz.z, A.orientation.wxyz.w);
+                const FQuat Qb(B.orientation.wxyz.x, B.orientation.wxyz.y, B.orientation.wxyz.z, B.orientation.wxyz.w);
+                MaxAngleError = FMath::Max(MaxAngleError, (float)Qa.AngularDistance(Qb));
+                bConfidence &= A.confidence_level == B.confidence_level;
+            }
+            C.Expect(R.PersonId == S.PersonId && MaxPositionError <= 0.13f && MaxAngleError <= 0.01f && bConfidence,
+                FString::Printf(TEXT("SkeletonStream (%s): person %d as %d, position error %.3f mm, rotation error %.4f rad, confidence %s"),
+                    What, S.PersonId, R.PersonId, MaxPositionError, MaxAngleError, bConfidence ? TEXT("kept") : TEXT("lost")));
+        }
+    }
+
+    /** Three people (4, 11, 25) drifting a few mm per frame; person 11 jumps half a metre at frame 7. */
+    void MakeStreamFrames(int32 NumFrames, TArray<FAzureFrameSnapshot>& Frames)
+    {
+        FRandomStream Random(5);
+        Frames.SetNum(NumFrames);
+        for (int32 f = 0; f < NumFrames; ++f)
+        {
+            FAzureFrameSnapshot& Frame = Frames[f];
+            Frame.DeviceTimestampUsec = 1000 + (uint64)f * 33333;
+            for (const int32 PersonId : { 4, 11, 25 })
+            {
+                FAzureTrackedBody& Body = Frame.Bodies.Add_GetRef(f == 0
+                    ? MakeBody(PersonId, FVector3f(Random.FRandRange(-1500.f, 1500.f), 300.f, Random.FRandRange(1000.f, 4000.f)))
+                    : *Frames[f - 1].FindPerson(PersonId));
+                for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+                {
+                    k4abt_joint_t& Joint = Body.Skeleton.joints[J];
+                    for (int32 Axis = 0; Axis < 3; ++Axis)
+                    {
+                        Joint.position.v[Axis] += Random.FRandRange(-5.f, 5.f) + ((f == 7 && PersonId == 11) ? 500.f : 0.f);
+                    }
+                    const FQuat Q = FQuat(Random.GetUnitVector(), Random.FRandRange(-PI, PI));
+                    Joint.orientation.wxyz.w = Q.W;
+                    Joint.orientation.wxyz.x = Q.X;
+                    Joint.orientation.wxyz.y = Q.Y;
+                    Joint.orientation.wxyz.z = Q.Z;
+                    Joint.confidence_level = (k4abt_joint_confidence_level_t)((J + f) % 4);
+                }
+            }
+        }
+    }
+
+    /** Sent scores (negative: none) come back within a step of the byte they travel in. */
+    bool ScoresMatch(TArrayView<const float> Sent, const TArray<float>& Received)
+    {
+        if (Received.Num() != Sent.Num()) return false;
+        for (int32 b = 0; b < Sent.Num(); ++b)
+        {
+            const bool bOk = Sent[b] < 0.f ? Received[b] == -1.f : FMath::Abs(Received[b] - Sent[b]) <= 0.5f / 254.f + KINDA_SMALL_NUMBER;
+            if (!bOk) return false;
+        }
+        return true;
+    }
+
+    void CheckSkeletonStream(FChecks& C)
+    {
+        constexpr int32 KeyframeInterval = 5;
+        constexpr int32 NumPackets = 20;
+
+        TArray<FAzureFrameSnapshot> Frames;
+        MakeStreamFrames(NumPackets, Frames);
+
+        // Selection scores of people 4, 11 and 25 (25 unscored)
+        const float Scores[] = { 0.25f, 0.8f, -1.f };
+        TArray<float> ReceivedScores;
+
+        AzureStream::FHeader Header;
+        Header.ActiveBodyId = 11;
+        Header.TrackedBodyId = 4;
+        Header.CameraTransform = FTransform(FRotator(0.0, 30.0, 0.0), FVector(10.0, 20.0, 30.0));
+
+        // Every packet in order: everything arrives, deltas are smaller than keyframes
+        TArray<TArray<uint8>> Packets;
+        FAzureSkeletonEncoder Encoder;
+        Encoder.Configure(KeyframeInterval);
+        FAzureSkeletonDecoder Decoder;
+        AzureStream::FHeader Received;
+        FAzureFrameSnapshot Decoded;
+        int32 SmallestPacket = MAX_int32;
+        for (int32 f = 0; f < NumPackets; ++f)
+        {
+            Header.SensorTimestampUsec = Frames[f].DeviceTimestampUsec;
+            Header.SendUtcTicks = 630000000000000000ll + f;
+            Encoder.Encode(Frames[f], Header, Packets.AddDefaulted_GetRef(), Scores);
+            SmallestPacket = FMath::Min(SmallestPacket, Packets.Last().Num());
+
+            const FString What = FString::Printf(TEXT("packet %d"), f);
+            const bool bDecoded = Decoder.Decode(Packets.Last().GetData(), Packets.Last().Num(), Received, Decoded, &ReceivedScores);
+            C.Expect(bDecoded, FString::Printf(TEXT("SkeletonStream (%s): rejected"), *What));
+            if (!bDecoded) continue;
+
+            CompareStreamed(C, *What, Frames[f], Decoded);
+            C.Expect(ScoresMatch(Scores, ReceivedScores),
+                FString::Printf(TEXT("SkeletonStream (%s): selection scores don't round-trip"), *What));
+            C.Expect(Received.SessionId != 0 && Received.SessionId == Header.SessionId &&
+                     Received.Sequence == Header.Sequence && Received.SensorTimestampUsec == Header.SensorTimestampUsec &&
+                     Received.SendUtcTicks == Header.SendUtcTicks && Received.ActiveBodyId == Header.ActiveBodyId &&
+                     Received.TrackedBodyId == Header.TrackedBodyId &&
+                     Received.CameraTransform.Equals(Header.CameraTransform, 0.01),
+                FString::Printf(TEXT("SkeletonStream (%s): header doesn't round-trip"), *What));
+        }
+        C.Expect(Decoder.GetLostPackets() == 0 && Decoder.GetUndecodableBodies() == 0,
+            FString::Printf(TEXT("SkeletonStream: %d lost, %d undecodable with nothing dropped"), Decoder.GetLostPackets(), Decoder.GetUndecodableBodies()));
+        C.Expect(SmallestPacket < Packets[0].Num(),
+            FString::Printf(TEXT("SkeletonStream: no delta packet smaller than the keyframe (%d bytes)"), Packets[0].Num()));
+
+        // Late, truncated and foreign packets are rejected
+        C.Expect(!Decoder.Decode(Packets[NumPackets - 2].GetData(), Packets[NumPackets - 2].Num(), Received, Decoded),
+            TEXT("SkeletonStream: a late packet was accepted"));
+        FAzureSkeletonDecoder Fresh;
+        C.Expect(!Fresh.Decode(Packets[0].GetData(), Packets[0].Num() - 1, Received, Decoded),
+            TEXT("SkeletonStream: a truncated packet was accepted"));
+        TArray<uint8> Foreign = Packets[0];
+        Foreign[0] ^= 0xFF;
+        C.Expect(!Fresh.Decode(Foreign.GetData(), Foreign.Num(), Received, Decoded),
+            TEXT("SkeletonStream: a packet with the wrong magic was accepted"));
+
+        // A restarted sender starts over at sequence 1 in a new session: taken at once, from keyframes
+        const uint32 FirstSession = Header.SessionId;
+        const float NoScores[] = { -1.f, -1.f, -1.f };
+        FAzureSkeletonEncoder Restarted;
+        Restarted.Configure(KeyframeInterval);
+        TArray<uint8> RestartPacket;
+        for (int32 f = 0; f < 3; ++f)
+        {
+            Header.SensorTimestampUsec = Frames[f].DeviceTimestampUsec;
+            Restarted.Encode(Frames[f], Header, RestartPacket);
+            const FString What = FString::Printf(TEXT("restarted sender, packet %d"), f);
+            const bool bDecoded = Decoder.Decode(RestartPacket.GetData(), RestartPacket.Num(), Received, Decoded, &ReceivedScores);
+            C.Expect(bDecoded && Received.Sequence == (uint32)f + 1,
+                FString::Printf(TEXT("SkeletonStream (%s): rejected"), *What));
+            if (!bDecoded) continue;
+
+            CompareStreamed(C, *What, Frames[f], Decoded);
+            C.Expect(Header.SessionId != FirstSession && ScoresMatch(NoScores, ReceivedScores),
+                FString::Printf(TEXT("SkeletonStream (%s): same session or scores where none were sent"), *What));
+        }
+        C.Expect(Decoder.GetLostPackets() == 0,
+            FString::Printf(TEXT("SkeletonStream: a sender restart counted as %d lost packets"), Decoder.GetLostPackets()));
+
+        // Losses: a dropped delta costs nothing else; after a dropped keyframe its deltas can't be
+        // decoded until the next keyframe. Packet 5 (sequence 6) is everyone's second keyframe;
+        // the person who jumps gets a fresh one at packet 7, the others at packet 10.
+        FAzureSkeletonDecoder Lossy;
+        int32 LastUndecodable = 0;
+        for (int32 f = 0; f < NumPackets; ++f)
+        {
+            if (f == 2 || f == 5) continue;
+            const bool bDecoded = Lossy.Decode(Packets[f].GetData(), Packets[f].Num(), Received, Decoded);
+            C.Expect(bDecoded, FString::Printf(TEXT("SkeletonStream (lossy, packet %d): rejected"), f));
+            if (!bDecoded) continue;
+
+            const bool bWaitingForKeyframe = f >= 6 && f < 10;
+            for (const FAzureTrackedBody& Body : Decoded.Bodies)
+            {
+                const FAzureTrackedBody* Sent = Frames[f].FindPerson(Body.PersonId);
+                C.Expect(Sent && FMath::Abs(Sent->Skeleton.joints[0].position.xyz.z - Body.Skeleton.joints[0].position.xyz.z) <= 0.13f,
+                    FString::Printf(TEXT("SkeletonStream (lossy, packet %d): person %d decoded wrong"), f, Body.PersonId));
+            }
+            C.Expect(bWaitingForKeyframe ? Decoded.Bodies.Num() < Frames[f].Bodies.Num() : Decoded.Bodies.Num() == Frames[f].Bodies.Num(),
+                FString::Printf(TEXT("SkeletonStream (lossy, packet %d): %d of %d bodies decoded"), f, Decoded.Bodies.Num(), Frames[f].Bodies.Num()));
+            LastUndecodable = Lossy.GetUndecodableBodies();
+        }
+        C.Expect(Lossy.GetLostPackets() == 2 && LastUndecodable > 0,
+            FString::Printf(TEXT("SkeletonStream (lossy): %d lost, %d undecodable (expected 2 lost, some undecodable)"), Lossy.GetLostPackets(), LastUndecodable));
+    }
+}
+
+    /**
+     * Publisher -> UDP loopback -> subscriber, one frame at a time, with the selection the
+     * receiver component mirrors; then the publisher restarts (new session) mid-stream.
+     */
+    void CheckSkeletonLoopback(FChecks& C)
+    {
+        constexpr int32 NumFrames = 10;
+        const int32 Port = 47000 + (int32)(FPlatformProcess::GetCurrentProcessId() % 1000);
+
+        TArray<FAzureFrameSnapshot> Frames;
+        MakeStreamFrames(NumFrames, Frames);
+        const FTransform Placement(FRotator(0.0, -45.0, 0.0), FVector(0.0, 100.0, 50.0));
+        const TPair<int32, float> Selection[] = { TPair<int32, float>(4, 0.25f), TPair<int32, float>(11, 0.8f) };
+        const float ExpectedScores[] = { 0.25f, 0.8f, -1.f }; // per body: 4, 11, 25
+
+        FAzureSkeletonSubscriber Subscriber;
+        FAzureSkeletonPublisher Publisher;
+        const bool bOpen = Subscriber.Open(Port) && Publisher.Open(TEXT("127.0.0.1"), Port, 5);
+        C.Expect(bOpen, FString::Printf(TEXT("SkeletonLoopback: could not open UDP port %d"), Port));
+        if (!bOpen) return;
+        Publisher.SetSelection(11, 4, Selection);
+
+        AzureStream::FHeader Received;
+        FAzureFrameSnapshot Decoded;
+        TArray<float> ReceivedScores;
+        int64 ReceiveUtcTicks = 0;
+        auto SendAndReceive = [&](const FAzureFrameSnapshot& Frame)
+        {
+            Publisher.PushSnapshot_AnyThread(Frame, Placement);
+            for (const double Deadline = FPlatformTime::Seconds() + 2.0; FPlatformTime::Seconds() < Deadline; )
+            {
+                if (Subscriber.ConsumeLatest(Received, Decoded, ReceivedScores, ReceiveUtcTicks))
+                {
+                    return true;
+                }
+                FPlatformProcess::Sleep(0.002f);
+            }
+            return false;
+        };
+
+        uint32 FirstSession = 0;
+        for (int32 f = 0; f < NumFrames; ++f)
+        {
+            const FString What = FString::Printf(TEXT("loopback, frame %d"), f);
+            const bool bReceived = SendAndReceive(Frames[f]);
+            C.Expect(bReceived, FString::Printf(TEXT("SkeletonStream (%s): nothing arrived within 2 s"), *What));
+            if (!bReceived) return;
+
+            CompareStreamed(C, *What, Frames[f], Decoded);
+            C.Expect(Received.Sequence == (uint32)f + 1 && Received.ActiveBodyId == 11 && Received.TrackedBodyId == 4 &&
+                     Received.CameraTransform.Equals(Placement, 0.01) && ScoresMatch(ExpectedScores, ReceivedScores),
+                FString::Printf(TEXT("SkeletonStream (%s): header, selection or scores don't match what was sent"), *What));
+            C.Expect(ReceiveUtcTicks >= Received.SendUtcTicks,
+                FString::Printf(TEXT("SkeletonStream (%s): received %lld ticks before it was sent"), *What, Received.SendUtcTicks - ReceiveUtcTicks));
+            FirstSession = Received.SessionId;
+        }
+
+        // Reopening is a sender restart: its sequence 1 must not be taken for a late packet
+        Publisher.Close();
+        C.Expect(Publisher.Open(TEXT("127.0.0.1"), Port, 5), TEXT("SkeletonLoopback: could not reopen the publisher"));
+        const bool bRestarted = SendAndReceive(Frames[0]);
+        C.Expect(bRestarted && Received.SessionId != FirstSession && Received.Sequence == 1,
+            TEXT("SkeletonStream (loopback): the restarted sender's first packet was dropped"));
+        if (bRestarted)
+        {
+            CompareStreamed(C, TEXT("loopback, restarted"), Frames[0], Decoded);
+        }
+        C.Expect(Subscriber.GetLostPackets() == 0,
+            FString::Printf(TEXT("SkeletonStream (loopback): %d packets lost"), Subscriber.GetLostPackets()));
+    }
+}
+
+    /**
+     * NV12: limited-range black, white and red come out as 0, 255 and (255, 0, 0) in BGRA order,
+     * and row padding is skipped. MJPEG: a gradient survives the decoder's JPEG path.
+     */
+    void CheckColorDecode(FChecks& C)
+    {
+        // 4x2 pixels, stride 8 (padding 0xEE): two black columns, two white. Chroma is per 2x2 block.
+        constexpr int32 W = 4, H = 2, Stride = 8;
+        const uint8 Nv12[Stride * H + Stride * H / 2] =
+        {
+            16, 16, 235, 235, 0xEE, 0xEE, 0xEE, 0xEE,
+            16, 16, 235, 235, 0xEE, 0xEE, 0xEE, 0xEE,
+            128, 128, 128, 128, 0xEE, 0xEE, 0xEE, 0xEE,
+        };
+        uint8 Bgra[W * H * 4];
+        FAzureColorDecoder::ConvertNv12ToBgra(Nv12, W, H, Stride, Bgra);
+        const uint8 Expected[2][4] = { { 0, 0, 0, 255 }, { 255, 255, 255, 255 } };
+        const int32 Gray[4] = { 0, 0, 1, 1 };
+        bool bGrayOk = true;
+        for (int32 p = 0; p < W * H; ++p)
+        {
+            for (int32 Ch = 0; Ch < 4; ++Ch)
+            {
+                bGrayOk &= FMath::Abs((int32)Bgra[p * 4 + Ch] - (int32)Expected[Gray[p % W]][Ch]) <= 1;
+            }
+        }
+        C.Expect(bGrayOk, TEXT("ColorDecode: NV12 black/white (or row padding) decoded wrong"));
+
+        uint8 Red[Stride * H + Stride * H / 2];
+        FMemory::Memcpy(Red, Nv12, sizeof(Red));
+        for (int32 y = 0; y < H; ++y)
+        {
+            FMemory::Memset(Red + y * Stride, 81, W);
+        }
+        for (int32 x = 0; x < W; x += 2)
+        {
+            Red[Stride * H + x] = 90;      // U
+            Red[Stride * H + x + 1] = 240; // V
+        }
+        FAzureColorDecoder::ConvertNv12ToBgra(Red, W, H, Stride, Bgra);
+        C.Expect(Bgra[0] <= 1 && Bgra[1] <= 1 && Bgra[2] >= 254 && Bgra[3] == 255,
+            FString::Printf(TEXT("ColorDecode: NV12 red came out as BGRA %d,%d,%d,%d"), Bgra[0], Bgra[1], Bgra[2], Bgra[3]));
+
+        // JPEG: red across, blue down, so swapped channels or a flipped image show up
+        constexpr int32 JW = 64, JH = 48;
+        TArray64<uint8> Source;
+        Source.SetNumUninitialized(JW * JH * 4);
+        for (int32 y = 0; y < JH; ++y)
+        {
+            for (int32 x = 0; x < JW; ++x)
+            {
+                uint8* P = &Source[(y * JW + x) * 4];
+                P[0] = (uint8)(255 * y / (JH - 1));
+                P[1] = 64;
+                P[2] = (uint8)(255 * x / (JW - 1));
+                P[3] = 255;
+            }
+        }
+        IImageWrapperModule& ImageWrapper = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+        TSharedPtr<IImageWrapper> Encoder = ImageWrapper.CreateImageWrapper(EImageFormat::JPEG);
+        TArray64<uint8> Jpeg;
+        if (Encoder.IsValid() && Encoder->SetRaw(Source.GetData(), Source.Num(), JW, JH, ERGBFormat::BGRA, 8))
+        {
+            Jpeg = Encoder->GetCompressed(95);
+        }
+
+        FAzureColorDecoder Decoder(1);
+        TArray64<uint8> Decoded;
+        int32 DecodedWidth = 0;
+        int32 DecodedHeight = 0;
+        const bool bDecoded = Jpeg.Num() > 0 && Decoder.DecodeJpegToBgra(Jpeg.GetData(), Jpeg.Num(), Decoded, DecodedWidth, DecodedHeight);
+        C.Expect(bDecoded && DecodedWidth == JW && DecodedHeight == JH && Decoded.Num() == Source.Num(),
+            FString::Printf(TEXT("ColorDecode: MJPEG %dx%d decoded as %dx%d"), JW, JH, DecodedWidth, DecodedHeight));
+        if (!bDecoded || Decoded.Num() != Source.Num()) return;
+
+        double TotalError = 0.0;
+        for (int64 i = 0; i < Source.Num(); ++i)
+        {
+            TotalError += FMath::Abs((int32)Decoded[i] - (int32)Source[i]);
+        }
+        const double MeanError = TotalError / Source.Num();
+        C.Expect(MeanError <= 3.0,
+            FString::Printf(TEXT("ColorDecode: MJPEG round trip off by %.2f levels on average (at most 3 expected)"), MeanError));
+    }
+}
+
+namespace AzureSelfTest
+{
+    int32 Run(TArray<FString>& OutFailures)
+    {
+        FChecks C(OutFailures);
+        CheckSkeletonFill(C);
+        CheckClosestBody(C);
+        CheckActiveSelector(C);
+        CheckScoredSelector(C);
+        CheckSkeletonStream(C);
+        CheckSkeletonLoopback(C);
+        CheckColorDecode(C);
+        return C.Num;
+    }
+}
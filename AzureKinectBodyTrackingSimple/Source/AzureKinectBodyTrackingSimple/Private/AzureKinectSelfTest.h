@@ -0,0 +1,18 @@
+// AzureKinectSelfTest.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+
+namespace AzureSelfTest
+{
+    /**
+     * Known-answer checks of the per-frame helpers on hand-built input, no sensor needed:
+     * FillJointArrayFromSkeleton (count, ids, names, axis remap, placement), FindClosestBodyId,
+     * both selectors (raise order, stickiness, hold time and switch margin) and the skeleton
+     * stream (keyframes and deltas within quantisation, header fields and scores, lost and late
+     * packets, truncation, sender restarts), also end to end over UDP loopback, and the color
+     * decoder (NV12 known answers, MJPEG round trip). Adds a line to OutFailures per mismatch;
+     * returns the number of checks run. Run by the benchmark commandlet and the
+     * AzureKinect.BodyTracking.KnownAnswers automation test.
+     */
+    int32 Run(TArray<FString>& OutFailures);
+}
@@ -0,0 +1,218 @@
+#include "AzureKinectSkeletonReceiverComponent.h"
+#include "AzureBodyTrackingStats.h"
+#include "AzureSkeletonSubscriber.h"
+#include "AzureBodyFrameUtils.h"
+#include "AzureBodyQueries.h"
+#include "AzureKinectLookSolver.h"
+#include "AzureGestureAsset.h"
+
+UAzureKinectSkeletonReceiverComponent::UAzureKinectSkeletonReceiverComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+}
+
+void UAzureKinectSkeletonReceiverComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+#if WITH_EDITOR
+    if (!GetWorld() || !GetWorld()->IsGameWorld())
+    {
+        return;
+    }
+#endif
+
+    GestureEngine.SetGestures(Gestures);
+
+    Subscriber = MakeShared<FAzureSkeletonSubscriber>();
+    if (!Subscriber->Open(ListenPort))
+    {
+        Subscriber.Reset();
+        return;
+    }
+    UE_LOG(LogAzureBodyTracking, Log, TEXT("BodyBT: listening for skeletons on port %d"), ListenPort);
+}
+
+void UAzureKinectSkeletonReceiverComponent::EndPlay(const EEndPlayReason::Type Reason)
+{
+    Subscriber.Reset();
+    ResetFrame();
+    Super::EndPlay(Reason);
+}
+
+void UAzureKinectSkeletonReceiverComponent::TickComponent(float DeltaTime, ELevelTick Tick, FActorComponentTickFunction* ThisTickFunc)
+{
+    Super::TickComponent(DeltaTime, Tick, ThisTickFunc);
+
+    if (!Subscriber)
+    {
+        return;
+    }
+
+    StreamKilobitsPerSecond = Subscriber->GetKilobitsPerSecond();
+    StreamLostPackets = Subscriber->GetLostPackets();
+
+    const double Now = FPlatformTime::Seconds();
+    AzureStream::FHeader Header;
+    int64 ReceiveUtcTicks = 0;
+    if (Subscriber->ConsumeLatest(Header, Snapshot, BodyScores, ReceiveUtcTicks))
+    {
+        LastPacketSeconds = Now;
+
+        // A restarted sender: gesture progress and its clock origin don't carry over
+        if (Header.SessionId != SessionId || Header.SensorTimestampUsec < SessionStartUsec)
+        {
+            GestureEngine.Reset();
+            SessionId = Header.SessionId;
+            SessionStartUsec = Header.SensorTimestampUsec;
+        }
+
+        if (bUseSenderCameraTransform)
+        {
+            AzureCameraTransform = Header.CameraTransform;
+        }
+        for (FAzureTrackedBody& Body : Snapshot.Bodies)
+        {
+            AzureFrame::UpdateBodyWorld(Body, AzureCameraTransform);
+        }
+        {
+            SCOPE_CYCLE_COUNTER(STAT_AzureBT_SpatialIndex);
+            BodySpatialIndex.Build(Snapshot);
+        }
+
+        TrackedBodyCount = Snapshot.Bodies.Num();
+        TrackedBodyId = Header.TrackedBodyId;
+        SetActiveBody(Header.ActiveBodyId);
+        UpdateGestures(Header.SensorTimestampUsec);
+
+        // FDateTime ticks are 100 ns
+        const float LatencyMs = (FDateTime::UtcNow().GetTicks() - Header.SendUtcTicks) / 10000.0;
+        StreamLatencyMs = StreamLatencyMs > 0.f ? FMath::Lerp(StreamLatencyMs, LatencyMs, 0.1f) : LatencyMs;
+    }
+
+    bIsTracking = (Now - LastPacketSeconds) < 1.0;
+    if (!bIsTracking && SessionId != 0)
+    {
+        // Sender gone: don't keep showing the last pose
+        ResetFrame();
+    }
+}
+
+void UAzureKinectSkeletonReceiverComponent::ResetFrame()
+{
+    Snapshot.Reset();
+    BodyScores.Reset();
+    BodySpatialIndex.Reset();
+    GestureEngine.Reset();
+    SessionId = 0;
+    SessionStartUsec = 0;
+    TrackedBodyCount = 0;
+    TrackedBodyId = -1;
+    SetActiveBody(-1);
+}
+
+void UAzureKinectSkeletonReceiverComponent::SetGestures(const TArray<UAzureGestureAsset*>& NewGestures)
+{
+    Gestures = NewGestures;
+    GestureEngine.SetGestures(Gestures);
+}
+
+void UAzureKinectSkeletonReceiverComponent::UpdateGestures(uint64 SensorTimestampUsec)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_Gestures);
+
+    if (GestureEngine.NumGestures() == 0)
+    {
+        return;
+    }
+
+    // The sender's sensor clock, not arrival time: network jitter would otherwise read as speed
+    const float Now = (float)((SensorTimestampUsec - SessionStartUsec) * 1e-6);
+
+    GestureEvents.Reset();
+    GestureEngine.Update(Snapshot, Now, GestureEvents);
+
+    for (const FAzureGestureEvent& E : GestureEvents)
+    {
+        UAzureGestureAsset* Gesture = Gestures.IsValidIndex(E.GestureIndex) ? Gestures[E.GestureIndex] : nullptr;
+        if (Gesture)
+        {
+            OnGestureRecognized.Broadcast(E.BodyId, Gesture->GestureName, Gesture);
+        }
+    }
+}
+
+bool UAzureKinectSkeletonReceiverComponent::getBodySkeleton(TArray<FBodyJointData>& OutJoints) const
+{
+    return AzureQuery::GetPersonJoints(Snapshot, TrackedBodyId, AzureCameraTransform, OutJoints);
+}
+
+bool UAzureKinectSkeletonReceiverComponent::GetActiveBodySkeleton(TArray<FBodyJointData>& OutJoints) const
+{
+    return AzureQuery::GetPersonJoints(Snapshot, ActiveBodyId, AzureCameraTransform, OutJoints);
+}
+
+bool UAzureKinectSkeletonReceiverComponent::getBoneDataByName(const FString& BoneName, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const
+{
+    return AzureQuery::FindJointByName(Joints, BoneName, OutJointData);
+}
+
+bool UAzureKinectSkeletonReceiverComponent::getBoneDataByEnum(EAzureKinectJoint JointEnum, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const
+{
+    return AzureQuery::FindJointById(Joints, JointEnum, OutJointData);
+}
+
+float UAzureKinectSkeletonReceiverComponent::GetBodySelectionScore(int32 BodyId) const
+{
+    if (const FAzureTrackedBody* Body = Snapshot.FindPerson(BodyId))
+    {
+        const int32 Index = UE_PTRDIFF_TO_INT32(Body - Snapshot.Bodies.GetData());
+        return BodyScores.IsValidIndex(Index) ? BodyScores[Index] : -1.f;
+    }
+    return -1.f;
+}
+
+FVector UAzureKinectSkeletonReceiverComponent::ComputeLookTargetFromKinectHead(
+    const FVector& HeadPosMeters_Kinect,
+    const FTransform& KinectToWorld,
+    const FTransform& CameraWorld,
+    const FVector& AvatarHeadWorld,
+    float AimDistance) const
+{
+    return AzureLook::ComputeLookTargetFromKinectHead(
+        HeadPosMeters_Kinect, KinectToWorld, CameraWorld, AvatarHeadWorld, AimDistance);
+}
+
+bool UAzureKinectSkeletonReceiverComponent::FindNearestBodyToPoint(const FVector& WorldPoint, int32& OutBodyId, float& OutDistance) const
+{
+    return AzureQuery::FindNearestBody(BodySpatialIndex, WorldPoint, OutBodyId, OutDistance);
+}
+
+bool UAzureKinectSkeletonReceiverComponent::FindNearestJointToPoint(const FVector& WorldPoint, EAzureKinectJoint Joint, int32& OutBodyId, FVector& OutJointPosition, float& OutDistance) const
+{
+    return AzureQuery::FindNearestJoint(BodySpatialIndex, WorldPoint, Joint, OutBodyId, OutJointPosition, OutDistance);
+}
+
+bool UAzureKinectSkeletonReceiverComponent::FindNearestHandToPoint(const FVector& WorldPoint, int32& OutBodyId, EAzureKinectJoint& OutHand, FVector& OutHandPosition, float& OutDistance) const
+{
+    return AzureQuery::FindNearestHand(BodySpatialIndex, WorldPoint, OutBodyId, OutHand, OutHandPosition, OutDistance);
+}
+
+int32 UAzureKinectSkeletonReceiverComponent::GetBodiesInBox(const FBox& WorldBox, TArray<int32>& OutBodyIds, bool bFullyInside) const
+{
+    return BodySpatialIndex.FindBodiesInBox(WorldBox, OutBodyIds, bFullyInside);
+}
+
+bool UAzureKinectSkeletonReceiverComponent::GetBodyWorldBounds(int32 BodyId, FBox& OutBounds) const
+{
+    return BodySpatialIndex.GetBodyBounds(BodyId, OutBounds);
+}
+
+void UAzureKinectSkeletonReceiverComponent::SetActiveBody(int32 NewId)
+{
+    if (ActiveBodyId == NewId) return;
+    const int32 Old = ActiveBodyId;
+    ActiveBodyId = NewId;
+    bHasActive = (ActiveBodyId >= 0);
+    OnActiveBodyChanged.Broadcast(Old, ActiveBodyId);
+}
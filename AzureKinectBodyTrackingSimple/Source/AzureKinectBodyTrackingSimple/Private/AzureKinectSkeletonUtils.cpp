@@ -1,5 +1,6 @@
 #include "AzureKinectSkeletonUtils.h"
 #include "AzureKinectBodyTrackingComponent.h" // for FBodyJointData / EAzureKinectJoint
+#include "AzureBodyTrackingStats.h"
 
 namespace AzureSkel
 {
@@ -23,11 +24,64 @@ namespace AzureSkel
         return R * Qk * R.Inverse();
     }
 
+    int32 GetParentJoint(int32 JointId)
+    {
+        // Indexed by k4abt_joint_id_t, see the Body Tracking SDK joint hierarchy
+        static const int8 Parents[K4ABT_JOINT_COUNT] =
+        {
+            -1,                         // Pelvis
+            K4ABT_JOINT_PELVIS,         // SpineNaval
+            K4ABT_JOINT_SPINE_NAVEL,    // SpineChest
+            K4ABT_JOINT_SPINE_CHEST,    // Neck
+            K4ABT_JOINT_SPINE_CHEST,    // ClavicleLeft
+            K4ABT_JOINT_CLAVICLE_LEFT,  // ShoulderLeft
+            K4ABT_JOINT_SHOULDER_LEFT,  // ElbowLeft
+            K4ABT_JOINT_ELBOW_LEFT,     // WristLeft
+            K4ABT_JOINT_WRIST_LEFT,     // HandLeft
+            K4ABT_JOINT_HAND_LEFT,      // HandTipLeft
+            K4ABT_JOINT_WRIST_LEFT,     // ThumbLeft
+            K4ABT_JOINT_SPINE_CHEST,    // ClavicleRight
+            K4ABT_JOINT_CLAVICLE_RIGHT, // ShoulderRight
+            K4ABT_JOINT_SHOULDER_RIGHT, // ElbowRight
+            K4ABT_JOINT_ELBOW_RIGHT,    // WristRight
+            K4ABT_JOINT_WRIST_RIGHT,    // HandRight
+            K4ABT_JOINT_HAND_RIGHT,     // HandTipRight
+            K4ABT_JOINT_WRIST_RIGHT,    // ThumbRight
+            K4ABT_JOINT_PELVIS,         // HipLeft
+            K4ABT_JOINT_HIP_LEFT,       // KneeLeft
+            K4ABT_JOINT_KNEE_LEFT,      // AnkleLeft
+            K4ABT_JOINT_ANKLE_LEFT,     // FootLeft
+            K4ABT_JOINT_PELVIS,         // HipRight
+            K4ABT_JOINT_HIP_RIGHT,      // KneeRight
+            K4ABT_JOINT_KNEE_RIGHT,     // AnkleRight
+            K4ABT_JOINT_ANKLE_RIGHT,    // FootRight
+            K4ABT_JOINT_NECK,           // Head
+            K4ABT_JOINT_HEAD,           // Nose
+            K4ABT_JOINT_HEAD,           // EyeLeft
+            K4ABT_JOINT_HEAD,           // EarLeft
+            K4ABT_JOINT_HEAD,           // EyeRight
+            K4ABT_JOINT_HEAD            // EarRight
+        };
+        return (JointId >= 0 && JointId < K4ABT_JOINT_COUNT) ? Parents[JointId] : -1;
+    }
+
+    FVector JointToWorld(const k4a_float3_t& Pmm, const FTransform& AzureCameraTransform)
+    {
+        return AzureCameraTransform.TransformPosition(MmToUEcmAndRemap(Pmm));
+    }
+
+    FQuat JointOrientationToWorld(const k4a_quaternion_t& Q, const FTransform& AzureCameraTransform)
+    {
+        return AzureCameraTransform.GetRotation() * RemapOrientation(Q);
+    }
+
     void FillJointArrayFromSkeleton(
         const k4abt_skeleton_t& Skeleton,
         const FTransform&       AzureCameraTransform,
         TArray<FBodyJointData>& OutJoints)
     {
+        SCOPE_CYCLE_COUNTER(STAT_AzureBT_SkeletonFill);
+
         OutJoints.Reset();
         OutJoints.Reserve(K4ABT_JOINT_COUNT);
 
@@ -46,8 +100,7 @@ namespace AzureSkel
             const FVector LocalUnrealCm = MmToUEcmAndRemap(Src.position);
             Data.Position = AzureCameraTransform.TransformPosition(LocalUnrealCm);
 
-            const FQuat Qlocal = RemapOrientation(Src.orientation);
-            Data.Orientation   = AzureCameraTransform.GetRotation() * Qlocal;
+            Data.Orientation   = JointOrientationToWorld(Src.orientation, AzureCameraTransform);
 
             OutJoints.Add(Data);
         }
@@ -11,6 +11,21 @@ enum class EAzureKinectJoint : uint8;
 
 namespace AzureSkel
 {
+    /** Applies the same axis remap as the joints (UE.X = Kinect.Z, UE.Y = Kinect.X, UE.Z = Kinect.Y), no scaling. */
+    FORCEINLINE FVector RemapKinectAxes(const FVector& V)
+    {
+        return FVector(V.Z, V.X, V.Y);
+    }
+
+    /** Parent in the k4abt joint hierarchy, or -1 for the pelvis (root). */
+    int32 GetParentJoint(int32 JointId);
+
+    /** Azure camera-space joint position (mm) -> world (cm) through AzureCameraTransform. */
+    FVector JointToWorld(const k4a_float3_t& Pmm, const FTransform& AzureCameraTransform);
+
+    /** Azure camera-space joint orientation -> world through AzureCameraTransform. */
+    FQuat JointOrientationToWorld(const k4a_quaternion_t& Q, const FTransform& AzureCameraTransform);
+
     /** Fills OutJoints from a k4abt_skeleton_t using your existing mm->cm and axis remap. */
     void FillJointArrayFromSkeleton(
         const k4abt_skeleton_t& Skeleton,
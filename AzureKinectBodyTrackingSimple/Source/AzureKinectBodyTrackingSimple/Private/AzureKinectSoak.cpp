@@ -0,0 +1,370 @@
+#include "AzureKinectSoak.h"
+#include "AzureBodyTrackingStats.h"
+#include "AzureBodyTrackingWorker.h"
+#include "AzureCountingMalloc.h"
+#include "AzureFramePool.h"
+#include "AzureGestureAsset.h"
+#include "AzureKinectBodyTrackingComponent.h"
+#include "AzureKinectComponent.h"
+#include "AzureTakeFile.h"
+#include "AzureTakeRecorder.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/Paths.h"
+#include "RenderCommandFence.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+    constexpr int64 FramesPerSample = 30 * 60;          // one simulated minute
+    constexpr int64 WarmupFrames = FramesPerSample * 2; // one unbinned and one binned minute
+    constexpr int32 ResizePeriodMinutes = 3;            // binned for the second minute of each period
+    constexpr int32 SoakColorWidth = 1280;              // NV12 only comes at 720p
+    constexpr int32 SoakColorHeight = 720;
+
+    double ToMB(double Bytes)
+    {
+        return Bytes / (1024.0 * 1024.0);
+    }
+
+    /** Hand raised above the head, left and right, held or as a raise-and-lower sequence. */
+    void MakeGestures(TArray<UAzureGestureAsset*>& OutGestures)
+    {
+        for (const EAzureKinectJoint Hand : { EAzureKinectJoint::HandLeft, EAzureKinectJoint::HandRight })
+        {
+            for (const bool bSequence : { false, true })
+            {
+                UAzureGestureAsset* Gesture = NewObject<UAzureGestureAsset>(GetTransientPackage());
+                Gesture->GestureName = *FString::Printf(TEXT("Soak%s%s"), Hand == EAzureKinectJoint::HandLeft ? TEXT("Left") : TEXT("Right"), bSequence ? TEXT("RaiseLower") : TEXT("Raise"));
+
+                FAzureGesturePredicate Above;
+                Above.JointA = Hand;
+                Above.JointB = EAzureKinectJoint::Head;
+                Above.Axis = EAzureGestureAxis::Up;
+                Above.ThresholdCm = 10.f;
+
+                FAzureGestureStep& Raise = Gesture->Steps.AddDefaulted_GetRef();
+                Raise.Predicates.Add(Above);
+                Raise.HoldSeconds = bSequence ? 0.f : 0.3f;
+                if (bSequence)
+                {
+                    FAzureGesturePredicate Below = Above;
+                    Below.Comparison = EAzureGestureComparison::Less;
+                    Below.ThresholdCm = -20.f;
+                    Gesture->Steps.AddDefaulted_GetRef().Predicates.Add(Below);
+                }
+                OutGestures.Add(Gesture);
+            }
+        }
+    }
+
+    /** NV12 gradient, a different one per Index. */
+    void MakeNv12(int32 Index, TArray<uint8>& Out)
+    {
+        const int32 NumLuma = SoakColorWidth * SoakColorHeight;
+        Out.SetNumUninitialized(NumLuma + NumLuma / 2);
+        for (int32 p = 0; p < NumLuma; ++p)
+        {
+            Out[p] = (uint8)(16 + (p % SoakColorWidth + Index * 64) % 220);
+        }
+        for (int32 p = NumLuma; p < Out.Num(); p += 2)
+        {
+            Out[p] = (uint8)(64 + Index * 32);
+            Out[p + 1] = (uint8)(192 - Index * 32);
+        }
+    }
+
+    /** What a 2x2 binned depth mode delivers of the same scene: one pixel per 2x2 block. */
+    void Bin2x2(const TArray<uint16>& Depth, int32 Width, int32 Height, TArray<uint16>& Out)
+    {
+        const int32 BinnedW = Width / 2;
+        const int32 BinnedH = Height / 2;
+        Out.SetNumUninitialized(BinnedW * BinnedH);
+        for (int32 y = 0; y < BinnedH; ++y)
+        {
+            for (int32 x = 0; x < BinnedW; ++x)
+            {
+                Out[y * BinnedW + x] = Depth[(2 * y) * Width + 2 * x];
+            }
+        }
+    }
+
+    int32 CountLiveTransientTextures()
+    {
+        int32 Count = 0;
+        for (TObjectIterator<UTexture2D> It; It; ++It)
+        {
+            if (It->GetOuter() == GetTransientPackage())
+            {
+                ++Count;
+            }
+        }
+        return Count;
+    }
+}
+
+TSharedRef<FJsonObject> AzureSoak::Run(const FAzureSoakSettings& Settings, TArray<FString>& OutFailures)
+{
+    TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+    const int64 SoakFrames = FMath::Max<int64>(FramesPerSample * 3 * ResizePeriodMinutes, (int64)(Settings.Hours * 3600.0 * 30.0));
+
+    // Without a take given, the benchmark's frames are recorded into one
+    FString TakePath = Settings.TakePath;
+    const bool bTemporaryTake = TakePath.IsEmpty();
+    if (bTemporaryTake)
+    {
+        TakePath = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("AzureKinectSoak"), TEXT(".aktake"));
+        // Every frame has to reach the file, so the producer waits on the writer instead of dropping
+        TUniquePtr<FAzureTakeRecorder> Recorder = MakeUnique<FAzureTakeRecorder>();
+        if (!Recorder->Start(TakePath, false))
+        {
+            OutFailures.Add(FString::Printf(TEXT("Soak: can't write the take '%s'"), *TakePath));
+            return Json;
+        }
+        for (const FAzureFrameSnapshot& Frame : *Settings.Frames)
+        {
+            Recorder->SubmitFrame_AnyThread(Frame);
+        }
+        Recorder->Shutdown();
+    }
+
+    // Depth as the sensor sends it in both modes, color as NV12
+    const TArray<TArray<uint16>>& Depth = *Settings.Depth;
+    const int32 BinnedW = Settings.DepthWidth / 2;
+    const int32 BinnedH = Settings.DepthHeight / 2;
+    TArray<TArray<uint16>> BinnedDepth;
+    for (const TArray<uint16>& Frame : Depth)
+    {
+        Bin2x2(Frame, Settings.DepthWidth, Settings.DepthHeight, BinnedDepth.AddDefaulted_GetRef());
+    }
+    TArray<uint8> Nv12[2];
+    MakeNv12(0, Nv12[0]);
+    MakeNv12(1, Nv12[1]);
+
+    // Both components on an actor in a world of their own; nothing begins play, so no device is opened
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AzureKinectSoak"));
+    AActor* Owner = World->SpawnActor<AActor>();
+
+    UAzureKinectComponent* Camera = NewObject<UAzureKinectComponent>(Owner);
+    Camera->ColorFormat = EAzureKinectColorFormat::NV12;
+    Camera->bFilterDepth = true;
+    Camera->bAdaptiveCaptureRate = true; // binned staging is preallocated too
+    Camera->RegisterComponent();
+    Camera->StartFrameProcessing();
+
+    TArray<UAzureGestureAsset*> Gestures;
+    MakeGestures(Gestures);
+
+    UAzureKinectBodyTrackingComponent* Tracking = NewObject<UAzureKinectBodyTrackingComponent>(Owner);
+    Tracking->bLoopTake = true;
+    Tracking->bTakeStepEveryTick = true;
+    Tracking->ActivationGesture = Gestures[0];
+    Tracking->RegisterComponent();
+    Tracking->SetGestures(Gestures);
+
+    // The tracker's hand-off, fed from the same frames on a sensor clock that never loops
+    FAzureBodyTrackingWorker::FSettings WorkerSettings;
+    WorkerSettings.ExpectedMaxBodies = AzureTake::MaxBodies;
+    FAzureBodyTrackingWorker Worker(nullptr, nullptr, WorkerSettings);
+    FAzureFrameSnapshot WorkerInput;
+    FAzureFrameSnapshot GameSnapshot;
+    WorkerInput.Bodies.Reserve(AzureTake::MaxBodies);
+    GameSnapshot.Bodies.Reserve(AzureTake::MaxBodies);
+
+    if (!Tracking->PlayTake(TakePath))
+    {
+        OutFailures.Add(FString::Printf(TEXT("Soak: can't play the take '%s'"), *TakePath));
+    }
+    else
+    {
+        UE_LOG(LogAzureBodyTracking, Display, TEXT("BodyBT: soaking %.2f simulated hours (%lld frames)"),
+            SoakFrames / (3600.0 * 30.0), SoakFrames);
+
+        FAzureFramePool& Pool = FAzureFramePool::Get();
+        FRenderCommandFence FrameFence;
+        FAzureCountingMalloc Counter;
+        uint64 TrackingAllocs = 0;
+        uint64 CameraAllocs = 0;
+        int64 FrameSizedAllocs = 0;
+        int64 ResizeFrameSizedAllocs = 0;
+        int32 Resizes = 0;
+        uint64 MemoryStart = 0;
+        uint64 MemoryPeak = 0;
+        FAzureFramePool::FStats PoolStart;
+        int32 TexturesStart = 0;
+        int32 TexturesPeak = 0;
+        bool bWasBinned = false;
+        TArray<TSharedPtr<FJsonValue>> Timeline;
+        const double SoakStartSeconds = FPlatformTime::Seconds();
+
+        Counter.Install();
+        for (int64 f = 0; f < SoakFrames; ++f)
+        {
+            const int32 Minute = (int32)(f / FramesPerSample);
+            const bool bBinned = (Minute % ResizePeriodMinutes) == 1;
+            const bool bResize = bBinned != bWasBinned;
+            bWasBinned = bBinned;
+            Resizes += bResize ? 1 : 0;
+            Tracking->SetSelectionMode((EActiveSelectionMode)(Minute % 4));
+
+            const FAzureFrameSnapshot& Source = (*Settings.Frames)[f % Settings.Frames->Num()];
+            WorkerInput.Reset();
+            WorkerInput.DeviceTimestampUsec = (uint64)f * 33333;
+            WorkerInput.Bodies.Append(Source.Bodies);
+
+            const uint64 CallsStart = Counter.Calls;
+            const int64 FrameSizedStart = Counter.FrameSizedCalls.GetValue();
+
+            // Tracking: worker hand-off, then the component's frame from the take
+            k4abt_frame_t NoFrame = nullptr;
+            Worker.SubmitSnapshot(WorkerInput);
+            Worker.ConsumeLatest(NoFrame, GameSnapshot);
+            Tracking->TickComponent(1.f / 30.f, LEVELTICK_All, nullptr);
+            const uint64 CallsTracking = Counter.Calls;
+
+            // Camera: depth filter, conversion and upload, NV12 to the decoder and the newest result up.
+            // The engine allocates small render commands and decode tasks here.
+            const int32 DepthIndex = (int32)(f % Depth.Num());
+            if (bBinned)
+            {
+                Camera->ProcessDepthFrame(BinnedDepth[DepthIndex].GetData(), BinnedW, BinnedH);
+            }
+            else
+            {
+                Camera->ProcessDepthFrame(Depth[DepthIndex].GetData(), Settings.DepthWidth, Settings.DepthHeight);
+            }
+            const TArray<uint8>& Color = Nv12[f & 1];
+            Camera->ProcessColorFrame(Color.GetData(), Color.Num(), SoakColorWidth, SoakColorHeight, SoakColorWidth, (uint64)f * 33333);
+
+            const int64 FrameSized = Counter.FrameSizedCalls.GetValue() - FrameSizedStart;
+            if (f >= WarmupFrames)
+            {
+                TrackingAllocs += CallsTracking - CallsStart;
+                CameraAllocs += Counter.Calls - CallsTracking;
+                (bResize ? ResizeFrameSizedAllocs : FrameSizedAllocs) += FrameSized;
+            }
+
+            // Like the end of a game frame: the render thread has caught up with the previous one
+            FrameFence.Wait();
+            FrameFence.BeginFence();
+
+            if ((f + 1) % FramesPerSample == 0)
+            {
+                // Released textures have to be gone once collected
+                FlushRenderingCommands();
+                CollectGarbage(GARBAGE_OBJECT_FLAGS, true);
+
+                const int32 Textures = CountLiveTransientTextures();
+                const uint64 Memory = FPlatformMemory::GetStats().UsedPhysical;
+                const FAzureFramePool::FStats PoolStats = Pool.GetStats();
+                if (f + 1 == WarmupFrames)
+                {
+                    MemoryStart = Memory;
+                    PoolStart = PoolStats;
+                    TexturesStart = Textures;
+                }
+                MemoryPeak = FMath::Max(MemoryPeak, Memory);
+                if (f + 1 > WarmupFrames)
+                {
+                    TexturesPeak = FMath::Max(TexturesPeak, Textures);
+                }
+
+                TSharedRef<FJsonObject> Sample = MakeShared<FJsonObject>();
+                Sample->SetNumberField(TEXT("minute"), Minute + 1);
+                Sample->SetBoolField(TEXT("binned"), bBinned);
+                Sample->SetNumberField(TEXT("used_physical_mb"), ToMB(Memory));
+                Sample->SetNumberField(TEXT("pool_mb"), ToMB(PoolStats.BytesAllocated));
+                Sample->SetNumberField(TEXT("pool_misses"), (double)PoolStats.Misses);
+                Sample->SetNumberField(TEXT("live_textures"), Textures);
+                Sample->SetNumberField(TEXT("tracking_allocs"), (double)TrackingAllocs);
+                Sample->SetNumberField(TEXT("frame_sized_allocs"), (double)FrameSizedAllocs);
+                Timeline.Add(MakeShared<FJsonValueObject>(Sample));
+
+                if ((f + 1) % (FramesPerSample * 60) == 0)
+                {
+                    UE_LOG(LogAzureBodyTracking, Display, TEXT("  soak %5.1f h: %.1f MB used, pool %.1f MB, %d textures, %llu tracking allocs since warm-up"),
+                        (f + 1) / (3600.0 * 30.0), ToMB(Memory), ToMB(PoolStats.BytesAllocated), Textures, TrackingAllocs);
+                }
+            }
+        }
+        Counter.Uninstall();
+        FrameFence.Wait();
+
+        const bool bUploads = Camera->DepthTexture && Camera->DepthTexture->GetResource();
+        const uint64 MemoryEnd = FPlatformMemory::GetStats().UsedPhysical;
+        const FAzureFramePool::FStats PoolEnd = Pool.GetStats();
+        const double GrowthMB = ToMB((double)MemoryEnd - (double)MemoryStart);
+        const int64 PoolGrowth = PoolEnd.BytesAllocated - PoolStart.BytesAllocated;
+        const int64 MissesAfterWarmup = PoolEnd.Misses - PoolStart.Misses;
+        const int64 FramesAfterWarmup = SoakFrames - WarmupFrames;
+
+        Json->SetNumberField(TEXT("frames"), (double)SoakFrames);
+        Json->SetNumberField(TEXT("simulated_hours"), SoakFrames / (3600.0 * 30.0));
+        Json->SetNumberField(TEXT("wall_seconds"), FPlatformTime::Seconds() - SoakStartSeconds);
+        Json->SetNumberField(TEXT("resolution_changes"), Resizes);
+        Json->SetBoolField(TEXT("texture_uploads"), bUploads);
+        Json->SetNumberField(TEXT("tracking_allocs_after_warmup"), (double)TrackingAllocs);
+        Json->SetNumberField(TEXT("camera_allocs_per_frame_after_warmup"), (double)CameraAllocs / FramesAfterWarmup);
+        Json->SetNumberField(TEXT("frame_sized_allocs_after_warmup"), (double)FrameSizedAllocs);
+        Json->SetNumberField(TEXT("frame_sized_allocs_on_resolution_changes"), (double)ResizeFrameSizedAllocs);
+        Json->SetNumberField(TEXT("color_frames_dropped"), Camera->GetDroppedColorFrames());
+        Json->SetNumberField(TEXT("live_textures_after_warmup"), TexturesStart);
+        Json->SetNumberField(TEXT("live_textures_peak"), TexturesPeak);
+        Json->SetNumberField(TEXT("pool_mb"), ToMB(PoolEnd.BytesAllocated));
+        Json->SetNumberField(TEXT("pool_growth_bytes"), (double)PoolGrowth);
+        Json->SetNumberField(TEXT("pool_misses_after_warmup"), (double)MissesAfterWarmup);
+        Json->SetNumberField(TEXT("used_physical_mb_start"), ToMB(MemoryStart));
+        Json->SetNumberField(TEXT("used_physical_mb_end"), ToMB(MemoryEnd));
+        Json->SetNumberField(TEXT("used_physical_mb_peak"), ToMB(MemoryPeak));
+        Json->SetNumberField(TEXT("growth_mb"), GrowthMB);
+        Json->SetNumberField(TEXT("max_growth_mb"), Settings.MaxGrowthMB);
+        Json->SetArrayField(TEXT("timeline"), Timeline);
+
+        UE_LOG(LogAzureBodyTracking, Display, TEXT("  soak: %+.2f MB used, pool %+lld bytes (%lld misses), textures %d -> %d, %llu tracking allocs, %lld frame-sized, %.2f camera allocs/frame"),
+            GrowthMB, PoolGrowth, MissesAfterWarmup, TexturesStart, TexturesPeak, TrackingAllocs, FrameSizedAllocs, (double)CameraAllocs / FramesAfterWarmup);
+        if (!bUploads)
+        {
+            UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: soak textures have no render resource, uploads were skipped (add -AllowCommandletRendering)"));
+        }
+
+        const int32 FailuresBefore = OutFailures.Num();
+        if (TrackingAllocs > 0)
+        {
+            OutFailures.Add(FString::Printf(TEXT("Soak: take playback, worker hand-off, selection and gestures allocated %llu times after warm-up (expected none)"), TrackingAllocs));
+        }
+        if (FrameSizedAllocs > 0)
+        {
+            OutFailures.Add(FString::Printf(TEXT("Soak: %lld frame-sized allocations after warm-up outside resolution changes (expected none)"), FrameSizedAllocs));
+        }
+        if (TexturesPeak > TexturesStart)
+        {
+            OutFailures.Add(FString::Printf(TEXT("Soak: live textures grew from %d to %d over %d resolution changes"), TexturesStart, TexturesPeak, Resizes));
+        }
+        if (PoolGrowth > 0)
+        {
+            OutFailures.Add(FString::Printf(TEXT("Soak: frame pool grew by %lld bytes (%lld misses)"), PoolGrowth, MissesAfterWarmup));
+        }
+        if (GrowthMB > Settings.MaxGrowthMB)
+        {
+            OutFailures.Add(FString::Printf(TEXT("Soak: grew by %.2f MB (limit %.2f MB)"), GrowthMB, Settings.MaxGrowthMB));
+        }
+        Json->SetBoolField(TEXT("passed"), OutFailures.Num() == FailuresBefore);
+    }
+
+    Tracking->StopTake();
+    Camera->StopFrameProcessing();
+    World->DestroyWorld(false);
+
+    if (bTemporaryTake)
+    {
+        IFileManager::Get().Delete(*TakePath);
+    }
+    return Json;
+}
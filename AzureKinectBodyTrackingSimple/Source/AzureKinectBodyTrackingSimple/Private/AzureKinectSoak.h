@@ -0,0 +1,37 @@
+// AzureKinectSoak.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "AzureBodySnapshot.h"
+
+class FJsonObject;
+
+/** What the benchmark's soak run plays, for how long and how much it may grow. */
+struct FAzureSoakSettings
+{
+    double Hours = 1.0;
+    double MaxGrowthMB = 16.0;
+    FString TakePath;                                   // played by the tracking component; empty: Frames go to a temporary take
+    const TArray<FAzureFrameSnapshot>* Frames = nullptr;
+    const TArray<TArray<uint16>>* Depth = nullptr;      // mm, cycled; also played 2x2 binned
+    int32 DepthWidth = 0;
+    int32 DepthHeight = 0;
+};
+
+namespace AzureSoak
+{
+    /**
+     * Hours of 30 fps frames, faster than real time, through the components themselves: a
+     * UAzureKinectBodyTrackingComponent plays the take every tick (spatial index, selection in
+     * every mode, gestures), the frames also go through the tracking worker's hand-off, and a
+     * UAzureKinectComponent converts and uploads depth (filtered, switching between unbinned and
+     * binned every few minutes) and NV12 color through its decoder.
+     *
+     * After warm-up (two simulated minutes, one of them binned) the run adds to OutFailures when
+     *  - the tracking paths allocate at all,
+     *  - anything allocates a frame-sized block outside a resolution change,
+     *  - the frame pool or the number of live textures grows, or
+     *  - the process grows by more than MaxGrowthMB.
+     * Texture uploads need a render resource: with -nullrhi add -AllowCommandletRendering.
+     */
+    TSharedRef<FJsonObject> Run(const FAzureSoakSettings& Settings, TArray<FString>& OutFailures);
+}
@@ -0,0 +1,372 @@
+#include "AzureOcclusionMesh.h"
+#include "AzureBodyTrackingStats.h"
+#include "Async/ParallelFor.h"
+
+bool FAzureOcclusionMeshBuilder::Initialize(const k4a_calibration_t& Calibration, const FSettings& InSettings)
+{
+    return Initialize(
+        Calibration.depth_camera_calibration.resolution_width,
+        Calibration.depth_camera_calibration.resolution_height,
+        [&Calibration](float X, float Y, FVector3f& OutRay)
+        {
+            // Unproject at 1 m and divide back so the ray has Z == 1
+            k4a_float2_t P2;
+            P2.xy.x = X;
+            P2.xy.y = Y;
+
+            k4a_float3_t P3;
+            int Valid = 0;
+            if (k4a_calibration_2d_to_3d(&Calibration, &P2, 1000.f,
+                K4A_CALIBRATION_TYPE_DEPTH, K4A_CALIBRATION_TYPE_DEPTH, &P3, &Valid) != K4A_RESULT_SUCCEEDED || !Valid)
+            {
+                return false;
+            }
+            OutRay = FVector3f(P3.xyz.x, P3.xyz.y, P3.xyz.z) / 1000.f;
+            return true;
+        },
+        InSettings);
+}
+
+bool FAzureOcclusionMeshBuilder::Initialize(int32 InWidth, int32 InHeight, FUnprojectFunc Unproject, const FSettings& InSettings)
+{
+    Tiles.Reset();
+    Rays.Reset();
+    if (InWidth <= 1 || InHeight <= 1)
+    {
+        return false;
+    }
+
+    Settings = InSettings;
+    Settings.GridStep = FMath::Clamp(Settings.GridStep, 1, 16);
+    Settings.MinChangedSamples = FMath::Max(1, Settings.MinChangedSamples);
+
+    // Power-of-two cells per tile so the quadtree splits evenly
+    const int32 Cells = FMath::Clamp(Settings.TileSize / Settings.GridStep, 2, 128);
+    CellsPerTile = (int32)FMath::RoundUpToPowerOfTwo((uint32)Cells);
+    Settings.TileSize = CellsPerTile * Settings.GridStep;
+
+    Width = InWidth;
+    Height = InHeight;
+    GridWidth = (Width - 1) / Settings.GridStep + 1;
+    GridHeight = (Height - 1) / Settings.GridStep + 1;
+
+    Rays.SetNumZeroed(GridWidth * GridHeight);
+    for (int32 gy = 0; gy < GridHeight; ++gy)
+    {
+        for (int32 gx = 0; gx < GridWidth; ++gx)
+        {
+            FVector3f Ray;
+            if (Unproject((float)(gx * Settings.GridStep), (float)(gy * Settings.GridStep), Ray))
+            {
+                Rays[gy * GridWidth + gx] = Ray;
+            }
+        }
+    }
+
+    const int32 TilesX = FMath::Max(1, FMath::DivideAndRoundUp(GridWidth - 1, CellsPerTile));
+    const int32 TilesY = FMath::Max(1, FMath::DivideAndRoundUp(GridHeight - 1, CellsPerTile));
+    Tiles.SetNum(TilesX * TilesY);
+    for (int32 ty = 0; ty < TilesY; ++ty)
+    {
+        for (int32 tx = 0; tx < TilesX; ++tx)
+        {
+            FTileState& Tile = Tiles[ty * TilesX + tx];
+            Tile.GridX0 = tx * CellsPerTile;
+            Tile.GridY0 = ty * CellsPerTile;
+        }
+    }
+    return true;
+}
+
+void FAzureOcclusionMeshBuilder::Reset()
+{
+    for (FTileState& Tile : Tiles)
+    {
+        Tile.bBuilt = false;
+    }
+}
+
+int32 FAzureOcclusionMeshBuilder::GetTriangleCount() const
+{
+    int32 Count = 0;
+    for (const FTileState& Tile : Tiles)
+    {
+        Count += Tile.Mesh.Triangles.Num() / 3;
+    }
+    return Count;
+}
+
+int32 FAzureOcclusionMeshBuilder::Update(const uint16* Depth, int32 InWidth, int32 InHeight, TArray<int32>& OutChangedTiles)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_OcclusionMesh);
+
+    OutChangedTiles.Reset();
+    if (!Depth || InWidth != Width || InHeight != Height || Tiles.Num() == 0)
+    {
+        return 0;
+    }
+
+    const int32 Side = CellsPerTile + 1;
+    const int32 Step = Settings.GridStep;
+    ParallelFor(Tiles.Num(), [this, Depth, Side, Step](int32 Index)
+    {
+        FTileState& Tile = Tiles[Index];
+
+        // Tiles share their border samples with the neighbours; outside the grid reads as no depth
+        Tile.Samples.SetNumUninitialized(Side * Side, false);
+        for (int32 ly = 0; ly < Side; ++ly)
+        {
+            const int32 gy = Tile.GridY0 + ly;
+            for (int32 lx = 0; lx < Side; ++lx)
+            {
+                const int32 gx = Tile.GridX0 + lx;
+                uint16 D = 0;
+                if (gx < GridWidth && gy < GridHeight && Rays[gy * GridWidth + gx].Z > 0.f)
+                {
+                    D = Depth[gy * Step * Width + gx * Step];
+                }
+                Tile.Samples[ly * Side + lx] = D;
+            }
+        }
+
+        Tile.bChanged = NeedsRebuild(Tile);
+        if (Tile.bChanged)
+        {
+            BuildTile(Tile);
+        }
+    });
+
+    for (int32 i = 0; i < Tiles.Num(); ++i)
+    {
+        if (Tiles[i].bChanged)
+        {
+            OutChangedTiles.Add(i);
+        }
+    }
+    return OutChangedTiles.Num();
+}
+
+bool FAzureOcclusionMeshBuilder::NeedsRebuild(const FTileState& Tile) const
+{
+    if (!Tile.bBuilt)
+    {
+        return true;
+    }
+
+    // Dropouts come and go every frame; only a large share of them counts as a change
+    int32 Moved = 0;
+    int32 Flipped = 0;
+    for (int32 i = 0; i < Tile.Samples.Num(); ++i)
+    {
+        const int32 Old = Tile.BuiltDepth[i];
+        const int32 New = Tile.Samples[i];
+        if (Old != 0 && New != 0)
+        {
+            if (FMath::Abs(New - Old) > Settings.ChangeThresholdMm && ++Moved >= Settings.MinChangedSamples)
+            {
+                return true;
+            }
+        }
+        else if (Old != New)
+        {
+            ++Flipped;
+        }
+    }
+    return Flipped > Tile.Samples.Num() / 10;
+}
+
+void FAzureOcclusionMeshBuilder::BuildTile(FTileState& Tile) const
+{
+    const int32 Side = CellsPerTile + 1;
+
+    Tile.bBuilt = true;
+    Tile.BuiltDepth = Tile.Samples;
+    Tile.Mesh.Vertices.Reset();
+    Tile.Mesh.Triangles.Reset();
+    Tile.Leaves.Reset();
+    Tile.VertexIndex.Init(INDEX_NONE, Side * Side);
+    Tile.Used.Init(0, Side * Side);
+
+    Subdivide(Tile, 0, 0, CellsPerTile);
+
+    for (const FNode& Leaf : Tile.Leaves)
+    {
+        Tile.Used[Leaf.Y * Side + Leaf.X] = 1;
+        Tile.Used[Leaf.Y * Side + Leaf.X + Leaf.Size] = 1;
+        Tile.Used[(Leaf.Y + Leaf.Size) * Side + Leaf.X] = 1;
+        Tile.Used[(Leaf.Y + Leaf.Size) * Side + Leaf.X + Leaf.Size] = 1;
+    }
+
+    for (const FNode& Leaf : Tile.Leaves)
+    {
+        if (Leaf.Size == 1)
+        {
+            EmitCell(Tile, Leaf.X, Leaf.Y);
+        }
+        else
+        {
+            EmitFan(Tile, Leaf);
+        }
+    }
+}
+
+void FAzureOcclusionMeshBuilder::Subdivide(FTileState& Tile, int32 X0, int32 Y0, int32 Size) const
+{
+    // Last vertex inside the image; tiles on the right/bottom edge are partly empty
+    const int32 LastX = GridWidth - 1 - Tile.GridX0;
+    const int32 LastY = GridHeight - 1 - Tile.GridY0;
+    if (X0 >= LastX || Y0 >= LastY)
+    {
+        return;
+    }
+
+    if (Size == 1 || (X0 + Size <= LastX && Y0 + Size <= LastY && IsPlanar(Tile, X0, Y0, Size)))
+    {
+        Tile.Leaves.Add({ X0, Y0, Size });
+        return;
+    }
+
+    const int32 Half = Size / 2;
+    Subdivide(Tile, X0, Y0, Half);
+    Subdivide(Tile, X0 + Half, Y0, Half);
+    Subdivide(Tile, X0, Y0 + Half, Half);
+    Subdivide(Tile, X0 + Half, Y0 + Half, Half);
+}
+
+bool FAzureOcclusionMeshBuilder::IsPlanar(const FTileState& Tile, int32 X0, int32 Y0, int32 Size) const
+{
+    const int32 Side = CellsPerTile + 1;
+    const uint16* S = Tile.Samples.GetData();
+
+    const uint16 D00 = S[Y0 * Side + X0];
+    const uint16 D10 = S[Y0 * Side + X0 + Size];
+    const uint16 D01 = S[(Y0 + Size) * Side + X0];
+    const uint16 D11 = S[(Y0 + Size) * Side + X0 + Size];
+    if (!D00 || !D10 || !D01 || !D11)
+    {
+        return false;
+    }
+
+    // On a plane, 1/depth is affine in pixel coordinates, so interpolating it between
+    // the corners predicts every sample inside
+    const float I00 = 1.f / D00;
+    const float I10 = 1.f / D10;
+    const float I01 = 1.f / D01;
+    const float I11 = 1.f / D11;
+    const float InvSize = 1.f / Size;
+
+    for (int32 j = 0; j <= Size; ++j)
+    {
+        const float V = j * InvSize;
+        const float Left = FMath::Lerp(I00, I01, V);
+        const float Right = FMath::Lerp(I10, I11, V);
+        const uint16* Row = S + (Y0 + j) * Side + X0;
+
+        for (int32 i = 0; i <= Size; ++i)
+        {
+            const float D = Row[i];
+            if (D == 0.f)
+            {
+                return false;
+            }
+
+            const float Predicted = 1.f / FMath::Lerp(Left, Right, i * InvSize);
+            if (FMath::Abs(D - Predicted) > Settings.PlanarToleranceMm + Settings.PlanarToleranceRatio * D)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool FAzureOcclusionMeshBuilder::SameSurface(int32 A, int32 B) const
+{
+    return FMath::Abs(A - B) <= Settings.MaxEdgeJumpMm + Settings.MaxEdgeJumpRatio * FMath::Min(A, B);
+}
+
+int32 FAzureOcclusionMeshBuilder::GetVertex(FTileState& Tile, int32 LocalX, int32 LocalY) const
+{
+    const int32 Local = LocalY * (CellsPerTile + 1) + LocalX;
+    int32& Index = Tile.VertexIndex[Local];
+    if (Index == INDEX_NONE)
+    {
+        const FVector3f& Ray = Rays[(Tile.GridY0 + LocalY) * GridWidth + Tile.GridX0 + LocalX];
+        const FVector3f P = Ray * (float)Tile.Samples[Local];
+        Index = Tile.Mesh.Vertices.Add(FVector(P.Z, P.X, P.Y) * 0.1); // mm -> cm, joint axes
+    }
+    return Index;
+}
+
+void FAzureOcclusionMeshBuilder::EmitCell(FTileState& Tile, int32 X0, int32 Y0) const
+{
+    const int32 Side = CellsPerTile + 1;
+    const FIntPoint A(X0, Y0);
+    const FIntPoint B(X0 + 1, Y0);
+    const FIntPoint C(X0, Y0 + 1);
+    const FIntPoint D(X0 + 1, Y0 + 1);
+
+    auto Depth = [&Tile, Side](const FIntPoint& P) -> int32 { return Tile.Samples[P.Y * Side + P.X]; };
+
+    // P, Q, R counter-clockwise in the image; after the axis remap the sensor sees them
+    // the other way round, so they're emitted reversed
+    auto Triangle = [&](const FIntPoint& P, const FIntPoint& Q, const FIntPoint& R)
+    {
+        const int32 Dp = Depth(P);
+        const int32 Dq = Depth(Q);
+        const int32 Dr = Depth(R);
+        if (!Dp || !Dq || !Dr || !SameSurface(Dp, Dq) || !SameSurface(Dq, Dr) || !SameSurface(Dp, Dr))
+        {
+            return; // hole or silhouette edge
+        }
+        Tile.Mesh.Triangles.Add(GetVertex(Tile, P.X, P.Y));
+        Tile.Mesh.Triangles.Add(GetVertex(Tile, R.X, R.Y));
+        Tile.Mesh.Triangles.Add(GetVertex(Tile, Q.X, Q.Y));
+    };
+
+    // Split along the diagonal that keeps a triangle when one corner is missing
+    if (Depth(B) && Depth(C))
+    {
+        Triangle(A, B, C);
+        Triangle(B, D, C);
+    }
+    else
+    {
+        Triangle(A, B, D);
+        Triangle(A, D, C);
+    }
+}
+
+void FAzureOcclusionMeshBuilder::EmitFan(FTileState& Tile, const FNode& Leaf) const
+{
+    const int32 Side = CellsPerTile + 1;
+    const int32 X0 = Leaf.X;
+    const int32 Y0 = Leaf.Y;
+    const int32 S = Leaf.Size;
+
+    // Every boundary vertex a neighbour uses, so there are no T-junction cracks. Along the
+    // tile border all of them: the neighbouring tile is built on its own.
+    TArray<FIntPoint, TInlineAllocator<512>> Ring;
+    auto Visit = [&](int32 X, int32 Y)
+    {
+        if (Tile.Used[Y * Side + X] || X == 0 || Y == 0 || X == CellsPerTile || Y == CellsPerTile)
+        {
+            Ring.Emplace(X, Y);
+        }
+    };
+    for (int32 i = 0; i < S; ++i) Visit(X0 + i, Y0);          // top, left to right
+    for (int32 i = 0; i < S; ++i) Visit(X0 + S, Y0 + i);      // right, downwards
+    for (int32 i = S; i > 0; --i) Visit(X0 + i, Y0 + S);      // bottom, right to left
+    for (int32 i = S; i > 0; --i) Visit(X0, Y0 + i);          // left, upwards
+
+    // Leaves larger than one cell are fully valid, so the centre sample exists
+    const int32 Center = GetVertex(Tile, X0 + S / 2, Y0 + S / 2);
+    for (int32 k = 0; k < Ring.Num(); ++k)
+    {
+        const FIntPoint& P = Ring[k];
+        const FIntPoint& Q = Ring[(k + 1) % Ring.Num()];
+        Tile.Mesh.Triangles.Add(Center);
+        Tile.Mesh.Triangles.Add(GetVertex(Tile, Q.X, Q.Y));
+        Tile.Mesh.Triangles.Add(GetVertex(Tile, P.X, P.Y));
+    }
+}
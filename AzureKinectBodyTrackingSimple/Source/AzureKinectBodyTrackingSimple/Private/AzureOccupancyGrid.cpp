@@ -0,0 +1,323 @@
+#include "AzureOccupancyGrid.h"
+#include "AzureDepthRays.h"
+#include "AzureBodyTrackingStats.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr float PruneBelow = 0.02f;
+    constexpr double PruneIntervalSeconds = 1.0;
+
+    /** Sorted keys -> (key, count) runs. */
+    void CountRuns(const TArray<uint32>& SortedKeys, TArray<TPair<uint32, int32>>& OutRuns)
+    {
+        OutRuns.Reset();
+        for (int32 i = 0; i < SortedKeys.Num();)
+        {
+            int32 j = i + 1;
+            while (j < SortedKeys.Num() && SortedKeys[j] == SortedKeys[i]) ++j;
+            OutRuns.Emplace(SortedKeys[i], j - i);
+            i = j;
+        }
+    }
+}
+
+FAzureOccupancyGrid::FAzureOccupancyGrid()
+{
+    Configure(FSettings());
+}
+
+void FAzureOccupancyGrid::Configure(const FSettings& InSettings)
+{
+    const FSettings Old = Settings;
+    Settings = InSettings;
+    Settings.VoxelSizeCm = FMath::Max(1.f, Settings.VoxelSizeCm);
+    Settings.HalfLifeSeconds = FMath::Max(0.01f, Settings.HalfLifeSeconds);
+    Settings.HitGain = FMath::Clamp(Settings.HitGain, 0.01f, 1.f);
+    Settings.MinPointsPerVoxel = FMath::Max(1, Settings.MinPointsPerVoxel);
+    Settings.BackgroundSeconds = FMath::Max(0.f, Settings.BackgroundSeconds);
+
+    // Keys hold 10 bits per axis
+    const FVector Size = Settings.Volume.IsValid ? Settings.Volume.GetSize() : FVector::ZeroVector;
+    const FIntVector NewDims(
+        FMath::Clamp(FMath::CeilToInt(Size.X / Settings.VoxelSizeCm), 0, 1024),
+        FMath::Clamp(FMath::CeilToInt(Size.Y / Settings.VoxelSizeCm), 0, 1024),
+        FMath::Clamp(FMath::CeilToInt(Size.Z / Settings.VoxelSizeCm), 0, 1024));
+
+    if (NewDims != Dims || Old.VoxelSizeCm != Settings.VoxelSizeCm || !(Old.Volume == Settings.Volume))
+    {
+        Dims = NewDims;
+        Reset();
+    }
+}
+
+void FAzureOccupancyGrid::Reset()
+{
+    for (TMap<uint32, FVoxel>& Shard : Shards)
+    {
+        Shard.Reset();
+    }
+    OccupiedKeys.Reset();
+    BackgroundKeys.Reset();
+    Heatmap.Init(0, Dims.X * Dims.Y);
+    LastPruneSeconds = 0.0;
+}
+
+int32 FAzureOccupancyGrid::NumVoxels() const
+{
+    int32 Count = 0;
+    for (const TMap<uint32, FVoxel>& Shard : Shards)
+    {
+        Count += Shard.Num();
+    }
+    return Count;
+}
+
+float FAzureOccupancyGrid::Decayed(const FVoxel& Voxel, double NowSeconds) const
+{
+    const double Age = FMath::Max(0.0, NowSeconds - Voxel.Seconds);
+    return Voxel.Value * (float)FMath::Exp2(-Age / Settings.HalfLifeSeconds);
+}
+
+float FAzureOccupancyGrid::BackgroundAt(const FVoxel& Voxel, double NowSeconds) const
+{
+    if (Settings.BackgroundSeconds <= 0.f)
+    {
+        return 0.f;
+    }
+
+    // Since the last hit the voxel stayed occupied until its value decayed below the
+    // threshold, then it was free: fold both spans into the exponential average
+    const double Age = FMath::Max(0.0, NowSeconds - Voxel.Seconds);
+    const double OccupiedFor = Voxel.Value > Settings.OccupiedThreshold
+        ? FMath::Min(Age, Settings.HalfLifeSeconds * FMath::Log2((double)Voxel.Value / Settings.OccupiedThreshold))
+        : 0.0;
+    const double Rate = 1.0 / Settings.BackgroundSeconds;
+    const double Keep = FMath::Exp(-Rate * Age);
+    return (float)(Voxel.Background * Keep + FMath::Exp(-Rate * (Age - OccupiedFor)) - Keep);
+}
+
+void FAzureOccupancyGrid::Integrate(const uint16* Depth, int32 Width, int32 Height, const FAzureDepthRayTable& Rays,
+                                    const FTransform& SensorToWorld, double NowSeconds)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureBT_Occupancy);
+
+    if (!Depth || Width != Rays.Width || Height != Rays.Height || Dims.X * Dims.Y * Dims.Z == 0)
+    {
+        return;
+    }
+
+    // 1) Bands of the ray table (rows of the depth image) -> voxel keys with point counts
+    const int32 NumRays = Rays.Rays.Num();
+    const FVector VolumeMin = Settings.Volume.Min;
+    const double InvVoxel = 1.0 / Settings.VoxelSizeCm;
+
+    ParallelFor(NumBands, [&](int32 Band)
+    {
+        TArray<uint32>& Keys = BandKeys[Band];
+        Keys.Reset();
+
+        const int32 Begin = (int32)((int64)NumRays * Band / NumBands);
+        const int32 End = (int32)((int64)NumRays * (Band + 1) / NumBands);
+        for (int32 i = Begin; i < End; ++i)
+        {
+            const uint16 D = Depth[Rays.PixelIndex[i]];
+            if (D == 0) continue; // invalid / no return
+
+            const FVector3f P = Rays.Rays[i] * (float)D;
+            const FVector World = SensorToWorld.TransformPosition(FVector(P.Z, P.X, P.Y) * 0.1);
+            const FVector Local = (World - VolumeMin) * InvVoxel;
+            if (Local.X < 0.0 || Local.Y < 0.0 || Local.Z < 0.0) continue;
+
+            const int32 X = (int32)Local.X;
+            const int32 Y = (int32)Local.Y;
+            const int32 Z = (int32)Local.Z;
+            if (X >= Dims.X || Y >= Dims.Y || Z >= Dims.Z) continue;
+
+            Keys.Add(PackKey(X, Y, Z));
+        }
+
+        Keys.Sort();
+        CountRuns(Keys, BandHits[Band]);
+    });
+
+    // 2) Each shard picks its keys from every band and updates its own map
+    const bool bPrune = NowSeconds - LastPruneSeconds > PruneIntervalSeconds;
+    if (bPrune)
+    {
+        LastPruneSeconds = NowSeconds;
+    }
+
+    ParallelFor(NumShards, [&](int32 ShardIndex)
+    {
+        TArray<TPair<uint32, int32>>& Hits = ShardHits[ShardIndex];
+        Hits.Reset();
+        for (const TArray<TPair<uint32, int32>>& Band : BandHits)
+        {
+            for (const TPair<uint32, int32>& Hit : Band)
+            {
+                if (ShardOf(Hit.Key) == ShardIndex)
+                {
+                    Hits.Add(Hit);
+                }
+            }
+        }
+        Hits.Sort([](const TPair<uint32, int32>& A, const TPair<uint32, int32>& B) { return A.Key < B.Key; });
+
+        TMap<uint32, FVoxel>& Shard = Shards[ShardIndex];
+        for (int32 i = 0; i < Hits.Num();)
+        {
+            // A voxel on a band boundary got points from two bands
+            const uint32 Key = Hits[i].Key;
+            int32 Count = 0;
+            for (; i < Hits.Num() && Hits[i].Key == Key; ++i)
+            {
+                Count += Hits[i].Value;
+            }
+            if (Count < Settings.MinPointsPerVoxel)
+            {
+                continue;
+            }
+
+            FVoxel& Voxel = Shard.FindOrAdd(Key);
+            const float Current = Decayed(Voxel, NowSeconds);
+            Voxel.Background = BackgroundAt(Voxel, NowSeconds);
+            Voxel.Value = Current + (1.f - Current) * Settings.HitGain;
+            Voxel.Seconds = NowSeconds;
+        }
+
+        if (bPrune)
+        {
+            for (auto It = Shard.CreateIterator(); It; ++It)
+            {
+                if (Decayed(It.Value(), NowSeconds) < PruneBelow)
+                {
+                    It.RemoveCurrent();
+                }
+            }
+        }
+    });
+
+    UpdateSummary(NowSeconds);
+    TRACE_COUNTER_SET(AzureBT_OccupiedVoxels, OccupiedKeys.Num());
+}
+
+void FAzureOccupancyGrid::UpdateSummary(double NowSeconds)
+{
+    OccupiedKeys.Reset();
+    BackgroundKeys.Reset();
+    Heatmap.Init(0, Dims.X * Dims.Y);
+
+    for (const TMap<uint32, FVoxel>& Shard : Shards)
+    {
+        for (const TPair<uint32, FVoxel>& Pair : Shard)
+        {
+            const float Value = Decayed(Pair.Value, NowSeconds);
+            const FIntVector V = UnpackKey(Pair.Key);
+
+            uint8& Heat = Heatmap[V.Y * Dims.X + V.X];
+            Heat = FMath::Max(Heat, (uint8)FMath::Clamp(FMath::RoundToInt(Value * 255.f), 0, 255));
+
+            if (Value >= Settings.OccupiedThreshold)
+            {
+                const bool bBackground = Settings.BackgroundSeconds > 0.f &&
+                    BackgroundAt(Pair.Value, NowSeconds) >= Settings.BackgroundThreshold;
+                (bBackground ? BackgroundKeys : OccupiedKeys).Add(Pair.Key);
+            }
+        }
+    }
+}
+
+FAzureOccupancyZoneResult FAzureOccupancyGrid::QueryZone(const FBox& WorldBox) const
+{
+    FAzureOccupancyZoneResult Result;
+    if (!WorldBox.IsValid || Dims.X * Dims.Y * Dims.Z == 0)
+    {
+        return Result;
+    }
+
+    // Voxel range of the box, inclusive
+    const FVector Lo = (WorldBox.Min - Settings.Volume.Min) / Settings.VoxelSizeCm;
+    const FVector Hi = (WorldBox.Max - Settings.Volume.Min) / Settings.VoxelSizeCm;
+    const FIntVector Min(
+        FMath::Max(0, FMath::FloorToInt(Lo.X)), FMath::Max(0, FMath::FloorToInt(Lo.Y)), FMath::Max(0, FMath::FloorToInt(Lo.Z)));
+    const FIntVector Max(
+        FMath::Min(Dims.X - 1, FMath::FloorToInt(Hi.X)), FMath::Min(Dims.Y - 1, FMath::FloorToInt(Hi.Y)), FMath::Min(Dims.Z - 1, FMath::FloorToInt(Hi.Z)));
+    if (Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z)
+    {
+        return Result;
+    }
+
+    const int32 W = Max.X - Min.X + 1;
+    const int32 H = Max.Y - Min.Y + 1;
+    Result.TotalVoxels = W * H * (Max.Z - Min.Z + 1);
+    Result.TotalColumns = W * H;
+
+    // Floor cells of the zone with something above them: 3 = only background, 1 = anything else
+    TArray<uint8>& Columns = ZoneColumns;
+    Columns.SetNumUninitialized(W * H, false);
+    FMemory::Memzero(Columns.GetData(), Columns.Num());
+    for (const uint32 Key : BackgroundKeys)
+    {
+        const FIntVector V = UnpackKey(Key);
+        if (V.X < Min.X || V.Y < Min.Y || V.Z < Min.Z || V.X > Max.X || V.Y > Max.Y || V.Z > Max.Z) continue;
+
+        ++Result.OccupiedVoxels;
+        ++Result.BackgroundVoxels;
+        uint8& Column = Columns[(V.Y - Min.Y) * W + (V.X - Min.X)];
+        Result.OccupiedColumns += Column ? 0 : 1;
+        Column = 3;
+    }
+    for (const uint32 Key : OccupiedKeys)
+    {
+        const FIntVector V = UnpackKey(Key);
+        if (V.X < Min.X || V.Y < Min.Y || V.Z < Min.Z || V.X > Max.X || V.Y > Max.Y || V.Z > Max.Z) continue;
+
+        ++Result.OccupiedVoxels;
+        uint8& Column = Columns[(V.Y - Min.Y) * W + (V.X - Min.X)];
+        Result.OccupiedColumns += Column ? 0 : 1;
+        Column = 1;
+    }
+
+    // People: 8-connected groups of cells with non-background voxels, a large group counted by its area
+    const float CellArea = Settings.VoxelSizeCm * Settings.VoxelSizeCm;
+    TArray<int32>& Stack = ZoneStack;
+    Stack.Reset();
+    for (int32 Start = 0; Start < Columns.Num(); ++Start)
+    {
+        if (Columns[Start] != 1) continue;
+
+        int32 Cells = 0;
+        Columns[Start] = 2;
+        Stack.Add(Start);
+        while (Stack.Num() > 0)
+        {
+            const int32 C = Stack.Pop(false);
+            ++Cells;
+            const int32 Cx = C % W;
+            const int32 Cy = C / W;
+            for (int32 Dy = -1; Dy <= 1; ++Dy)
+            {
+                for (int32 Dx = -1; Dx <= 1; ++Dx)
+                {
+                    const int32 Nx = Cx + Dx;
+                    const int32 Ny = Cy + Dy;
+                    if (Nx < 0 || Ny < 0 || Nx >= W || Ny >= H) continue;
+
+                    const int32 N = Ny * W + Nx;
+                    if (Columns[N] == 1)
+                    {
+                        Columns[N] = 2;
+                        Stack.Add(N);
+                    }
+                }
+            }
+        }
+
+        if (Cells >= Settings.MinPersonColumns)
+        {
+            Result.People += FMath::Max(1, FMath::RoundToInt(Cells * CellArea / Settings.PersonFootprintCm2));
+        }
+    }
+    return Result;
+}
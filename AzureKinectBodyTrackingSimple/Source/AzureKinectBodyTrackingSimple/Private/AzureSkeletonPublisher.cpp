@@ -0,0 +1,126 @@
+#include "AzureSkeletonPublisher.h"
+#include "AzureBodyTrackingStats.h"
+#include "Common/UdpSocketBuilder.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "IPAddress.h"
+
+FAzureSkeletonPublisher::FAzureSkeletonPublisher()
+    : ActiveId(-1)
+    , TrackedId(-1)
+{
+}
+
+FAzureSkeletonPublisher::~FAzureSkeletonPublisher()
+{
+    Close();
+}
+
+bool FAzureSkeletonPublisher::Open(const FString& Address, int32 Port, int32 KeyframeInterval)
+{
+    Close();
+
+    ISocketSubsystem* Sockets = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (!Sockets)
+    {
+        return false;
+    }
+
+    bool bValidIp = false;
+    Destination = Sockets->CreateInternetAddr();
+    Destination->SetIp(*Address, bValidIp);
+    Destination->SetPort(Port);
+    if (!bValidIp)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: invalid stream address '%s'"), *Address);
+        Destination.Reset();
+        return false;
+    }
+
+    Socket = FUdpSocketBuilder(TEXT("AzureKinectSkeletonStream"))
+        .AsNonBlocking()
+        .WithBroadcast()
+        .WithSendBufferSize(64 * 1024);
+    if (!Socket)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: could not create the stream socket"));
+        Destination.Reset();
+        return false;
+    }
+
+    Encoder.Configure(KeyframeInterval);
+    Encoder.Reset();
+    WindowStartSeconds = FPlatformTime::Seconds();
+    WindowBytes = 0;
+    return true;
+}
+
+void FAzureSkeletonPublisher::Close()
+{
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+    Destination.Reset();
+}
+
+void FAzureSkeletonPublisher::SetSelection(int32 ActiveBodyId, int32 TrackedBodyId, TArrayView<const TPair<int32, float>> BodyScores)
+{
+    ActiveId.Set(ActiveBodyId);
+    TrackedId.Set(TrackedBodyId);
+
+    FScopeLock Lock(&ScoresLock);
+    SelectionScores.Reset();
+    SelectionScores.Append(BodyScores.GetData(), BodyScores.Num());
+}
+
+void FAzureSkeletonPublisher::PushSnapshot_AnyThread(const FAzureFrameSnapshot& Snapshot, const FTransform& AzureCameraTransform)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AzureBT_StreamPublish);
+
+    if (!Socket)
+    {
+        return;
+    }
+
+    AzureStream::FHeader Header;
+    Header.SensorTimestampUsec = Snapshot.DeviceTimestampUsec;
+    Header.SendUtcTicks = FDateTime::UtcNow().GetTicks();
+    Header.ActiveBodyId = ActiveId.GetValue();
+    Header.TrackedBodyId = TrackedId.GetValue();
+    Header.CameraTransform = AzureCameraTransform;
+
+    // Scores are a game-thread frame behind the snapshot; bodies it hasn't scored yet send none
+    {
+        FScopeLock Lock(&ScoresLock);
+        WorkScores.Reset();
+        WorkScores.Append(SelectionScores);
+    }
+    PacketScores.Reset();
+    for (const FAzureTrackedBody& Body : Snapshot.Bodies)
+    {
+        const TPair<int32, float>* Found = WorkScores.FindByPredicate(
+            [&Body](const TPair<int32, float>& S) { return S.Key == Body.PersonId; });
+        PacketScores.Add(Found ? Found->Value : -1.f);
+    }
+
+    Encoder.Encode(Snapshot, Header, Packet, PacketScores);
+
+    // Non-blocking: a full send buffer drops the frame instead of stalling tracking
+    int32 Sent = 0;
+    if (Socket->SendTo(Packet.GetData(), Packet.Num(), Sent, *Destination))
+    {
+        PacketsSent.Increment();
+        WindowBytes += Sent;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - WindowStartSeconds >= 1.0)
+    {
+        BitsPerSecond.Set((int32)(WindowBytes * 8 / (Now - WindowStartSeconds)));
+        WindowStartSeconds = Now;
+        WindowBytes = 0;
+    }
+}
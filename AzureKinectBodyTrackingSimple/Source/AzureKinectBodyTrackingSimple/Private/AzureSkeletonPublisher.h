@@ -0,0 +1,55 @@
+// AzureSkeletonPublisher.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "AzureSkeletonStream.h"
+
+class FSocket;
+class FInternetAddr;
+
+/**
+ * Sends one skeleton datagram per tracker frame to a fixed address (unicast, or a
+ * broadcast/multicast address for several render nodes). Called from the tracking
+ * worker thread so packets leave as soon as the tracker is done.
+ */
+class FAzureSkeletonPublisher
+{
+public:
+    FAzureSkeletonPublisher();
+    ~FAzureSkeletonPublisher();
+
+    /** Creates the socket. Address is an IPv4 literal ("127.0.0.1" for loopback testing). */
+    bool Open(const FString& Address, int32 Port, int32 KeyframeInterval);
+    void Close();
+
+    /** Worker thread. */
+    void PushSnapshot_AnyThread(const FAzureFrameSnapshot& Snapshot, const FTransform& AzureCameraTransform);
+
+    /** Game thread: selection the receivers mirror, with the score behind it per PersonId. */
+    void SetSelection(int32 ActiveBodyId, int32 TrackedBodyId, TArrayView<const TPair<int32, float>> BodyScores);
+
+    /** Outgoing rate over the last full second. */
+    float GetKilobitsPerSecond() const { return BitsPerSecond.GetValue() / 1000.f; }
+    int32 GetPacketsSent() const { return PacketsSent.GetValue(); }
+
+private:
+    FSocket* Socket = nullptr;
+    TSharedPtr<FInternetAddr> Destination;
+
+    FThreadSafeCounter ActiveId;
+    FThreadSafeCounter TrackedId;
+
+    FCriticalSection ScoresLock;
+    TArray<TPair<int32, float>> SelectionScores;
+
+    // Worker-thread only
+    FAzureSkeletonEncoder Encoder;
+    TArray<uint8> Packet;
+    TArray<TPair<int32, float>> WorkScores;
+    TArray<float> PacketScores;              // per snapshot body
+    double WindowStartSeconds = 0.0;
+    int64 WindowBytes = 0;
+
+    FThreadSafeCounter BitsPerSecond;
+    FThreadSafeCounter PacketsSent;
+};
@@ -0,0 +1,424 @@
+#include "AzureSkeletonStream.h"
+
+namespace
+{
+    constexpr float PositionScale = 4.f;               // fixed-point units per mm
+    constexpr int32 MaxWideJointsInDelta = K4ABT_JOINT_COUNT / 2;
+    constexpr int32 HeaderBytes = 4 + 1 + 1 + 2 + 4 + 4 + 8 + 8 + 4 + 4 + 12 + 4 + 12;
+    constexpr uint8 NoScore = 255;                     // scores are 0..254 for 0..1
+
+    enum EBodyFlags : uint8
+    {
+        BodyFlag_Keyframe = 1 << 0,
+    };
+
+    // Raw little-endian writer/reader; both ends are x64
+    struct FPacketWriter
+    {
+        TArray<uint8>& Out;
+        explicit FPacketWriter(TArray<uint8>& InOut) : Out(InOut) {}
+
+        template <typename T>
+        void Write(T Value)
+        {
+            const int32 At = Out.AddUninitialized(sizeof(T));
+            FMemory::Memcpy(Out.GetData() + At, &Value, sizeof(T));
+        }
+    };
+
+    struct FPacketReader
+    {
+        const uint8* Data;
+        int32 Size;
+        int32 Offset = 0;
+        bool bOverflow = false;
+
+        FPacketReader(const uint8* InData, int32 InSize) : Data(InData), Size(InSize) {}
+
+        template <typename T>
+        T Read()
+        {
+            T Value{};
+            if (Offset + (int32)sizeof(T) > Size)
+            {
+                bOverflow = true;
+                return Value;
+            }
+            FMemory::Memcpy(&Value, Data + Offset, sizeof(T));
+            Offset += sizeof(T);
+            return Value;
+        }
+    };
+
+    // Smallest three: drop the largest component (recoverable from unit length), 2 bits say which,
+    // the other three take 10 bits each over [-1/sqrt(2), 1/sqrt(2)]
+    uint32 PackQuat(float W, float X, float Y, float Z)
+    {
+        float C[4] = { W, X, Y, Z };
+        const float Len = FMath::Sqrt(W * W + X * X + Y * Y + Z * Z);
+        const float InvLen = Len > KINDA_SMALL_NUMBER ? 1.f / Len : 0.f;
+
+        int32 Largest = 0;
+        for (int32 i = 0; i < 4; ++i)
+        {
+            C[i] *= InvLen;
+            if (FMath::Abs(C[i]) > FMath::Abs(C[Largest])) Largest = i;
+        }
+        if (InvLen == 0.f)
+        {
+            C[0] = 1.f; // identity
+        }
+
+        // q and -q are the same rotation: make the dropped component positive
+        const float Sign = C[Largest] < 0.f ? -1.f : 1.f;
+
+        uint32 Bits = (uint32)Largest;
+        int32 Shift = 2;
+        for (int32 i = 0; i < 4; ++i)
+        {
+            if (i == Largest) continue;
+            const float V = C[i] * Sign * UE_SQRT_2; // -> [-1, 1]
+            const uint32 Q = (uint32)FMath::Clamp(FMath::RoundToInt((V * 0.5f + 0.5f) * 1023.f), 0, 1023);
+            Bits |= Q << Shift;
+            Shift += 10;
+        }
+        return Bits;
+    }
+
+    void UnpackQuat(uint32 Bits, float& W, float& X, float& Y, float& Z)
+    {
+        const int32 Largest = (int32)(Bits & 3u);
+        float C[4];
+        float SumSq = 0.f;
+        int32 Shift = 2;
+        for (int32 i = 0; i < 4; ++i)
+        {
+            if (i == Largest) continue;
+            const float V = (((Bits >> Shift) & 1023u) / 1023.f * 2.f - 1.f) / UE_SQRT_2;
+            C[i] = V;
+            SumSq += V * V;
+            Shift += 10;
+        }
+        C[Largest] = FMath::Sqrt(FMath::Max(0.f, 1.f - SumSq));
+
+        W = C[0]; X = C[1]; Y = C[2]; Z = C[3];
+    }
+
+    FORCEINLINE int16 QuantizeMm(float Mm)
+    {
+        return (int16)FMath::Clamp(FMath::RoundToInt(Mm * PositionScale), -32768, 32767);
+    }
+
+    void WriteHeader(FPacketWriter& W, const AzureStream::FHeader& H, uint8 BodyCount)
+    {
+        W.Write<uint32>(AzureStream::Magic);
+        W.Write<uint8>(AzureStream::Version);
+        W.Write<uint8>(BodyCount);
+        W.Write<uint16>(0);
+        W.Write<uint32>(H.SessionId);
+        W.Write<uint32>(H.Sequence);
+        W.Write<uint64>(H.SensorTimestampUsec);
+        W.Write<int64>(H.SendUtcTicks);
+        W.Write<int32>(H.ActiveBodyId);
+        W.Write<int32>(H.TrackedBodyId);
+
+        const FVector3f Loc(H.CameraTransform.GetLocation());
+        const FQuat Rot = H.CameraTransform.GetRotation();
+        const FVector3f Scale(H.CameraTransform.GetScale3D());
+        W.Write<float>(Loc.X); W.Write<float>(Loc.Y); W.Write<float>(Loc.Z);
+        W.Write<uint32>(PackQuat(Rot.W, Rot.X, Rot.Y, Rot.Z));
+        W.Write<float>(Scale.X); W.Write<float>(Scale.Y); W.Write<float>(Scale.Z);
+    }
+}
+
+void FAzureSkeletonEncoder::Reset()
+{
+    Keyframes.Reset();
+    SessionId = GetTypeHash(FGuid::NewGuid()) | 1u; // never 0, which receivers start from
+    NextSequence = 1;
+}
+
+void FAzureSkeletonEncoder::Encode(const FAzureFrameSnapshot& Snapshot, AzureStream::FHeader& Header, TArray<uint8>& OutPacket,
+                                   TArrayView<const float> BodyScores)
+{
+    Header.SessionId = SessionId;
+    Header.Sequence = NextSequence++;
+    const int32 BodyCount = FMath::Min(Snapshot.Bodies.Num(), 255);
+
+    OutPacket.Reset();
+    FPacketWriter W(OutPacket);
+    WriteHeader(W, Header, (uint8)BodyCount);
+
+    for (int32 b = 0; b < BodyCount; ++b)
+    {
+        const FAzureTrackedBody& Body = Snapshot.Bodies[b];
+        const k4abt_skeleton_t& Skel = Body.Skeleton;
+
+        int16 Q[K4ABT_JOINT_COUNT][3];
+        uint64 Confidence = 0;
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            const k4a_float3_t& P = Skel.joints[J].position;
+            Q[J][0] = QuantizeMm(P.xyz.x);
+            Q[J][1] = QuantizeMm(P.xyz.y);
+            Q[J][2] = QuantizeMm(P.xyz.z);
+            Confidence |= (uint64)(Skel.joints[J].confidence_level & 3) << (J * 2);
+        }
+
+        // Keyframe if this person is new, the last one is too old, or too much has moved since
+        FKeyframe* Key = Keyframes.Find(Body.PersonId);
+        bool bKeyframe = !Key || (Header.Sequence - Key->Sequence) >= (uint32)KeyframeInterval;
+
+        int32 Delta[K4ABT_JOINT_COUNT][3];
+        uint32 WideMask = 0;
+        if (!bKeyframe)
+        {
+            int32 NumWide = 0;
+            for (int32 J = 0; J < K4ABT_JOINT_COUNT && !bKeyframe; ++J)
+            {
+                bool bWide = false;
+                for (int32 A = 0; A < 3; ++A)
+                {
+                    Delta[J][A] = (int32)Q[J][A] - (int32)Key->Q[J][A];
+                    bWide |= Delta[J][A] < -128 || Delta[J][A] > 127;
+                    bKeyframe |= Delta[J][A] < -32768 || Delta[J][A] > 32767;
+                }
+                if (bWide)
+                {
+                    WideMask |= 1u << J;
+                    ++NumWide;
+                }
+            }
+            bKeyframe |= NumWide > MaxWideJointsInDelta;
+        }
+
+        if (bKeyframe)
+        {
+            Key = &Keyframes.FindOrAdd(Body.PersonId);
+            Key->Sequence = Header.Sequence;
+            FMemory::Memcpy(Key->Q, Q, sizeof(Q));
+        }
+        Key->LastSeenSequence = Header.Sequence;
+
+        W.Write<int32>(Body.PersonId);
+        W.Write<uint8>(bKeyframe ? BodyFlag_Keyframe : 0);
+        W.Write<uint32>(Key->Sequence);
+        W.Write<uint64>(Confidence);
+
+        const float Score = BodyScores.IsValidIndex(b) ? BodyScores[b] : -1.f;
+        W.Write<uint8>(Score < 0.f ? NoScore : (uint8)FMath::RoundToInt(FMath::Min(Score, 1.f) * (NoScore - 1)));
+
+        if (bKeyframe)
+        {
+            for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+            {
+                W.Write<int16>(Q[J][0]); W.Write<int16>(Q[J][1]); W.Write<int16>(Q[J][2]);
+            }
+        }
+        else
+        {
+            W.Write<uint32>(WideMask);
+            for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+            {
+                if (WideMask & (1u << J))
+                {
+                    W.Write<int16>((int16)Delta[J][0]); W.Write<int16>((int16)Delta[J][1]); W.Write<int16>((int16)Delta[J][2]);
+                }
+                else
+                {
+                    W.Write<int8>((int8)Delta[J][0]); W.Write<int8>((int8)Delta[J][1]); W.Write<int8>((int8)Delta[J][2]);
+                }
+            }
+        }
+
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            const k4a_quaternion_t& R = Skel.joints[J].orientation;
+            W.Write<uint32>(PackQuat(R.wxyz.w, R.wxyz.x, R.wxyz.y, R.wxyz.z));
+        }
+    }
+
+    // People who left don't need their keyframes any more
+    for (auto It = Keyframes.CreateIterator(); It; ++It)
+    {
+        if (It->Value.LastSeenSequence != Header.Sequence)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FAzureSkeletonDecoder::Reset()
+{
+    Keyframes.Reset();
+    SessionId = 0;
+    LastSequence = 0;
+    LostPackets = 0;
+    UndecodableBodies = 0;
+}
+
+bool FAzureSkeletonDecoder::Decode(const uint8* Data, int32 Size, AzureStream::FHeader& OutHeader, FAzureFrameSnapshot& OutSnapshot,
+                                   TArray<float>* OutBodyScores)
+{
+    if (!Data || Size < HeaderBytes)
+    {
+        return false;
+    }
+
+    FPacketReader R(Data, Size);
+    if (R.Read<uint32>() != AzureStream::Magic || R.Read<uint8>() != AzureStream::Version)
+    {
+        return false;
+    }
+    const int32 BodyCount = R.Read<uint8>();
+    R.Read<uint16>();
+
+    AzureStream::FHeader H;
+    H.SessionId = R.Read<uint32>();
+    H.Sequence = R.Read<uint32>();
+    H.SensorTimestampUsec = R.Read<uint64>();
+    H.SendUtcTicks = R.Read<int64>();
+    H.ActiveBodyId = R.Read<int32>();
+    H.TrackedBodyId = R.Read<int32>();
+
+    FVector3f Loc, Scale;
+    Loc.X = R.Read<float>(); Loc.Y = R.Read<float>(); Loc.Z = R.Read<float>();
+    float QW, QX, QY, QZ;
+    UnpackQuat(R.Read<uint32>(), QW, QX, QY, QZ);
+    Scale.X = R.Read<float>(); Scale.Y = R.Read<float>(); Scale.Z = R.Read<float>();
+    H.CameraTransform = FTransform(FQuat(QX, QY, QZ, QW), FVector(Loc), FVector(Scale));
+
+    // A new session is a restarted (or different) sender: its keyframes and sequence start over.
+    // Within a session, late packets are useless for a live stream.
+    if (H.SessionId != SessionId)
+    {
+        SessionId = H.SessionId;
+        LastSequence = 0;
+        Keyframes.Reset();
+    }
+    else if (LastSequence != 0)
+    {
+        const int32 Step = (int32)(H.Sequence - LastSequence);
+        if (Step <= 0)
+        {
+            return false;
+        }
+        if (Step > 1)
+        {
+            LostPackets += Step - 1;
+        }
+    }
+
+    OutSnapshot.Reset();
+    OutSnapshot.DeviceTimestampUsec = H.SensorTimestampUsec;
+    OutSnapshot.Bodies.Reserve(BodyCount);
+    if (OutBodyScores)
+    {
+        OutBodyScores->Reset();
+    }
+
+    for (int32 b = 0; b < BodyCount && !R.bOverflow; ++b)
+    {
+        const int32 PersonId = R.Read<int32>();
+        const uint8 Flags = R.Read<uint8>();
+        const uint32 KeySequence = R.Read<uint32>();
+        const uint64 Confidence = R.Read<uint64>();
+        const uint8 Score = R.Read<uint8>();
+
+        int16 Q[K4ABT_JOINT_COUNT][3];
+        bool bDecodable = true;
+        if (Flags & BodyFlag_Keyframe)
+        {
+            for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+            {
+                Q[J][0] = R.Read<int16>(); Q[J][1] = R.Read<int16>(); Q[J][2] = R.Read<int16>();
+            }
+
+            FKeyframe& Key = Keyframes.FindOrAdd(PersonId);
+            Key.Sequence = KeySequence;
+            FMemory::Memcpy(Key.Q, Q, sizeof(Q));
+            Key.LastSeenSequence = H.Sequence;
+        }
+        else
+        {
+            // Still consume the payload when the keyframe is missing, to reach the next body
+            FKeyframe* Key = Keyframes.Find(PersonId);
+            bDecodable = Key && Key->Sequence == KeySequence;
+
+            const uint32 WideMask = R.Read<uint32>();
+            for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+            {
+                int32 D[3];
+                for (int32 A = 0; A < 3; ++A)
+                {
+                    D[A] = (WideMask & (1u << J)) ? (int32)R.Read<int16>() : (int32)R.Read<int8>();
+                }
+                if (bDecodable)
+                {
+                    for (int32 A = 0; A < 3; ++A)
+                    {
+                        Q[J][A] = (int16)((int32)Key->Q[J][A] + D[A]);
+                    }
+                }
+            }
+            if (bDecodable)
+            {
+                Key->LastSeenSequence = H.Sequence;
+            }
+        }
+
+        uint32 Rot[K4ABT_JOINT_COUNT];
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            Rot[J] = R.Read<uint32>();
+        }
+
+        if (!bDecodable)
+        {
+            ++UndecodableBodies;
+            continue;
+        }
+
+        if (OutBodyScores)
+        {
+            OutBodyScores->Add(Score == NoScore ? -1.f : Score / (float)(NoScore - 1));
+        }
+
+        FAzureTrackedBody& Body = OutSnapshot.Bodies.AddDefaulted_GetRef();
+        Body.BodyId = PersonId;
+        Body.PersonId = PersonId;
+        Body.FrameIndex = b;
+        for (int32 J = 0; J < K4ABT_JOINT_COUNT; ++J)
+        {
+            k4abt_joint_t& Joint = Body.Skeleton.joints[J];
+            Joint.position.xyz.x = Q[J][0] / PositionScale;
+            Joint.position.xyz.y = Q[J][1] / PositionScale;
+            Joint.position.xyz.z = Q[J][2] / PositionScale;
+            UnpackQuat(Rot[J], Joint.orientation.wxyz.w, Joint.orientation.wxyz.x, Joint.orientation.wxyz.y, Joint.orientation.wxyz.z);
+            Joint.confidence_level = (k4abt_joint_confidence_level_t)((Confidence >> (J * 2)) & 3);
+        }
+    }
+
+    if (R.bOverflow)
+    {
+        OutSnapshot.Reset();
+        if (OutBodyScores)
+        {
+            OutBodyScores->Reset();
+        }
+        return false;
+    }
+
+    // Forget people not heard of for ~10 s at 30 fps
+    for (auto It = Keyframes.CreateIterator(); It; ++It)
+    {
+        if (H.Sequence - It->Value.LastSeenSequence > 300)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    LastSequence = H.Sequence;
+    OutHeader = H;
+    return true;
+}
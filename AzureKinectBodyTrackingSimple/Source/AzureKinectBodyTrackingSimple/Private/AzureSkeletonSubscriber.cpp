@@ -0,0 +1,95 @@
+#include "AzureSkeletonSubscriber.h"
+#include "AzureBodyTrackingStats.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Common/UdpSocketReceiver.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+FAzureSkeletonSubscriber::~FAzureSkeletonSubscriber()
+{
+    Close();
+}
+
+bool FAzureSkeletonSubscriber::Open(int32 Port)
+{
+    Close();
+
+    Socket = FUdpSocketBuilder(TEXT("AzureKinectSkeletonReceive"))
+        .AsNonBlocking()
+        .AsReusable()
+        .BoundToPort(Port)
+        .WithReceiveBufferSize(256 * 1024);
+    if (!Socket)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: could not listen for skeletons on port %d"), Port);
+        return false;
+    }
+
+    Decoder.Reset();
+    WindowStartSeconds = FPlatformTime::Seconds();
+    WindowBytes = 0;
+
+    Receiver = new FUdpSocketReceiver(Socket, FTimespan::FromMilliseconds(5), TEXT("AzureKinectSkeletonReceiver"));
+    Receiver->OnDataReceived().BindRaw(this, &FAzureSkeletonSubscriber::OnDataReceived);
+    Receiver->Start();
+    return true;
+}
+
+void FAzureSkeletonSubscriber::Close()
+{
+    if (Receiver)
+    {
+        delete Receiver; // stops and joins the receive thread
+        Receiver = nullptr;
+    }
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+}
+
+void FAzureSkeletonSubscriber::OnDataReceived(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender)
+{
+    const int64 ReceiveUtcTicks = FDateTime::UtcNow().GetTicks();
+
+    WindowBytes += Data->Num();
+    const double Now = FPlatformTime::Seconds();
+    if (Now - WindowStartSeconds >= 1.0)
+    {
+        BitsPerSecond.Set((int32)(WindowBytes * 8 / (Now - WindowStartSeconds)));
+        WindowStartSeconds = Now;
+        WindowBytes = 0;
+    }
+
+    if (!Decoder.Decode(Data->GetData(), Data->Num(), WorkHeader, WorkSnapshot, &WorkScores))
+    {
+        return;
+    }
+    LostPackets.Set(Decoder.GetLostPackets());
+
+    FScopeLock Lock(&MailboxLock);
+    Swap(PendingHeader, WorkHeader);
+    Swap(PendingSnapshot, WorkSnapshot);
+    Swap(PendingScores, WorkScores);
+    PendingReceiveUtcTicks = ReceiveUtcTicks;
+    bPending = true;
+}
+
+bool FAzureSkeletonSubscriber::ConsumeLatest(AzureStream::FHeader& OutHeader, FAzureFrameSnapshot& OutSnapshot, TArray<float>& OutBodyScores,
+                                             int64& OutReceiveUtcTicks)
+{
+    FScopeLock Lock(&MailboxLock);
+    if (!bPending)
+    {
+        return false;
+    }
+
+    Swap(OutHeader, PendingHeader);
+    Swap(OutSnapshot, PendingSnapshot);
+    Swap(OutBodyScores, PendingScores);
+    OutReceiveUtcTicks = PendingReceiveUtcTicks;
+    bPending = false;
+    return true;
+}
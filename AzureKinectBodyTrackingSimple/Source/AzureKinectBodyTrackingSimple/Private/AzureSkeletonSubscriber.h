@@ -0,0 +1,58 @@
+// AzureSkeletonSubscriber.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/ArrayReader.h"
+#include "AzureSkeletonStream.h"
+
+class FSocket;
+class FUdpSocketReceiver;
+
+/**
+ * Listens for skeleton datagrams on a UDP port. Packets are decoded on the receive
+ * thread; the game thread takes the newest frame through a one-slot mailbox.
+ */
+class FAzureSkeletonSubscriber
+{
+public:
+    ~FAzureSkeletonSubscriber();
+
+    bool Open(int32 Port);
+    void Close();
+
+    /**
+     * Game thread. OutBodyScores has the sender's selection score per OutSnapshot body (-1 where
+     * unknown); OutReceiveUtcTicks is when the datagram arrived.
+     */
+    bool ConsumeLatest(AzureStream::FHeader& OutHeader, FAzureFrameSnapshot& OutSnapshot, TArray<float>& OutBodyScores,
+                       int64& OutReceiveUtcTicks);
+
+    /** Incoming rate over the last full second. */
+    float GetKilobitsPerSecond() const { return BitsPerSecond.GetValue() / 1000.f; }
+    int32 GetLostPackets() const { return LostPackets.GetValue(); }
+
+private:
+    void OnDataReceived(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender); // receive thread
+
+    FSocket* Socket = nullptr;
+    FUdpSocketReceiver* Receiver = nullptr;
+
+    // Receive-thread only
+    FAzureSkeletonDecoder Decoder;
+    AzureStream::FHeader WorkHeader;
+    FAzureFrameSnapshot WorkSnapshot;
+    TArray<float> WorkScores;
+    double WindowStartSeconds = 0.0;
+    int64 WindowBytes = 0;
+
+    FCriticalSection MailboxLock;
+    bool bPending = false;
+    AzureStream::FHeader PendingHeader;
+    FAzureFrameSnapshot PendingSnapshot;
+    TArray<float> PendingScores;
+    int64 PendingReceiveUtcTicks = 0;
+
+    FThreadSafeCounter BitsPerSecond;
+    FThreadSafeCounter LostPackets;
+};
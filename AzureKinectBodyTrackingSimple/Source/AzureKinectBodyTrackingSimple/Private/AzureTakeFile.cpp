@@ -0,0 +1,187 @@
+#include "AzureTakeFile.h"
+#include "AzureBodyTrackingStats.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+
+namespace AzureTake
+{
+    void MakeFrameRecord(const FAzureFrameSnapshot& Snapshot, FFrameRecord& OutRecord)
+    {
+        FMemory::Memzero(OutRecord);
+        OutRecord.TimestampUsec = Snapshot.DeviceTimestampUsec;
+        OutRecord.BodyCount = (uint32)FMath::Min(Snapshot.Bodies.Num(), MaxBodies);
+        for (uint32 b = 0; b < OutRecord.BodyCount; ++b)
+        {
+            const FAzureTrackedBody& Body = Snapshot.Bodies[b];
+            OutRecord.Bodies[b].BodyId = Body.BodyId;
+            OutRecord.Bodies[b].PersonId = Body.PersonId;
+            OutRecord.Bodies[b].Skeleton = Body.Skeleton;
+        }
+    }
+
+    void BuildTimeIndex(TArrayView<const uint64> Timestamps, uint32 BucketUsec, TArray<uint32>& OutIndex)
+    {
+        OutIndex.Reset();
+        if (Timestamps.Num() == 0 || BucketUsec == 0)
+        {
+            return;
+        }
+
+        const uint64 First = Timestamps[0];
+        const uint64 Span = Timestamps.Last() >= First ? Timestamps.Last() - First : 0;
+        const int32 NumBuckets = (int32)(Span / BucketUsec) + 1;
+        OutIndex.SetNumUninitialized(NumBuckets);
+
+        // Entry b: last frame with relative time <= b * BucketUsec
+        int32 Frame = 0;
+        for (int32 b = 0; b < NumBuckets; ++b)
+        {
+            const uint64 BucketStart = (uint64)b * BucketUsec;
+            while (Frame + 1 < Timestamps.Num() && Timestamps[Frame + 1] - First <= BucketStart)
+            {
+                ++Frame;
+            }
+            OutIndex[b] = (uint32)Frame;
+        }
+    }
+}
+
+FAzureTakeReader::~FAzureTakeReader()
+{
+    Close();
+}
+
+bool FAzureTakeReader::Open(const FString& Path)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const int64 Size = PlatformFile.FileSize(*Path);
+    if (Size < (int64)sizeof(AzureTake::FHeader))
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: can't open take '%s'"), *Path);
+        return false;
+    }
+
+    MappedFile = PlatformFile.OpenMapped(*Path);
+    if (MappedFile)
+    {
+        MappedRegion = MappedFile->MapRegion(0, Size);
+    }
+    if (MappedRegion)
+    {
+        Base = MappedRegion->GetMappedPtr();
+    }
+    else if (FFileHelper::LoadFileToArray(Loaded, *Path))
+    {
+        Base = Loaded.GetData();
+    }
+    if (!Base)
+    {
+        Close();
+        return false;
+    }
+
+    FMemory::Memcpy(&Header, Base, sizeof(Header));
+    if (Header.Magic != AzureTake::Magic || Header.Version != AzureTake::Version ||
+        Header.MaxBodies != AzureTake::MaxBodies || Header.FrameStride != sizeof(AzureTake::FFrameRecord))
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: '%s' is not a take this version can read"), *Path);
+        Close();
+        return false;
+    }
+
+    const int64 FramesInFile = (Size - (int64)sizeof(AzureTake::FHeader)) / Header.FrameStride;
+    const bool bFinalized = Header.IndexOffset != 0 && Header.FrameCount <= (uint64)FramesInFile &&
+        Header.IndexOffset + (uint64)Header.IndexCount * sizeof(uint32) <= (uint64)Size;
+
+    if (bFinalized)
+    {
+        FrameCount = (int32)Header.FrameCount;
+        TimeIndex.SetNumUninitialized(Header.IndexCount);
+        FMemory::Memcpy(TimeIndex.GetData(), Base + Header.IndexOffset, Header.IndexCount * sizeof(uint32));
+    }
+    else
+    {
+        // Recording never stopped cleanly: every whole record counts, index rebuilt here
+        UE_LOG(LogAzureBodyTracking, Warning, TEXT("BodyBT: take '%s' wasn't finalized, recovering %lld frames"), *Path, FramesInFile);
+        FrameCount = (int32)FramesInFile;
+        TArray<uint64> Timestamps;
+        Timestamps.SetNumUninitialized(FrameCount);
+        for (int32 i = 0; i < FrameCount; ++i)
+        {
+            Timestamps[i] = Frame(i).TimestampUsec;
+        }
+        Header.FirstTimestampUsec = FrameCount > 0 ? Timestamps[0] : 0;
+        AzureTake::BuildTimeIndex(Timestamps, Header.IndexBucketUsec, TimeIndex);
+    }
+    return true;
+}
+
+void FAzureTakeReader::Close()
+{
+    delete MappedRegion;
+    MappedRegion = nullptr;
+    delete MappedFile;
+    MappedFile = nullptr;
+    Loaded.Empty();
+    Base = nullptr;
+    FrameCount = 0;
+    TimeIndex.Reset();
+}
+
+double FAzureTakeReader::GetDurationSeconds() const
+{
+    return FrameCount > 0 ? GetFrameTimeUsec(FrameCount - 1) * 1e-6 : 0.0;
+}
+
+uint64 FAzureTakeReader::GetFrameTimeUsec(int32 Index) const
+{
+    if (Index < 0 || Index >= FrameCount)
+    {
+        return 0;
+    }
+    const uint64 T = Frame(Index).TimestampUsec;
+    return T >= Header.FirstTimestampUsec ? T - Header.FirstTimestampUsec : 0;
+}
+
+int32 FAzureTakeReader::FindFrameAtTime(uint64 TimeUsec) const
+{
+    if (FrameCount == 0 || TimeIndex.Num() == 0)
+    {
+        return -1;
+    }
+
+    const int32 Bucket = (int32)FMath::Min<uint64>(TimeUsec / Header.IndexBucketUsec, TimeIndex.Num() - 1);
+    int32 Index = (int32)TimeIndex[Bucket];
+    while (Index + 1 < FrameCount && GetFrameTimeUsec(Index + 1) <= TimeUsec)
+    {
+        ++Index;
+    }
+    return Index;
+}
+
+bool FAzureTakeReader::ReadFrame(int32 Index, FAzureFrameSnapshot& OutSnapshot) const
+{
+    OutSnapshot.Reset();
+    if (Index < 0 || Index >= FrameCount)
+    {
+        return false;
+    }
+
+    const AzureTake::FFrameRecord& Record = Frame(Index);
+    OutSnapshot.DeviceTimestampUsec = Record.TimestampUsec;
+
+    const int32 BodyCount = FMath::Min<int32>(Record.BodyCount, AzureTake::MaxBodies);
+    OutSnapshot.Bodies.SetNum(BodyCount, false);
+    for (int32 b = 0; b < BodyCount; ++b)
+    {
+        FAzureTrackedBody& Body = OutSnapshot.Bodies[b];
+        Body.BodyId = Record.Bodies[b].BodyId;
+        Body.PersonId = Record.Bodies[b].PersonId;
+        Body.FrameIndex = b;
+        Body.Skeleton = Record.Bodies[b].Skeleton;
+    }
+    return true;
+}
@@ -0,0 +1,157 @@
+#include "AzureTakeRecorder.h"
+#include "AzureBodyTrackingStats.h"
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Serialization/Archive.h"
+
+FAzureTakeRecorder::~FAzureTakeRecorder()
+{
+    Shutdown();
+}
+
+bool FAzureTakeRecorder::Start(const FString& Path, bool bInDropWhenBehind)
+{
+    if (Thread)
+    {
+        return false;
+    }
+
+    Writer = IFileManager::Get().CreateFileWriter(*Path);
+    if (!Writer)
+    {
+        UE_LOG(LogAzureBodyTracking, Error, TEXT("BodyBT: can't create take '%s'"), *Path);
+        return false;
+    }
+
+    // Placeholder header; FrameCount/IndexOffset stay 0 until Shutdown
+    Header = AzureTake::FHeader();
+    Header.FrameStride = sizeof(AzureTake::FFrameRecord);
+    Writer->Serialize(&Header, sizeof(Header));
+    Timestamps.Reset(IndexChunkFrames);
+    bHasLastTimestamp = false;
+    bDropWhenBehind = bInDropWhenBehind;
+    for (AzureTake::FFrameRecord& Frame : Frames)
+    {
+        FreeFrames.Push(&Frame);
+    }
+
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    SlotFreedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    bStopRequested = false;
+    Thread = FRunnableThread::Create(this, TEXT("AzureKinectTakeRecorder"), 0, TPri_BelowNormal);
+    return Thread != nullptr;
+}
+
+void FAzureTakeRecorder::Shutdown()
+{
+    if (Thread)
+    {
+        bStopRequested = true;
+        WorkEvent->Trigger();
+        Thread->WaitForCompletion(); // Run() drains the queue before returning
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+    if (SlotFreedEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(SlotFreedEvent);
+        SlotFreedEvent = nullptr;
+    }
+
+    if (!Writer)
+    {
+        return;
+    }
+
+    TArray<uint32> TimeIndex;
+    AzureTake::BuildTimeIndex(Timestamps, Header.IndexBucketUsec, TimeIndex);
+
+    Header.FrameCount = Timestamps.Num();
+    Header.FirstTimestampUsec = Timestamps.Num() > 0 ? Timestamps[0] : 0;
+    Header.IndexOffset = Writer->Tell();
+    Header.IndexCount = TimeIndex.Num();
+    Writer->Serialize(TimeIndex.GetData(), TimeIndex.Num() * sizeof(uint32));
+
+    Writer->Seek(0);
+    Writer->Serialize(&Header, sizeof(Header));
+    Writer->Close();
+    delete Writer;
+    Writer = nullptr;
+}
+
+void FAzureTakeRecorder::SubmitFrame_AnyThread(const FAzureFrameSnapshot& Snapshot)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(AzureBT_TakeSubmit);
+
+    if (!Thread || bStopRequested)
+    {
+        return;
+    }
+
+    // The index assumes increasing time; a device restart mid-take would break that
+    if (bHasLastTimestamp && Snapshot.DeviceTimestampUsec <= LastTimestampUsec)
+    {
+        return;
+    }
+
+    AzureTake::FFrameRecord* Record = nullptr;
+    while (!FreeFrames.Pop(Record))
+    {
+        if (bDropWhenBehind)
+        {
+            // Every slot is still queued: the writer fell behind
+            FramesDropped.Increment();
+            return;
+        }
+        WorkEvent->Trigger();
+        SlotFreedEvent->Wait(FTimespan::FromMilliseconds(50));
+    }
+
+    AzureTake::MakeFrameRecord(Snapshot, *Record);
+    LastTimestampUsec = Snapshot.DeviceTimestampUsec;
+    bHasLastTimestamp = true;
+
+    Queue.Push(Record); // can't fail, there are no more slots than ring entries
+    TRACE_COUNTER_SET(AzureBT_TakeRecorderQueue, Queue.Num());
+    WorkEvent->Trigger();
+}
+
+uint32 FAzureTakeRecorder::Run()
+{
+    for (;;)
+    {
+        AzureTake::FFrameRecord* Record = nullptr;
+        while (Queue.Pop(Record))
+        {
+            TRACE_CPUPROFILER_EVENT_SCOPE(AzureBT_TakeWrite);
+
+            // Grow the index by a fixed chunk rather than doubling, so a long take only reallocates once an hour
+            if (Timestamps.Num() == Timestamps.Max())
+            {
+                Timestamps.Reserve(Timestamps.Num() + IndexChunkFrames);
+            }
+            Timestamps.Add(Record->TimestampUsec);
+            Writer->Serialize(Record, sizeof(*Record));
+            FramesWritten.Increment();
+
+            FreeFrames.Push(Record);
+            SlotFreedEvent->Trigger();
+            TRACE_COUNTER_SET(AzureBT_TakeRecorderQueue, Queue.Num());
+        }
+
+        if (bStopRequested)
+        {
+            // The producer stops submitting before Shutdown(), so this drain was the last one
+            break;
+        }
+        WorkEvent->Wait(FTimespan::FromMilliseconds(50));
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+// AzureTakeRecorder.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "AzureTakeFile.h"
+#include "AzureSpscRing.h"
+
+class FArchive;
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Appends fixed-size frame records to an .aktake file on its own thread. The producer
+ * (tracking worker) fills a record in one of a few recycled slots; the disk write happens
+ * here, so a slow disk never stalls tracking. Live recording drops new frames when the
+ * writer falls behind; the time index and final header are written by Shutdown().
+ */
+class FAzureTakeRecorder : public FRunnable
+{
+public:
+    virtual ~FAzureTakeRecorder() override;
+
+    /**
+     * Opens Path and starts the writer thread. Offline writers that must keep every frame
+     * pass bDropWhenBehind = false; the producer then waits for a free slot instead.
+     */
+    bool Start(const FString& Path, bool bDropWhenBehind = true);
+
+    /** Writes out queued frames, the index and the header. Safe to call twice. */
+    void Shutdown();
+
+    /** Producer side (one thread at a time). Snapshot is copied into a slot before this returns. */
+    void SubmitFrame_AnyThread(const FAzureFrameSnapshot& Snapshot);
+
+    int32 GetFramesWritten() const { return FramesWritten.GetValue(); }
+    int32 GetFramesDropped() const { return FramesDropped.GetValue(); }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    static constexpr uint32 MaxQueuedFrames = 16; // ~530 ms at 30 fps, ~100 KB of records
+    static constexpr int32 IndexChunkFrames = 30 * 60 * 60; // an hour at 30 fps
+
+    FArchive* Writer = nullptr;
+    FRunnableThread* Thread = nullptr;
+    FEvent* WorkEvent = nullptr;
+    FEvent* SlotFreedEvent = nullptr;   // only waited on when frames aren't dropped
+    FThreadSafeBool bStopRequested = false;
+    bool bDropWhenBehind = true;
+
+    AzureTake::FHeader Header;
+
+    // Slots go producer -> writer through Queue and back through FreeFrames
+    AzureTake::FFrameRecord Frames[MaxQueuedFrames];
+    TAzureSpscRing<AzureTake::FFrameRecord*, MaxQueuedFrames> Queue;
+    TAzureSpscRing<AzureTake::FFrameRecord*, MaxQueuedFrames> FreeFrames;
+
+    // Producer only
+    uint64 LastTimestampUsec = 0;
+    bool bHasLastTimestamp = false;
+
+    // Writer-thread only
+    TArray<uint64> Timestamps;          // index, reserved an hour of frames at a time
+
+    FThreadSafeCounter FramesWritten;
+    FThreadSafeCounter FramesDropped;
+};
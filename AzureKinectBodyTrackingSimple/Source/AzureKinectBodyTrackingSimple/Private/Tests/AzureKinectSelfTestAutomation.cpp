@@ -0,0 +1,24 @@
+#include "AzureKinectSelfTest.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The benchmark commandlet's known-answer checks, for Session Frontend and
+// -ExecCmds="Automation RunTests AzureKinect". No sensor needed.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAzureKinectSelfTest, "AzureKinect.BodyTracking.KnownAnswers",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAzureKinectSelfTest::RunTest(const FString& Parameters)
+{
+    TArray<FString> Failures;
+    const int32 NumChecks = AzureSelfTest::Run(Failures);
+
+    for (const FString& Failure : Failures)
+    {
+        AddError(Failure);
+    }
+    AddInfo(FString::Printf(TEXT("%d checks, %d failed"), NumChecks, Failures.Num()));
+    return TestTrue(TEXT("Any checks ran"), NumChecks > 0) && Failures.Num() == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
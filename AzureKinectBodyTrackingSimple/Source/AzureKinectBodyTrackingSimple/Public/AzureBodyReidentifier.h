@@ -0,0 +1,56 @@
+// AzureBodyReidentifier.h
+#pragma once
+#include "CoreMinimal.h"
+#include <k4abt.h>
+
+struct FAzureFrameSnapshot;
+
+/**
+ * Keeps one persistent PersonId per physical person across k4abt tracker id changes.
+ * When a new tracker id shows up, it is matched against recently lost people by
+ * predicted pelvis position and a bone-length signature; a match inherits the PersonId.
+ */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureBodyReidentifier
+{
+public:
+    struct FSettings
+    {
+        float WindowSeconds = 3.f;          // how long a lost person can be re-acquired
+        float MaxPositionErrorMm = 700.f;   // vs. position extrapolated from last velocity
+        float MaxSignatureError = 0.12f;    // mean relative bone-length difference
+        float SignatureWeight = 1.f;        // cost = pos/MaxPos + weight * sig/MaxSig
+        float SignatureSmoothing = 0.1f;    // EMA weight of a new frame's bone lengths
+    };
+
+    static constexpr int32 NumBones = 9;
+
+    void Configure(const FSettings& InSettings) { Settings = InSettings; }
+    void Reset();
+
+    /**
+     * Writes PersonId for every body of Snapshot (in place). NowSeconds is double so the
+     * sensor clock keeps sub-millisecond resolution however long the device has run.
+     */
+    void Update(FAzureFrameSnapshot& Snapshot, double NowSeconds);
+
+private:
+    struct FIdentity
+    {
+        int32 PersonId = -1;
+        int32 TrackerId = -1;               // last tracker id seen for this person
+        float Signature[NumBones];
+        float SignatureWeight[NumBones];    // 0 until the bone was measured confidently
+        FVector3f Position = FVector3f::ZeroVector; // pelvis, mm
+        FVector3f Velocity = FVector3f::ZeroVector; // mm/s
+        double LastSeen = 0.0;
+        bool  bSeenThisFrame = false;
+    };
+
+    static void MeasureBones(const k4abt_skeleton_t& Skeleton, float OutLengths[NumBones], bool OutValid[NumBones]);
+    float SignatureError(const FIdentity& Identity, const float Lengths[NumBones], const bool Valid[NumBones]) const;
+    void  Observe(FIdentity& Identity, int32 TrackerId, const FVector3f& Pelvis, const float Lengths[NumBones], const bool Valid[NumBones], double NowSeconds);
+
+    FSettings Settings;
+    TArray<FIdentity> Identities;
+    int32 NextPersonId = 0;
+};
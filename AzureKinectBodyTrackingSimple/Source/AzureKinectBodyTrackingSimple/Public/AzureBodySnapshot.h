@@ -0,0 +1,50 @@
+// AzureBodySnapshot.h
+#pragma once
+#include "CoreMinimal.h"
+#include <k4abt.h>
+
+/** One tracked body, copied out of a k4abt frame once so nothing downstream has to call the SDK. */
+struct FAzureTrackedBody
+{
+    int32 BodyId = -1;                          // tracker id (changes after occlusion)
+    int32 PersonId = -1;                        // persistent identity; equals BodyId unless re-identification remaps it
+    int32 FrameIndex = -1;                      // index in the k4abt frame (= value in the body index map)
+    k4abt_skeleton_t Skeleton;                  // raw, Azure camera space (mm)
+    FVector JointsWorld[K4ABT_JOINT_COUNT];     // world space (cm), through AzureCameraTransform
+    FBox WorldBounds = FBox(ForceInit);         // over joints with any confidence
+};
+
+/** Every body of one tracker frame. */
+struct FAzureFrameSnapshot
+{
+    uint64 DeviceTimestampUsec = 0;
+    uint64 SystemTimestampNsec = 0; // host clock when the capture arrived; 0 when unknown (takes, streams)
+    TArray<FAzureTrackedBody> Bodies;
+
+    void Reset()
+    {
+        DeviceTimestampUsec = 0;
+        SystemTimestampNsec = 0;
+        Bodies.Reset();
+    }
+
+    const FAzureTrackedBody* FindBody(int32 BodyId) const
+    {
+        if (BodyId < 0) return nullptr;
+        for (const FAzureTrackedBody& B : Bodies)
+        {
+            if (B.BodyId == BodyId) return &B;
+        }
+        return nullptr;
+    }
+
+    const FAzureTrackedBody* FindPerson(int32 PersonId) const
+    {
+        if (PersonId < 0) return nullptr;
+        for (const FAzureTrackedBody& B : Bodies)
+        {
+            if (B.PersonId == PersonId) return &B;
+        }
+        return nullptr;
+    }
+};
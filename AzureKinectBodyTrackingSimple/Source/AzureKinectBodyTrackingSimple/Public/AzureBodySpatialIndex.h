@@ -0,0 +1,53 @@
+// AzureBodySpatialIndex.h
+#pragma once
+#include "CoreMinimal.h"
+
+struct FAzureFrameSnapshot;
+
+/**
+ * World-space lookup structure over every joint of every body in one frame.
+ * Built once per tracker frame; joints live in an implicit (in-place) k-d tree so
+ * nearest-joint queries are O(log n), body volumes are per-body AABBs.
+ * Body ids returned here are the snapshot's PersonIds.
+ */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureBodySpatialIndex
+{
+public:
+    static constexpr uint32 AllJoints = 0xFFFFFFFFu;
+
+    void Build(const FAzureFrameSnapshot& Snapshot);
+    void Reset();
+
+    int32 NumBodies() const { return BodyIds.Num(); }
+
+    /**
+     * Nearest joint to WorldPoint among the joints whose bit is set in JointMask
+     * (bit i = k4abt joint i). Returns false if the index is empty.
+     */
+    bool FindNearestJoint(const FVector& WorldPoint, uint32 JointMask,
+                          int32& OutBodyId, int32& OutJointId, FVector& OutPosition, float& OutDistance) const;
+
+    /** Body owning the nearest joint of any kind. Returns -1 if empty. */
+    int32 FindNearestBody(const FVector& WorldPoint, float& OutDistance) const;
+
+    /** Bodies whose bounds intersect (or, with bFullyInside, lie within) WorldBox. */
+    int32 FindBodiesInBox(const FBox& WorldBox, TArray<int32>& OutBodyIds, bool bFullyInside = false) const;
+
+    bool GetBodyBounds(int32 BodyId, FBox& OutBounds) const;
+
+private:
+    struct FJointNode
+    {
+        FVector3f Position;
+        uint8 BodySlot = 0;
+        uint8 JointId = 0;
+        uint8 SplitAxis = 0;
+    };
+
+    void BuildRange(int32 Begin, int32 End);
+    void NearestInRange(int32 Begin, int32 End, const FVector3f& P, uint32 JointMask, int32& BestNode, float& BestDistSq) const;
+
+    TArray<FJointNode> Nodes;
+    TArray<int32> BodyIds;  // by slot
+    TArray<FBox>  Bounds;   // by slot
+};
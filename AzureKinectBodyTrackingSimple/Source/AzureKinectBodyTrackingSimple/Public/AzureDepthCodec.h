@@ -0,0 +1,35 @@
+// AzureDepthCodec.h
+#pragma once
+#include "CoreMinimal.h"
+
+/** Optional general-purpose pass over the RVL output (UE's built-in compressors). */
+enum class EAzureDepthSecondStage : uint8
+{
+    None = 0,
+    LZ4,        // cheap, a few extra percent
+    Oodle       // slower to encode, noticeably smaller
+};
+
+/**
+ * Lossless depth compression. Stage one is RVL (Wilson, "Fast Lossless Depth Image
+ * Compression"): alternating zero / non-zero runs, values delta- and zigzag-coded into
+ * 4-bit variable-length nibbles. Typically 3-5x on NFOV depth at several hundred fps per core.
+ * All functions are stateless and safe to call from any thread.
+ */
+namespace AzureDepthCodec
+{
+    /** Appends the RVL stream for NumPixels depth values to Out (Out is reset first). */
+    AZUREKINECTBODYTRACKINGSIMPLE_API void RvlEncode(const uint16* Depth, int32 NumPixels, TArray<uint8>& Out);
+
+    /** Returns false if In is truncated or doesn't describe exactly NumPixels values. */
+    AZUREKINECTBODYTRACKINGSIMPLE_API bool RvlDecode(const uint8* In, int32 InSize, uint16* OutDepth, int32 NumPixels);
+
+    /**
+     * RVL plus optional second stage, with a small self-describing header. Scratch holds the
+     * intermediate RVL stream when there is a second stage (reuse it across calls).
+     */
+    AZUREKINECTBODYTRACKINGSIMPLE_API bool Encode(const uint16* Depth, int32 NumPixels, EAzureDepthSecondStage SecondStage, TArray<uint8>& Out, TArray<uint8>& Scratch);
+
+    /** Inverse of Encode. Scratch holds the intermediate RVL stream (reuse it across calls). */
+    AZUREKINECTBODYTRACKINGSIMPLE_API bool Decode(const uint8* In, int32 InSize, uint16* OutDepth, int32 NumPixels, TArray<uint8>& Scratch);
+}
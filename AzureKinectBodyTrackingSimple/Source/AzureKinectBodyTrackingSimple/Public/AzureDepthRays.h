@@ -0,0 +1,32 @@
+// AzureDepthRays.h
+#pragma once
+#include "CoreMinimal.h"
+#include <k4a/k4a.h>
+
+/**
+ * Precomputed unprojection for a regular subsample of the depth image.
+ * Rays are scaled so Z == 1: point_mm = Ray * depth_mm (Azure depth camera axes).
+ */
+struct FAzureDepthRayTable
+{
+    int32 Width = 0;      // full depth image size
+    int32 Height = 0;
+    int32 Step = 1;       // pixel stride of the subsample
+
+    TArray<int32>     PixelIndex; // index into the full depth image
+    TArray<FVector3f> Rays;
+
+    bool IsValid() const { return Width > 0 && Height > 0 && Rays.Num() > 0; }
+};
+
+namespace AzureDepth
+{
+    /** Builds the ray table from the depth intrinsics; pixels outside the valid lens model are skipped. */
+    AZUREKINECTBODYTRACKINGSIMPLE_API bool BuildRayTable(const k4a_calibration_t& Calibration, int32 Step, FAzureDepthRayTable& OutTable);
+
+    /** Unprojects the subsampled pixels with non-zero depth into OutPoints (millimeters). */
+    AZUREKINECTBODYTRACKINGSIMPLE_API void SamplePointCloud(
+        const uint16* Depth, int32 Width, int32 Height,
+        const FAzureDepthRayTable& Table,
+        TArray<FVector3f>& OutPoints);
+}
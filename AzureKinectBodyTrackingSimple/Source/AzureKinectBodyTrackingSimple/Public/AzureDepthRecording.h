@@ -0,0 +1,75 @@
+// AzureDepthRecording.h
+#pragma once
+#include "CoreMinimal.h"
+#include "AzureBodySnapshot.h"
+#include "AzureDepthCodec.h"
+
+class FArchive;
+
+/**
+ * Depth + body recording container (.akdepth):
+ *   header  | frame records (timestamp, compressed depth, bodies) ... | index | footer
+ * Records are self-delimiting, so a file cut short by a crash is still readable up to
+ * its last complete frame; the index at the end just makes opening and seeking instant.
+ */
+namespace AzureDepthFile
+{
+    constexpr uint32 FileMagic   = 0x52444B41; // "AKDR"
+    constexpr uint32 FrameMagic  = 0x4D52464B; // "KFRM"
+    constexpr uint32 FooterMagic = 0x58444B41; // "AKDX"
+    constexpr uint32 Version = 1;
+
+    struct FFileHeader
+    {
+        int32 Width = 0;
+        int32 Height = 0;
+        EAzureDepthSecondStage SecondStage = EAzureDepthSecondStage::None;
+    };
+
+    AZUREKINECTBODYTRACKINGSIMPLE_API void WriteHeader(FArchive& Ar, const FFileHeader& Header);
+
+    /** DepthPayload is AzureDepthCodec::Encode output. Only BodyId, PersonId and Skeleton are stored. */
+    AZUREKINECTBODYTRACKINGSIMPLE_API void WriteFrame(FArchive& Ar, uint64 DeviceTimestampUsec,
+        const TArray<uint8>& DepthPayload, const FAzureFrameSnapshot& Bodies);
+
+    AZUREKINECTBODYTRACKINGSIMPLE_API void WriteIndex(FArchive& Ar, const TArray<int64>& Offsets, const TArray<uint64>& Timestamps);
+}
+
+/** One frame as stored: depth still compressed so it can be decoded on any thread. */
+struct FAzureDepthRecordingFrame
+{
+    uint64 DeviceTimestampUsec = 0;
+    TArray<uint8> DepthPayload;
+    FAzureFrameSnapshot Bodies;   // JointsWorld/WorldBounds not filled
+
+    /** Decompresses DepthPayload into OutDepth (Width * Height values). Thread-safe. */
+    AZUREKINECTBODYTRACKINGSIMPLE_API bool DecodeDepth(int32 Width, int32 Height, TArray<uint16>& OutDepth, TArray<uint8>& Scratch) const;
+};
+
+/** Random access over an .akdepth file. Not thread-safe; decode frames in parallel instead. */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureDepthRecordingReader
+{
+public:
+    ~FAzureDepthRecordingReader();
+
+    bool Open(const FString& Path);
+    void Close();
+
+    int32 NumFrames() const { return Offsets.Num(); }
+    int32 GetWidth() const { return Header.Width; }
+    int32 GetHeight() const { return Header.Height; }
+    uint64 GetTimestampUsec(int32 Index) const { return Timestamps.IsValidIndex(Index) ? Timestamps[Index] : 0; }
+
+    /** Reads frame Index (compressed). */
+    bool ReadFrame(int32 Index, FAzureDepthRecordingFrame& OutFrame);
+
+private:
+    bool ReadIndex();
+    void ScanFrames();
+
+    FArchive* Reader = nullptr;
+    AzureDepthFile::FFileHeader Header;
+    int64 FirstFrameOffset = 0;
+    TArray<int64> Offsets;
+    TArray<uint64> Timestamps;
+};
@@ -0,0 +1,80 @@
+// AzureFloorDetector.h
+#pragma once
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+struct FAzureDepthRayTable;
+
+/** Floor plane in the Azure depth camera frame (+Y down), millimeters. */
+struct FAzureFloorEstimate
+{
+    FVector3f Up = FVector3f(0.f, -1.f, 0.f); // plane normal, pointing toward the sensor
+    float HeightMm = 0.f;                     // sensor distance above the plane
+    float InlierRatio = 0.f;
+    bool  bValid = false;
+    bool  bConverged = false;
+};
+
+/**
+ * Incremental RANSAC floor finder. Each call runs a small batch of hypotheses against
+ * the new point cloud and also re-scores the current best, so the estimate keeps improving
+ * across frames instead of starting over. Planes tilted too far from up are rejected up front:
+ * up is the gravity direction when given (e.g. from the IMU), otherwise the sensor's own up
+ * axis, so walls never win. No SDK calls: feed it recorded frames directly.
+ * Not thread-safe; drive it from one thread at a time.
+ */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureFloorDetector
+{
+public:
+    struct FSettings
+    {
+        int32 HypothesesPerFrame = 64;
+        float InlierThresholdMm = 25.f;
+        float MaxTiltFromGravityDegrees = 20.f;   // when gravity is supplied
+        float MaxTiltWithoutGravityDegrees = 45.f; // otherwise, from the depth camera's -Y (sensor pitch/roll)
+        float MinInlierRatio = 0.08f;
+        float LowerPlaneMarginMm = 150.f;         // prefer a lower plane (floor under a table) ...
+        float LowerPlaneMinInlierFraction = 0.5f; // ... if it has at least this share of the inliers
+        float Smoothing = 0.35f;                  // 0..1, weight of the newest frame
+        int32 StableFramesToConverge = 8;
+        float StableAngleDegrees = 0.5f;
+        float StableHeightMm = 10.f;
+        float JumpAngleDegrees = 5.f;             // a converged estimate this far off ...
+        float JumpHeightMm = 100.f;
+        int32 FramesToAcceptJump = 3;             // ... for this many frames means the rig moved: re-seed
+    };
+
+    FAzureFloorDetector();
+
+    void Configure(const FSettings& InSettings) { Settings = InSettings; }
+    void Reset();
+
+    /** One incremental step. GravityDown is a unit vector in depth camera axes, or null. */
+    void ProcessPoints(TArrayView<const FVector3f> Points, const FVector3f* GravityDown);
+
+    /** Convenience for recorded frames: subsamples/unprojects Depth via Rays, then ProcessPoints. */
+    void ProcessDepthFrame(const uint16* Depth, int32 Width, int32 Height,
+                           const FAzureDepthRayTable& Rays, const FVector3f* GravityDown);
+
+    const FAzureFloorEstimate& GetEstimate() const { return Estimate; }
+
+private:
+    struct FFloorPlane
+    {
+        FVector3f N = FVector3f(0.f, -1.f, 0.f);
+        float D = 0.f; // N.p + D = 0; D is the sensor's height above the plane
+    };
+
+    int32 CountInliers(const FFloorPlane& Plane, TArrayView<const FVector3f> Points) const;
+    bool  IsBetter(const FFloorPlane& Candidate, int32 CandidateInliers, const FFloorPlane& Best, int32 BestInliers) const;
+    FFloorPlane Refine(const FFloorPlane& Plane, TArrayView<const FVector3f> Points) const;
+    void  Accept(const FFloorPlane& Plane, float InlierRatio);
+
+    FSettings Settings;
+    FRandomStream Random;
+    TArray<FVector3f> FramePoints; // ProcessDepthFrame scratch
+    FAzureFloorEstimate Estimate;
+
+    int32 StableFrames = 0;
+    int32 DisagreeFrames = 0;
+};
@@ -0,0 +1,95 @@
+// AzureGestureAsset.h
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "AzureKinectBodyTrackingComponent.h" // EAzureKinectJoint
+#include "AzureGestureAsset.generated.h"
+
+/** Direction a joint relation is measured along. Up is sensor up; Right/Forward follow the body's shoulders. */
+UENUM(BlueprintType)
+enum class EAzureGestureAxis : uint8
+{
+    Up          UMETA(DisplayName="Up"),
+    Right       UMETA(DisplayName="Body Right"),
+    Forward     UMETA(DisplayName="Body Forward"),
+    Distance    UMETA(DisplayName="Distance (any direction)")
+};
+
+UENUM(BlueprintType)
+enum class EAzureGesturePredicateType : uint8
+{
+    JointRelation   UMETA(DisplayName="Joint A relative to Joint B"),
+    JointVelocity   UMETA(DisplayName="Joint A velocity")
+};
+
+UENUM(BlueprintType)
+enum class EAzureGestureComparison : uint8
+{
+    Greater     UMETA(DisplayName=">"),
+    Less        UMETA(DisplayName="<")
+};
+
+/**
+ * One test on a skeleton.
+ * JointRelation: (A - B) along Axis compared to ThresholdCm.
+ * JointVelocity: A's velocity along Axis (speed for Distance) compared to ThresholdCm per second.
+ */
+USTRUCT(BlueprintType)
+struct FAzureGesturePredicate
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture")
+    EAzureGesturePredicateType Type = EAzureGesturePredicateType::JointRelation;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture")
+    EAzureKinectJoint JointA = EAzureKinectJoint::HandRight;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture", meta=(EditCondition="Type==EAzureGesturePredicateType::JointRelation"))
+    EAzureKinectJoint JointB = EAzureKinectJoint::Head;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture")
+    EAzureGestureAxis Axis = EAzureGestureAxis::Up;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture")
+    EAzureGestureComparison Comparison = EAzureGestureComparison::Greater;
+
+    /** cm for relations, cm/s for velocities */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture")
+    float ThresholdCm = 12.f;
+};
+
+/** All predicates must hold for HoldSeconds to complete the step. */
+USTRUCT(BlueprintType)
+struct FAzureGestureStep
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture")
+    TArray<FAzureGesturePredicate> Predicates;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture", meta=(ClampMin="0"))
+    float HoldSeconds = 0.f;
+
+    /** Time allowed to complete the next step before the sequence starts over. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Gesture", meta=(ClampMin="0"))
+    float MaxSecondsToNextStep = 1.f;
+};
+
+/** A gesture as data: a sequence of steps evaluated against every tracked body. */
+UCLASS(BlueprintType)
+class AZUREKINECTBODYTRACKINGSIMPLE_API UAzureGestureAsset : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Azure Kinect BT|Gesture")
+    FName GestureName;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Azure Kinect BT|Gesture")
+    TArray<FAzureGestureStep> Steps;
+
+    /** Minimum time between two recognitions for the same body. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Azure Kinect BT|Gesture", meta=(ClampMin="0"))
+    float CooldownSeconds = 0.5f;
+};
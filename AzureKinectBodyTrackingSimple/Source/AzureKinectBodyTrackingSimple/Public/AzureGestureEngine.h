@@ -0,0 +1,85 @@
+// AzureGestureEngine.h
+#pragma once
+#include "CoreMinimal.h"
+
+struct FAzureFrameSnapshot;
+class UAzureGestureAsset;
+
+struct FAzureGestureEvent
+{
+    int32 BodyId = -1;       // PersonId of the body
+    int32 GestureIndex = -1; // index into the array given to SetGestures
+};
+
+/**
+ * Evaluates a set of gesture assets against every body of a frame.
+ * Assets are flattened into predicate/step tables once; each Update does one pass per body:
+ * all predicates first (shared body frame, one velocity estimate), then every gesture's
+ * step machine reads the results. State is kept per PersonId, so it survives tracker id changes.
+ */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureGestureEngine
+{
+public:
+    void SetGestures(const TArray<UAzureGestureAsset*>& Assets);
+    void Reset();
+
+    int32 NumGestures() const { return Gestures.Num(); }
+
+    /** Appends recognized gestures to OutEvents. Positions are read from the raw skeletons (sensor space). */
+    void Update(const FAzureFrameSnapshot& Snapshot, float NowSeconds, TArray<FAzureGestureEvent>& OutEvents);
+
+private:
+    struct FCompiledPredicate
+    {
+        uint8 Type = 0;
+        uint8 JointA = 0;
+        uint8 JointB = 0;
+        uint8 Axis = 0;
+        bool  bGreater = true;
+        float ThresholdMm = 0.f; // mm or mm/s
+    };
+
+    struct FCompiledStep
+    {
+        int32 FirstPredicate = 0;
+        int32 NumPredicates = 0;
+        float HoldSeconds = 0.f;
+        float MaxSecondsToNext = 1.f;
+    };
+
+    struct FCompiledGesture
+    {
+        int32 FirstStep = 0;
+        int32 NumSteps = 0;
+        float CooldownSeconds = 0.f;
+    };
+
+    struct FGestureProgress
+    {
+        int32 Step = 0;
+        float HoldStart = -1.f;
+        float LastStepDoneAt = 0.f;
+        float LastFiredAt = -1e9f;
+        bool  bWaitForRelease = false;
+    };
+
+    struct FBodyState
+    {
+        int32 BodyId = -1;          // -1: free slot
+        float LastSeen = 0.f;
+        float PrevTime = 0.f;
+        bool  bHasPrev = false;
+        TArray<FVector3f> PrevJoints;
+        TArray<FGestureProgress> Progress;
+    };
+
+    FBodyState& FindOrAddBody(int32 BodyId);
+
+    TArray<FCompiledPredicate> Predicates;
+    TArray<FCompiledStep> Steps;
+    TArray<FCompiledGesture> Gestures;
+
+    TArray<FBodyState> Bodies;
+    TArray<bool> PredicateResults; // scratch, one per predicate
+    TArray<bool> StepResults;      // scratch, one per step
+};
@@ -0,0 +1,88 @@
+// AzureImuFilter.h
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * One IMU reading, already rotated into the Azure **depth camera** frame
+ * (+X right, +Y down, +Z forward).
+ */
+struct FAzureImuSample
+{
+    FVector Accel = FVector::ZeroVector;  // m/s^2, specific force (points up when at rest)
+    FVector Gyro = FVector::ZeroVector;   // rad/s
+    uint64  TimestampUsec = 0;            // sensor clock
+};
+
+/**
+ * Complementary filter tracking the gravity direction in the depth camera frame.
+ * The gyro carries the estimate between samples, the accelerometer pulls it back
+ * with time constant TimeConstantSeconds. Yaw is unobservable and not estimated.
+ */
+class FAzureImuOrientationFilter
+{
+public:
+    void Configure(float InTimeConstantSeconds, float InAccelRejectG)
+    {
+        TimeConstantSeconds = FMath::Max(InTimeConstantSeconds, KINDA_SMALL_NUMBER);
+        AccelRejectG = InAccelRejectG;
+    }
+
+    void Reset()
+    {
+        Down = FVector(0.f, 1.f, 0.f);
+        LastTimestampUsec = 0;
+        bInitialized = false;
+    }
+
+    void AddSample(const FAzureImuSample& S)
+    {
+        const double AccelMag = S.Accel.Size();
+        if (AccelMag < KINDA_SMALL_NUMBER)
+        {
+            return;
+        }
+        const FVector AccelDown = -S.Accel / AccelMag;
+
+        // First sample: trust the accelerometer outright
+        if (!bInitialized)
+        {
+            Down = AccelDown;
+            LastTimestampUsec = S.TimestampUsec;
+            bInitialized = true;
+            return;
+        }
+
+        const float Dt = FMath::Clamp((float)((int64)(S.TimestampUsec - LastTimestampUsec)) * 1e-6f, 0.f, 0.1f);
+        LastTimestampUsec = S.TimestampUsec;
+
+        // A world-fixed vector seen from a rotating body turns the other way: dg/dt = -w x g
+        Down = (Down - FVector::CrossProduct(S.Gyro, Down) * Dt).GetSafeNormal();
+
+        // Only correct from the accelerometer while it's measuring mostly gravity (not a bump)
+        const float G = 9.80665f;
+        if (FMath::Abs(AccelMag - G) < AccelRejectG * G)
+        {
+            const float Blend = Dt / (TimeConstantSeconds + Dt);
+            Down = FMath::Lerp(Down, AccelDown, Blend).GetSafeNormal();
+        }
+    }
+
+    bool IsInitialized() const { return bInitialized; }
+
+    /** Unit gravity direction in the depth camera frame. */
+    FVector GetDown() const { return Down; }
+
+    /** Positive when the sensor looks down. */
+    float GetPitchDegrees() const { return FMath::RadiansToDegrees(FMath::Atan2(Down.Z, Down.Y)); }
+
+    /** Positive when the sensor's right side dips. */
+    float GetRollDegrees() const { return FMath::RadiansToDegrees(FMath::Atan2(Down.X, Down.Y)); }
+
+private:
+    FVector Down = FVector(0.f, 1.f, 0.f);
+    uint64  LastTimestampUsec = 0;
+    bool    bInitialized = false;
+
+    float TimeConstantSeconds = 0.5f;
+    float AccelRejectG = 0.15f;
+};
@@ -6,10 +6,26 @@
 #include <k4abt.h>
 
 #include "AzureActiveSelector.h"
+#include "AzureScoredSelector.h"
+#include "AzureImuFilter.h"
+#include "AzureDepthRays.h"
+#include "AzureFloorDetector.h"
+#include "AzureBodySnapshot.h"
+#include "AzureBodySpatialIndex.h"
+#include "AzureGestureEngine.h"
+#include "AzureSkeletonStream.h"
+#include "AzureOcclusionMesh.h"
+#include "AzureOccupancyGrid.h"
+#include "AzureStreamDemand.h"
+#include "Async/Future.h"
+#include "HAL/ThreadSafeBool.h"
 
 #include "Runtime/Engine/Public/EngineGlobals.h"
 #include "AzureKinectBodyTrackingComponent.generated.h"
 
+class UProceduralMeshComponent;
+class UMaterialInterface;
+
 USTRUCT(BlueprintType)
 struct FBodyJointData
 {
@@ -72,10 +88,51 @@ UENUM(BlueprintType)
 enum class EActiveSelectionMode : uint8
 {
     Closest         UMETA(DisplayName = "Closest To Sensor"),
-    WaveLastRaised  UMETA(DisplayName = "Last Hand-Above-Head")
+    WaveLastRaised  UMETA(DisplayName = "Last Hand-Above-Head"),
+    LastGesture     UMETA(DisplayName = "Last Activation Gesture"),
+    Scored          UMETA(DisplayName = "Best Score (distance, zone, facing, confidence, dwell)")
+};
+
+/** A named world-space box counted by the occupancy grid. */
+USTRUCT(BlueprintType)
+struct FAzureOccupancyZone
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Occupancy")
+    FName Name;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Azure Kinect BT|Occupancy")
+    FBox Bounds = FBox(FVector(100.f, -100.f, 20.f), FVector(300.f, 100.f, 220.f));
+};
+
+USTRUCT(BlueprintType)
+struct FAzureZoneOccupancy
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category="Azure Kinect BT|Occupancy")
+    FName Name;
+
+    /**
+     * Estimated from connected occupied floor cells, tracked by the body tracker or not.
+     * Static background (see OccupancyBackgroundSeconds) doesn't count.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Azure Kinect BT|Occupancy")
+    int32 People = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category="Azure Kinect BT|Occupancy")
+    int32 OccupiedVoxels = 0;
+
+    /** Occupied share of the zone's floor cells (0..1); 1 - this is the free floor. */
+    UPROPERTY(BlueprintReadOnly, Category="Azure Kinect BT|Occupancy")
+    float OccupiedFloorFraction = 0.f;
 };
 
+class UAzureGestureAsset;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAzureActiveBodyChanged, int32, OldBodyId, int32, NewBodyId);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FAzureGestureRecognized, int32, BodyId, FName, GestureName, UAzureGestureAsset*, Gesture);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class AZUREKINECTBODYTRACKINGSIMPLE_API UAzureKinectBodyTrackingComponent : public UActorComponent
@@ -103,12 +160,66 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
     bool getBoneDataByEnum(EAzureKinectJoint JointEnum, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const;
 
-    /** The Kinect’s transform in world‐space (set from Blueprint). */
+    /** The Kinect’s transform in world‐space (set from Blueprint). Includes the IMU levelling when enabled. */
     UPROPERTY(BlueprintReadOnly, Category="Azure Kinect BT")
     FTransform AzureCameraTransform = FTransform::Identity;
 
-    //UFUNCTION(BlueprintCallable, Category="Azure Kinect BT")
-    //void setAzureCameraTransform(const FTransform& NewTransform);
+    /** Sets the sensor placement as if it were perfectly level; IMU levelling is applied on top. */
+    UFUNCTION(BlueprintCallable, Category="Azure Kinect BT")
+    void setAzureCameraTransform(const FTransform& NewTransform);
+
+    /** Start the IMU stream alongside the cameras. Applied on BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|IMU")
+    bool bEnableImu = true;
+
+    /** Continuously correct AzureCameraTransform's pitch/roll from the measured gravity. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|IMU")
+    bool bAutoLevelFromImu = false;
+
+    /** How quickly the accelerometer overrides gyro drift (seconds). Lower = faster but noisier. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|IMU", meta = (ClampMin = "0.01"))
+    float ImuFilterTimeConstant = 0.5f;
+
+    /** Positive when the sensor looks down. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|IMU")
+    float SensorPitchDegrees = 0.f;
+
+    /** Positive when the sensor's right side dips. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|IMU")
+    float SensorRollDegrees = 0.f;
+
+    /** Unit gravity direction in UE sensor-local axes (same remap as the joints). */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|IMU")
+    FVector SensorGravityDirection = FVector(0.f, 0.f, 1.f);
+
+    /** Find the floor in the depth stream and drive AzureCameraTransform's height and tilt from it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Floor")
+    bool bAutoCalibrateFloor = false;
+
+    /** World Z of the physical floor; the sensor is placed this much + its measured height. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Floor")
+    float FloorWorldZ = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Floor")
+    float FloorSensorHeightCm = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Floor")
+    bool bFloorConverged = false;
+
+    /** Share of sampled depth points on the detected floor (0..1). */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Floor")
+    float FloorInlierRatio = 0.f;
+
+    /** Forget the current floor and search again (e.g. after moving the rig on purpose). */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Floor")
+    void ResetFloorCalibration();
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|IMU")
+    void GetSensorTilt(float& OutPitchDegrees, float& OutRollDegrees) const
+    {
+        OutPitchDegrees = SensorPitchDegrees;
+        OutRollDegrees = SensorRollDegrees;
+    }
 
     UFUNCTION(BlueprintCallable, Category="Azure Kinect BT")
 	int32 getTrackedBodyCount()
@@ -116,6 +227,122 @@ public:
 		return TrackedBodyCount;
 	}
 
+    /**
+     * Keep one id per person across tracker id changes (brief occlusions). When enabled, every
+     * body id this component reports (selection, gestures, queries) is that persistent id.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Identity")
+    bool bEnableReidentification = true;
+
+    /** How long a lost person can be re-acquired under a new tracker id. Applied on BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Identity", meta = (ClampMin = "0"))
+    float ReidentificationWindowSeconds = 3.f;
+
+    /** Publish bodies as Live Link animation subjects, straight from the tracking thread. Applied on startTracking. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Live Link")
+    bool bPublishLiveLink = false;
+
+    /** Subjects are named <Prefix>_<BodyId>, or <Prefix>_Active when only the active body is published. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Live Link")
+    FName LiveLinkSubjectPrefix = TEXT("AzureKinect");
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Live Link")
+    bool bLiveLinkActiveBodyOnly = false;
+
+    /** Stream every tracker frame to UAzureKinectSkeletonReceiverComponents over UDP. Applied on startTracking. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Stream")
+    bool bStreamSkeletons = false;
+
+    /** IPv4 destination; a broadcast address reaches every render node on the subnet. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Stream")
+    FString StreamAddress = TEXT("127.0.0.1");
+
+    /** Defaults to AzureStream::DefaultPort, like the receiver's ListenPort. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Stream")
+    int32 StreamPort = AzureStream::DefaultPort;
+
+    /** Each body is resent in full at least this often (packets); in between only deltas go out. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Stream", meta = (ClampMin = "1"))
+    int32 StreamKeyframeInterval = 15;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Stream")
+    void GetStreamStats(float& OutKilobitsPerSecond, int32& OutPacketsSent) const;
+
+    /** Add an LZ4 pass over the RVL-coded depth in recordings (a little smaller, a little slower). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Recording")
+    bool bDepthRecordingSecondStage = true;
+
+    /** Decode every recorded frame again and log if it doesn't match (debugging the codec). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Recording")
+    bool bVerifyDepthRecording = false;
+
+    /** Record losslessly compressed depth, bodies and timestamps to an .akdepth file. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Recording")
+    bool StartDepthRecording(const FString& FilePath);
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Recording")
+    void StopDepthRecording();
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Recording")
+    bool IsDepthRecording() const { return DepthRecorder.IsValid(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Recording")
+    void GetDepthRecordingStats(int32& OutFramesWritten, int32& OutFramesDropped, float& OutCompressionRatio) const;
+
+    /** Record every tracker frame's bodies to an .aktake file (small, fixed-size records). */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Recording")
+    bool StartTakeRecording(const FString& FilePath);
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Recording")
+    void StopTakeRecording();
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Recording")
+    bool IsTakeRecording() const { return TakeRecorder.IsValid(); }
+
+    /**
+     * Replay an .aktake instead of the live sensor; every node (skeletons, selection, gestures,
+     * queries) then reads the take. Segmentation and floor detection need live depth and pause.
+     * Selection and gesture timing follow the take's clock, so results don't depend on the
+     * playback rate; playing, seeking, looping and stopping start selection over.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Playback")
+    bool PlayTake(const FString& FilePath);
+
+    /** Back to the live sensor. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Playback")
+    void StopTake();
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Playback")
+    void SeekTake(float Seconds);
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Playback")
+    float GetTakeDuration() const;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Playback")
+    bool bIsPlayingTake = false;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Playback")
+    float TakePositionSeconds = 0.f;
+
+    /** 1 = real time; higher plays faster. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Playback", meta = (ClampMin = "0"))
+    float TakePlaybackRate = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Playback")
+    bool bLoopTake = false;
+
+    /** Ignore time and play exactly one recorded frame per Tick (as fast as the game runs; for benchmarks). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Playback")
+    bool bTakeStepEveryTick = false;
+
+    /** Captures the tracker couldn't take plus tracker frames superseded before a Tick picked them up. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    int32 GetDroppedBodyFrames() const;
+
+    /** Time from the capture reaching the host to the Tick that picked up its bodies (includes tracking). */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT")
+    float SensorToGameLatencyMs = 0.f;
+
     /** The SDK’s persistent ID of the body we're currently tracking (or -1 if none) */
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="Azure Kinect BT")
     int32 TrackedBodyId = -1;
@@ -136,6 +363,35 @@ public:
         const FVector& AvatarHeadWorld,
         float AimDistance = 1000.f) const;
 
+    /**
+     * ComputeLookTargetFromKinectHead for a whole crowd in one call (one target per head).
+     * SmoothingSeconds > 0 eases each avatar's aim over time. The state is kept per CrowdKey and
+     * index: give every crowd you drive its own key and keep its order stable. It advances once
+     * per frame; further calls for the same crowd in that frame return the same aims. MaxYaw/
+     * MaxPitchDegrees limit the aim around AvatarForwardsWorld (empty, or one per head).
+     */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT", meta = (AutoCreateRefTerm = "AvatarForwardsWorld"))
+    void ComputeLookTargetsFromKinectHead(
+        const FVector& HeadPosMeters_Kinect,
+        const FTransform& KinectToWorld,
+        const FTransform& CameraWorld,
+        const TArray<FVector>& AvatarHeadsWorld,
+        const TArray<FVector>& AvatarForwardsWorld,
+        TArray<FVector>& OutTargets,
+        float AimDistance = 1000.f,
+        float SmoothingSeconds = 0.f,
+        float MaxYawDegrees = 180.f,
+        float MaxPitchDegrees = 90.f,
+        FName CrowdKey = NAME_None);
+
+    /** Drops the smoothed aims of one crowd (None is the default crowd). */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    void ResetLookSmoothing(FName CrowdKey = NAME_None);
+
+    /** Drops the smoothed aims of every crowd. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    void ResetAllLookSmoothing();
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection")
     EActiveSelectionMode SelectionMode = EActiveSelectionMode::Closest;
 
@@ -156,6 +412,41 @@ public:
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Active")
     bool bHasActive = false;
 
+    /** Scored mode: world-space center of the interaction zone. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored")
+    FVector InteractionZoneCenter = FVector::ZeroVector;
+
+    /** Scored mode: zone radius in cm; 0 ignores the zone. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0"))
+    float InteractionZoneRadius = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0"))
+    float ScoreDistanceWeight = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0"))
+    float ScoreZoneWeight = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0"))
+    float ScoreFacingWeight = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0"))
+    float ScoreConfidenceWeight = 0.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0"))
+    float ScoreDwellWeight = 0.5f;
+
+    /** A challenger must beat the active body's score (0..1) by this much to take over. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0", ClampMax = "1"))
+    float ScoreSwitchMargin = 0.1f;
+
+    /** The active body is kept at least this long before a challenger can take over. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection|Scored", meta = (ClampMin = "0"))
+    float ScoreMinHoldSeconds = 1.f;
+
+    /** Scored mode: last score (0..1) of a body, or -1 if it isn't known. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Active Selection")
+    float GetBodySelectionScore(int32 BodyId) const { return ScoredSelector.GetScore(BodyId); }
+
     UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Active Selection")
     void SetSelectionMode(EActiveSelectionMode NewMode) { SelectionMode = NewMode; }
 
@@ -171,6 +462,175 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Azure Kinect BT|Active")
     FAzureActiveBodyChanged OnActiveBodyChanged;
 
+    /** Gestures evaluated against every tracked body each tracker frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Gesture")
+    TArray<UAzureGestureAsset*> Gestures;
+
+    /** In LastGesture selection mode, the body that last performed this gesture becomes active. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Active Selection")
+    UAzureGestureAsset* ActivationGesture = nullptr;
+
+    UPROPERTY(BlueprintAssignable, Category = "Azure Kinect BT|Gesture")
+    FAzureGestureRecognized OnGestureRecognized;
+
+    /** Replaces the gesture set at runtime (resets all gesture progress). */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Gesture")
+    void SetGestures(const TArray<UAzureGestureAsset*>& NewGestures);
+
+    /** Body (tracker id) with a joint nearest to WorldPoint. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool FindNearestBodyToPoint(const FVector& WorldPoint, int32& OutBodyId, float& OutDistance) const;
+
+    /** Nearest joint of the given type, over all tracked bodies. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool FindNearestJointToPoint(const FVector& WorldPoint, EAzureKinectJoint Joint, int32& OutBodyId, FVector& OutJointPosition, float& OutDistance) const;
+
+    /** Nearest left or right hand, over all tracked bodies. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool FindNearestHandToPoint(const FVector& WorldPoint, int32& OutBodyId, EAzureKinectJoint& OutHand, FVector& OutHandPosition, float& OutDistance) const;
+
+    /** Bodies whose joint bounds overlap (or with bFullyInside, are contained in) WorldBox. Returns the count. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    int32 GetBodiesInBox(const FBox& WorldBox, TArray<int32>& OutBodyIds, bool bFullyInside = false) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool GetBodyWorldBounds(int32 BodyId, FBox& OutBounds) const;
+
+    /** Every body of the latest tracker frame (C++ only). */
+    const FAzureFrameSnapshot& GetFrameSnapshot() const { return Snapshot; }
+
+    /** World-space index over the latest frame, rebuilt once per tracker frame (C++ only). */
+    const FAzureBodySpatialIndex& GetBodySpatialIndex() const { return BodySpatialIndex; }
+
+    /** Publish the tracker's body index map as textures every tracker frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Segmentation")
+    bool bOutputBodyIndexMap = true;
+
+    /** Warp the index map into the color camera (720p) instead of leaving it aligned to depth. Applied on startTracking. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Segmentation")
+    bool bWarpBodyIndexToColor = false;
+
+    /** R8 body index map: value = index of the body in the current frame, 255 = background. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Segmentation")
+    UTexture2D* BodyIndexTexture = nullptr;
+
+    /** R8 matte of the active body only: 255 = active body, 0 = everything else. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Segmentation")
+    UTexture2D* ActiveBodyMaskTexture = nullptr;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Segmentation")
+    UTexture2D* GetBodyIndexTexture() const { BodyIndexDemand.Touch(); return BodyIndexTexture; }
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Segmentation")
+    UTexture2D* GetActiveBodyMaskTexture() const { BodyIndexDemand.Touch(); return ActiveBodyMaskTexture; }
+
+    /**
+     * Skip the body index textures while neither was drawn or fetched through its getter
+     * within BodyIndexIdleSeconds.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Segmentation", meta = (EditCondition = "bOutputBodyIndexMap"))
+    bool bGateBodyIndexOnDemand = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Segmentation", meta = (EditCondition = "bGateBodyIndexOnDemand", ClampMin = "0.1"))
+    float BodyIndexIdleSeconds = 1.f;
+
+    /** Body arrays (snapshots, selector samples) are preallocated for this many bodies on startTracking; more still work. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Memory", meta = (ClampMin = "1", ClampMax = "16"))
+    int32 ExpectedMaxBodies = 6;
+
+    /** Texture staging blocks preallocated per texture on startTracking: uploads the render thread may hold at once. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Memory", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 StagingFramesInFlight = 3;
+
+    /**
+     * Build a triangle mesh of the physical scene from the depth stream, placed with AzureCameraTransform.
+     * Meant as an occluder for compositing: give it a depth-only / holdout material.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occlusion")
+    bool bBuildOcclusionMesh = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occlusion")
+    UMaterialInterface* OcclusionMaterial = nullptr;
+
+    /** Pixels per mesh tile; only tiles whose depth changed are rebuilt. Applied when the mesh starts building. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occlusion", meta = (ClampMin = "8", ClampMax = "256"))
+    int32 OcclusionTileSize = 64;
+
+    /** How far depth has to move (mm) before a tile is rebuilt. Applied when the mesh starts building. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occlusion", meta = (ClampMin = "1.0"))
+    float OcclusionChangeThresholdMm = 30.f;
+
+    /** Flat areas within this distance (mm) of a plane become a few large triangles. Applied when the mesh starts building. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occlusion", meta = (ClampMin = "0.0"))
+    float OcclusionPlanarToleranceMm = 8.f;
+
+    /** Depth step (mm) treated as an edge between objects: no triangles across it. Applied when the mesh starts building. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occlusion", meta = (ClampMin = "1.0"))
+    float OcclusionMaxEdgeJumpMm = 50.f;
+
+    /** Tiles rebuilt from the latest depth frame. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Occlusion")
+    int32 OcclusionTilesRebuilt = 0;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Occlusion")
+    int32 OcclusionTriangleCount = 0;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Occlusion")
+    UProceduralMeshComponent* GetOcclusionMesh() const { return OcclusionMesh; }
+
+    /** Rebuild every tile from the next depth frame (settings changes apply too). */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Occlusion")
+    void ResetOcclusionMesh();
+
+    /** Keep a voxel occupancy grid of OccupancyVolume from the depth stream (placed with AzureCameraTransform). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy")
+    bool bTrackOccupancy = false;
+
+    /** World-space volume to track; keep the floor and walls out of it. Changing it clears the grid. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy")
+    FBox OccupancyVolume = FBox(FVector(0.f, -300.f, 20.f), FVector(600.f, 300.f, 220.f));
+
+    /** Changing it clears the grid. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy", meta = (ClampMin = "2.0"))
+    float OccupancyVoxelSizeCm = 10.f;
+
+    /** How long a voxel nobody is in any more takes to lose half its occupancy. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy", meta = (ClampMin = "0.01"))
+    float OccupancyHalfLifeSeconds = 0.5f;
+
+    /** Floor area one person covers, to split groups standing close together. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy", meta = (ClampMin = "100.0"))
+    float OccupancyPersonFootprintCm2 = 2500.f;
+
+    /**
+     * Voxels occupied for most of this long (an exponential average) are static background,
+     * such as furniture or walls, and are left out of the people count. Someone standing still
+     * for that long is absorbed too, until they move. 0 counts everything.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy", meta = (ClampMin = "0.0"))
+    float OccupancyBackgroundSeconds = 30.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy")
+    TArray<FAzureOccupancyZone> OccupancyZones;
+
+    /** One entry per OccupancyZones entry, refreshed every depth frame. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Occupancy")
+    TArray<FAzureZoneOccupancy> ZoneOccupancy;
+
+    /** Also publish OccupancyHeatmapTexture. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Occupancy")
+    bool bOutputOccupancyHeatmap = false;
+
+    /** R8 top-down view of OccupancyVolume (U = world X, V = world Y), highest occupancy per cell. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Occupancy")
+    UTexture2D* OccupancyHeatmapTexture = nullptr;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Occupancy")
+    bool GetZoneOccupancy(FName ZoneName, FAzureZoneOccupancy& OutOccupancy) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Occupancy")
+    void ResetOccupancy();
+
 private:
     // Device handles for the Azure Kinect
     k4a_device_t Device = nullptr;
@@ -179,11 +639,128 @@ private:
     k4abt_frame_t FrameData = nullptr;
     k4abt_skeleton_t* BodySkeleton = nullptr;
 
+    // Calibration the tracker was created with (also used for depth->color warps)
+    k4a_calibration_t Calibration;
+    k4a_transformation_t Transformation = nullptr;
+    k4a_image_t WarpedDepthImage = nullptr;
+    k4a_image_t WarpedIndexImage = nullptr;
+
+    // Scratch for the active body matte
+    TArray<uint8> ActiveMaskBuffer;
+    FAzureStreamDemand BodyIndexDemand;
+
+    // Latest tracker frame copied out once, plus its world-space index
+    FAzureFrameSnapshot Snapshot;
+    FAzureBodySpatialIndex BodySpatialIndex;
+
     FAzureActiveSelector ActiveSelector;
+    FAzureScoredSelector ScoredSelector;
+    TArray<FAzureScoredBodySample> ScoredSamples;
+    TArray<FAzureBodySample> WaveSamples;
+    TArray<TPair<int32, float>> StreamBodyScores; // PersonId -> score, handed to the publisher
+
+    // Smoothed aim per avatar for ComputeLookTargetsFromKinectHead, per crowd
+    struct FLookCrowdState
+    {
+        TArray<FVector> AimDirections;
+        uint64 LastFrame = MAX_uint64;  // GFrameCounter of the last smoothing step
+    };
+    TMap<FName, FLookCrowdState> LookCrowds;
+
+    FAzureGestureEngine GestureEngine;
+    TArray<FAzureGestureEvent> GestureEvents;
+    int32 GestureActivatedBodyId = -1;        // set by ActivationGesture, consumed by selection
+    float ActiveLastSeenSeconds = 0.f;
+
+    // Capture/tracker loop (also owns re-identification) and the optional outputs it feeds
+    TSharedPtr<class FAzureBodyTrackingWorker> TrackingWorker;
+    TSharedPtr<class FAzureKinectLiveLinkSource> LiveLinkSource;
+    TSharedPtr<class FAzureSkeletonPublisher> SkeletonPublisher;
+    TSharedPtr<class FAzureDepthRecorder> DepthRecorder;
+    TSharedPtr<class FAzureTakeRecorder> TakeRecorder;
+
+    // Take playback replaces the worker as the snapshot source
+    TSharedPtr<class FAzureTakeReader> TakeReader;
+    int32 TakeFrameIndex = -1;
+
+    // IMU reader thread + gravity estimate
+    TSharedPtr<class FAzureImuReader> ImuReader;
+    FAzureImuOrientationFilter ImuFilter;
+
+    // Placement as set from Blueprint, before levelling
+    FTransform AzureCameraBaseTransform = FTransform::Identity;
+
+    // Floor detection runs one job at a time on the thread pool
+    FAzureDepthRayTable FloorRays;
+    FAzureFloorDetector FloorDetector;
+    TArray<FVector3f> FloorPoints;            // job input, only touched while no job runs
+    TFuture<void> FloorJob;
+    FThreadSafeBool bFloorResetRequested = false;
+    FCriticalSection FloorLock;
+    FAzureFloorEstimate FloorEstimate;        // latest result, guarded by FloorLock
+
+    // Occlusion mesh: built one job at a time on the thread pool, changed tiles handed back
+    // to the game thread for upload. The jobs read the depth image in place, holding a
+    // reference to it until they finish. Tiles are staged per tile index in place, so their
+    // arrays keep their allocations from one update to the next.
+    UPROPERTY(Transient)
+    UProceduralMeshComponent* OcclusionMesh = nullptr;
+    FAzureOcclusionMeshBuilder OcclusionBuilder;
+    TArray<int32> OcclusionChangedScratch;
+    TFuture<void> OcclusionJob;
+    FThreadSafeBool bOcclusionResetRequested = false;
+    FCriticalSection OcclusionLock;
+    TArray<FAzureOcclusionTile> PendingOcclusionTiles;      // per tile, guarded by OcclusionLock
+    TArray<int32> PendingOcclusionIndices;                  // changed since the last upload, likewise
+    TBitArray<> PendingOcclusionMask;                       // tile is in PendingOcclusionIndices, likewise
+    TArray<FAzureOcclusionTile> UploadOcclusionTiles;       // game thread copies of the pending tiles
+    TArray<int32> UploadOcclusionIndices;
+    int32 PendingOcclusionTriangles = 0;                    // guarded by OcclusionLock
+    int32 PendingOcclusionTilesRebuilt = 0;                 // guarded by OcclusionLock
+
+    // Occupancy grid: same one-job-at-a-time pattern; results copied out under OccupancyLock
+    FAzureDepthRayTable OccupancyRays;
+    FAzureOccupancyGrid OccupancyGrid;
+    TArray<FAzureOccupancyZone> OccupancyJobZones;          // job input, likewise
+    TArray<FAzureZoneOccupancy> OccupancyJobResults;        // job only; rotates with the two below
+    TFuture<void> OccupancyJob;
+    FThreadSafeBool bOccupancyResetRequested = false;
+    FCriticalSection OccupancyLock;
+    TArray<FAzureZoneOccupancy> PendingZoneOccupancy;       // guarded by OccupancyLock
+    TArray<uint8> PendingOccupancyHeatmap;                  // guarded by OccupancyLock
+    FIntPoint PendingOccupancyHeatmapSize = FIntPoint::ZeroValue;
+    bool bOccupancyResultReady = false;                     // guarded by OccupancyLock
 
     void findClosestTrackedBody();
+    bool AdvanceTake(float DeltaTime);        // true when a different take frame is now in Snapshot
+    void StartLiveLink();
+    void StopLiveLink();
 
     void UpdateActiveBodyFromFrame();         // called each Tick after we set FrameData
-    bool GetSkeletonByBodyId(int32 BodyId, k4abt_skeleton_t& OutSkel) const;
+    double GetSelectionTimeSeconds() const;   // world time live, the take frame's sensor time in playback
+    void ResetSelection();                    // active body, selectors and gesture progress
+    void PreallocateFrameMemory();
+    void UpdateGestures();                    // called each Tick a new FrameData arrived
     void SetActiveBody(int32 NewId);
+    int32 FindBodyIndexInFrame(int32 BodyId) const;
+
+    void UpdateBodyIndexTextures();           // called each Tick a new FrameData arrived
+    k4a_image_t WarpBodyIndexToColor(k4a_image_t IndexMap);
+    void ReleaseWarpImages();
+
+    void StartImu();
+    void UpdateImu();                         // drains the IMU ring, called each Tick
+    void ApplySensorLevel(const FVector& DownDepthCamera);
+
+    void SubmitFloorFrame();                  // called each Tick a new FrameData arrived
+    void UpdateFloor();
+    void WaitForFloorJob();
+
+    void SubmitOcclusionFrame();              // called each Tick a new FrameData arrived
+    void UpdateOcclusionMesh();               // uploads tiles finished since the last Tick
+    void WaitForOcclusionJob();
+
+    void SubmitOccupancyFrame();              // called each Tick a new FrameData arrived
+    void UpdateOccupancy();                   // picks up the zone counts and heatmap
+    void WaitForOccupancyJob();
 };
@@ -2,6 +2,16 @@
 #pragma once
 #include "CoreMinimal.h"
 
+/** Per-call options for AzureLook::ComputeLookTargetsBatch. */
+struct FAzureLookBatchSettings
+{
+    float AimDistance = 1000.f;       // cm
+    float SmoothingSeconds = 0.f;     // time constant of the aim direction; 0 = no smoothing
+    float MaxYawDegrees = 180.f;      // around each avatar's forward (needs forwards); 180 = no clamp
+    float MaxPitchDegrees = 90.f;     // above/below each avatar's forward; 90 = no clamp
+    int32 MinAvatarsForParallel = 256; // smaller batches stay on the calling thread
+};
+
 // If other modules will use these, keep the API macro; if not, you can drop it.
 namespace AzureLook
 {
@@ -16,4 +26,27 @@ namespace AzureLook
         const FVector& AvatarHeadWorld,     // avatar head/eyes world position
         float            AimDistance = 1000.f // cm
     );
+
+    // The world point every avatar aims at: the viewer's head seen through the virtual camera.
+    // Depends only on the head and the two transforms, so it's shared by a whole crowd.
+    AZUREKINECTBODYTRACKINGSIMPLE_API FVector ComputeLookRayPoint(
+        const FVector& HeadPosMeters_Kinect,
+        const FTransform& KinectToWorld,
+        const FTransform& CameraWorld);
+
+    // ComputeLookTargetFromKinectHead for many avatars at once: the ray point is computed once,
+    // then each avatar only normalizes its aim. Optional per-avatar smoothing (state kept in
+    // InOutAimDirections, zero vectors start unsmoothed) and yaw/pitch clamps around
+    // AvatarForwardsWorld (leave empty for none). Both arrays are either empty or one per head.
+    // Large batches run on a ParallelFor.
+    AZUREKINECTBODYTRACKINGSIMPLE_API void ComputeLookTargetsBatch(
+        const FVector& HeadPosMeters_Kinect,
+        const FTransform& KinectToWorld,
+        const FTransform& CameraWorld,
+        TArrayView<const FVector> AvatarHeadsWorld,
+        TArrayView<const FVector> AvatarForwardsWorld,
+        const FAzureLookBatchSettings& Settings,
+        float DeltaSeconds,
+        TArrayView<FVector> InOutAimDirections, // empty when not smoothing, else one per head
+        TArrayView<FVector> OutTargets);        // same size as AvatarHeadsWorld
 }
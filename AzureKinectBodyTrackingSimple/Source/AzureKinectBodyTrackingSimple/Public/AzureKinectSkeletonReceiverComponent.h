@@ -0,0 +1,163 @@
+// AzureKinectSkeletonReceiverComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AzureKinectBodyTrackingComponent.h"
+#include "AzureBodySnapshot.h"
+#include "AzureBodySpatialIndex.h"
+#include "AzureGestureEngine.h"
+#include "AzureSkeletonStream.h"
+#include "AzureKinectSkeletonReceiverComponent.generated.h"
+
+/**
+ * Render-node side of skeleton streaming: receives what a UAzureKinectBodyTrackingComponent
+ * with bStreamSkeletons publishes and exposes it through the same nodes, without a sensor.
+ * Selection (active/tracked body and scores) mirrors the sender; spatial queries and gestures
+ * are evaluated locally on every received frame.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class AZUREKINECTBODYTRACKINGSIMPLE_API UAzureKinectSkeletonReceiverComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UAzureKinectSkeletonReceiverComponent();
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type Reason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick Tick, FActorComponentTickFunction* ThisTickFunc) override;
+
+    /** UDP port to listen on (default AzureStream::DefaultPort, the sender's too). Applied on BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Stream")
+    int32 ListenPort = AzureStream::DefaultPort;
+
+    /** Place joints with the sender's AzureCameraTransform (same world positions on every node). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure Kinect BT|Stream")
+    bool bUseSenderCameraTransform = true;
+
+    /** Placement when bUseSenderCameraTransform is off; otherwise mirrors the sender's. */
+    UPROPERTY(BlueprintReadOnly, Category = "Azure Kinect BT")
+    FTransform AzureCameraTransform = FTransform::Identity;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    void setAzureCameraTransform(const FTransform& NewTransform) { AzureCameraTransform = NewTransform; }
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    bool getBodySkeleton(TArray<FBodyJointData>& OutJoints) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    bool getBoneDataByName(const FString& BoneName, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    bool getBoneDataByEnum(EAzureKinectJoint JointEnum, const TArray<FBodyJointData>& Joints, FBodyJointData& OutJointData) const;
+
+    UFUNCTION(BlueprintCallable, Category="Azure Kinect BT")
+    int32 getTrackedBodyCount() const { return TrackedBodyCount; }
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Active Selection")
+    int32 GetActiveBodyId() const { return ActiveBodyId; }
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Active Selection")
+    bool GetActiveBodySkeleton(TArray<FBodyJointData>& OutJoints) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Active")
+    bool HasActive() const { return bHasActive; }
+
+    /** The sender's Scored-mode score (0..1) of a body, or -1 if it isn't known. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Active Selection")
+    float GetBodySelectionScore(int32 BodyId) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT")
+    FVector ComputeLookTargetFromKinectHead(
+        const FVector& HeadPosMeters_Kinect,
+        const FTransform& KinectToWorld,
+        const FTransform& CameraWorld,
+        const FVector& AvatarHeadWorld,
+        float AimDistance = 1000.f) const;
+
+    /** Gestures evaluated against every received body, timed by the sender's sensor clock. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Azure Kinect BT|Gesture")
+    TArray<UAzureGestureAsset*> Gestures;
+
+    UPROPERTY(BlueprintAssignable, Category = "Azure Kinect BT|Gesture")
+    FAzureGestureRecognized OnGestureRecognized;
+
+    /** Replaces the gesture set at runtime (resets all gesture progress). */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Gesture")
+    void SetGestures(const TArray<UAzureGestureAsset*>& NewGestures);
+
+    /** Body (sender's PersonId) with a joint nearest to WorldPoint. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool FindNearestBodyToPoint(const FVector& WorldPoint, int32& OutBodyId, float& OutDistance) const;
+
+    /** Nearest joint of the given type, over all received bodies. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool FindNearestJointToPoint(const FVector& WorldPoint, EAzureKinectJoint Joint, int32& OutBodyId, FVector& OutJointPosition, float& OutDistance) const;
+
+    /** Nearest left or right hand, over all received bodies. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool FindNearestHandToPoint(const FVector& WorldPoint, int32& OutBodyId, EAzureKinectJoint& OutHand, FVector& OutHandPosition, float& OutDistance) const;
+
+    /** Bodies whose joint bounds overlap (or with bFullyInside, are contained in) WorldBox. Returns the count. */
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    int32 GetBodiesInBox(const FBox& WorldBox, TArray<int32>& OutBodyIds, bool bFullyInside = false) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Azure Kinect BT|Queries")
+    bool GetBodyWorldBounds(int32 BodyId, FBox& OutBounds) const;
+
+    /** The sender's closest body (or -1 if none) */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="Azure Kinect BT")
+    int32 TrackedBodyId = -1;
+
+    /** True while packets keep arriving. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT")
+    bool bIsTracking = false;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="Azure Kinect BT")
+    int32 TrackedBodyCount = 0;
+
+    /** The sender's active body. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Active Selection")
+    int32 ActiveBodyId = -1;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Active")
+    bool bHasActive = false;
+
+    UPROPERTY(BlueprintAssignable, Category = "Azure Kinect BT|Active")
+    FAzureActiveBodyChanged OnActiveBodyChanged;
+
+    /** Incoming stream rate. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Stream")
+    float StreamKilobitsPerSecond = 0.f;
+
+    /** Sender's tracker result to this component's Tick, smoothed. Needs synced clocks across machines. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Stream")
+    float StreamLatencyMs = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Azure Kinect BT|Stream")
+    int32 StreamLostPackets = 0;
+
+    /** Every body of the latest received frame (C++ only). */
+    const FAzureFrameSnapshot& GetFrameSnapshot() const { return Snapshot; }
+
+    /** World-space index over the latest received frame (C++ only). */
+    const FAzureBodySpatialIndex& GetBodySpatialIndex() const { return BodySpatialIndex; }
+
+private:
+    TSharedPtr<class FAzureSkeletonSubscriber> Subscriber;
+    FAzureFrameSnapshot Snapshot;
+    TArray<float> BodyScores;                 // per Snapshot body
+    FAzureBodySpatialIndex BodySpatialIndex;
+    double LastPacketSeconds = 0.0;
+
+    // The sender's session and where its sensor clock started, for gesture timing
+    uint32 SessionId = 0;
+    uint64 SessionStartUsec = 0;
+
+    FAzureGestureEngine GestureEngine;
+    TArray<FAzureGestureEvent> GestureEvents;
+
+    void SetActiveBody(int32 NewId);
+    void UpdateGestures(uint64 SensorTimestampUsec);
+    void ResetFrame();                        // sender gone or restarted
+};
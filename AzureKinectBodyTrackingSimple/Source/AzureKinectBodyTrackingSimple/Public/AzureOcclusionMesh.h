@@ -0,0 +1,102 @@
+// AzureOcclusionMesh.h
+#pragma once
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include <k4a/k4a.h>
+
+/** One tile's triangles, ready for a mesh section. */
+struct FAzureOcclusionTile
+{
+    TArray<FVector> Vertices;  // cm, depth camera axes remapped like the joints (X = Z, Y = X, Z = Y)
+    TArray<int32>   Triangles; // front faces toward the sensor
+};
+
+/**
+ * Builds an occluder mesh of the scene from depth frames, tile by tile. The depth image is
+ * sampled on a regular grid and split into square tiles; a tile is only rebuilt when enough
+ * of its samples moved by more than a threshold since it was last built, so the cost follows
+ * the changed area. Inside a tile, a quadtree merges cells that lie on one plane into larger
+ * quads (crack-free: larger quads fan out to every vertex their neighbours use), and cells
+ * spanning a depth discontinuity are dropped instead of stretching skin between foreground
+ * and background. Tiles are independent and rebuilt in parallel.
+ * Not thread-safe; drive it from one thread at a time.
+ */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureOcclusionMeshBuilder
+{
+public:
+    struct FSettings
+    {
+        int32 TileSize = 64;               // pixels, rounded to a power-of-two multiple of GridStep
+        int32 GridStep = 2;                // pixels between mesh vertices at full detail
+        float ChangeThresholdMm = 30.f;    // a sample moved ...
+        int32 MinChangedSamples = 8;       // ... and this many of them: rebuild the tile
+        float MaxEdgeJumpMm = 50.f;        // depth step (plus MaxEdgeJumpRatio * depth) that splits surfaces
+        float MaxEdgeJumpRatio = 0.03f;
+        float PlanarToleranceMm = 8.f;     // merge cells when no sample is further off the plane than this
+        float PlanarToleranceRatio = 0.005f;
+    };
+
+    /** Unprojects pixel (X, Y) to a ray with Z == 1 (mm per mm of depth); false outside the lens model. */
+    using FUnprojectFunc = TFunctionRef<bool(float X, float Y, FVector3f& OutRay)>;
+
+    bool Initialize(const k4a_calibration_t& Calibration, const FSettings& InSettings);
+    bool Initialize(int32 InWidth, int32 InHeight, FUnprojectFunc Unproject, const FSettings& InSettings);
+    bool IsInitialized() const { return Tiles.Num() > 0; }
+
+    /** Forces every tile to rebuild on the next Update. */
+    void Reset();
+
+    /**
+     * Checks every tile against Depth (must match the initialized size) and rebuilds those that
+     * changed. OutChangedTiles receives their indices; returns how many there are.
+     */
+    int32 Update(const uint16* Depth, int32 InWidth, int32 InHeight, TArray<int32>& OutChangedTiles);
+
+    int32 NumTiles() const { return Tiles.Num(); }
+    const FAzureOcclusionTile& GetTile(int32 Index) const { return Tiles[Index].Mesh; }
+    int32 GetTriangleCount() const;
+
+private:
+    struct FNode
+    {
+        int32 X = 0; // tile-local vertex coordinates
+        int32 Y = 0;
+        int32 Size = 1;
+    };
+
+    struct FTileState
+    {
+        int32 GridX0 = 0;             // first vertex column/row of the tile
+        int32 GridY0 = 0;
+        bool  bBuilt = false;
+        bool  bChanged = false;       // rebuilt by the last Update
+        TArray<uint16> BuiltDepth;    // samples the current mesh was built from
+
+        FAzureOcclusionTile Mesh;
+
+        // Rebuild scratch, kept per tile so parallel rebuilds don't share anything
+        TArray<uint16> Samples;
+        TArray<FNode>  Leaves;
+        TArray<int32>  VertexIndex;   // tile-local vertex -> index in Mesh.Vertices, or INDEX_NONE
+        TArray<uint8>  Used;          // tile-local vertex is a leaf corner
+    };
+
+    bool NeedsRebuild(const FTileState& Tile) const;
+    void BuildTile(FTileState& Tile) const;
+    bool IsPlanar(const FTileState& Tile, int32 X0, int32 Y0, int32 Size) const;
+    void Subdivide(FTileState& Tile, int32 X0, int32 Y0, int32 Size) const;
+    int32 GetVertex(FTileState& Tile, int32 LocalX, int32 LocalY) const;
+    void EmitCell(FTileState& Tile, int32 X0, int32 Y0) const;
+    void EmitFan(FTileState& Tile, const FNode& Leaf) const;
+    bool SameSurface(int32 A, int32 B) const;
+
+    FSettings Settings;
+    int32 Width = 0;                  // depth image
+    int32 Height = 0;
+    int32 GridWidth = 0;              // vertices across the image
+    int32 GridHeight = 0;
+    int32 CellsPerTile = 0;           // power of two
+
+    TArray<FVector3f> Rays;           // per grid vertex, zero when invalid
+    TArray<FTileState> Tiles;
+};
@@ -0,0 +1,114 @@
+// AzureOccupancyGrid.h
+#pragma once
+#include "CoreMinimal.h"
+
+struct FAzureDepthRayTable;
+
+/** What a world-space box holds, from the last Integrate. */
+struct FAzureOccupancyZoneResult
+{
+    int32 OccupiedVoxels = 0;   // background included
+    int32 BackgroundVoxels = 0; // occupied, but part of the static background
+    int32 TotalVoxels = 0;      // voxels of the box inside the grid volume
+    int32 OccupiedColumns = 0;  // floor cells with anything above them, background included
+    int32 TotalColumns = 0;
+    int32 People = 0;           // estimated from connected floor cells with non-background voxels above
+};
+
+/**
+ * Sparse voxel occupancy of a world-space volume, fed with depth frames. Only voxels that
+ * were ever hit are stored (hashed, split in shards). Each hit raises a voxel's occupancy
+ * towards 1; without hits it decays with a half-life, evaluated lazily from the time of the
+ * last hit, so decay writes nothing. Sees everything in front of the sensor, tracked by the
+ * body tracker or not.
+ *
+ * Furniture, walls and columns inside the volume are learned as static background: each voxel
+ * also keeps a slow average of how much of the time it was occupied (time constant
+ * BackgroundSeconds, likewise evaluated lazily), and a voxel occupied most of that time is
+ * left out of the people count. Someone standing still that long fades into the background
+ * too, until they move.
+ *
+ * Integrate unprojects bands of the depth image in parallel, then merges each shard in
+ * parallel, so there are no locks. Queries read the state of the last Integrate.
+ * Not thread-safe; drive it from one thread at a time.
+ */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureOccupancyGrid
+{
+public:
+    struct FSettings
+    {
+        FBox  Volume = FBox(FVector(0.f, -300.f, 20.f), FVector(600.f, 300.f, 220.f)); // world cm
+        float VoxelSizeCm = 10.f;
+        float HalfLifeSeconds = 0.5f;
+        float HitGain = 0.5f;           // share of the way to 1 a hit moves the occupancy
+        int32 MinPointsPerVoxel = 2;    // fewer points in a voxel in one frame is noise
+        float OccupiedThreshold = 0.5f;
+        float PersonFootprintCm2 = 2500.f;
+        int32 MinPersonColumns = 2;
+        float BackgroundSeconds = 30.f;  // time constant of the static background; 0 = none
+        float BackgroundThreshold = 0.5f; // share of that time occupied to be background
+    };
+
+    FAzureOccupancyGrid();
+
+    /** Keeps the voxels unless the volume or voxel size changed. */
+    void Configure(const FSettings& InSettings);
+    void Reset();
+
+    /**
+     * Unprojects Depth through Rays, places the points with SensorToWorld (depth camera axes
+     * remapped like the joints, mm -> cm) and folds them into the grid at NowSeconds.
+     */
+    void Integrate(const uint16* Depth, int32 Width, int32 Height, const FAzureDepthRayTable& Rays,
+                   const FTransform& SensorToWorld, double NowSeconds);
+
+    FAzureOccupancyZoneResult QueryZone(const FBox& WorldBox) const;
+
+    /** Top-down map over the volume's X/Y (row = Y), highest occupancy of each column, 0..255. */
+    const TArray<uint8>& GetHeatmap() const { return Heatmap; }
+    int32 GetHeatmapWidth() const { return Dims.X; }
+    int32 GetHeatmapHeight() const { return Dims.Y; }
+
+    int32 NumVoxels() const;
+    int32 NumOccupiedVoxels() const { return OccupiedKeys.Num() + BackgroundKeys.Num(); }
+    int32 NumBackgroundVoxels() const { return BackgroundKeys.Num(); }
+
+private:
+    static constexpr int32 NumShards = 16;
+    static constexpr int32 NumBands = 16;
+
+    struct FVoxel
+    {
+        float  Value = 0.f;
+        float  Background = 0.f; // share of the recent past spent occupied, as of Seconds
+        double Seconds = 0.0;
+    };
+
+    static uint32 PackKey(int32 X, int32 Y, int32 Z) { return (uint32)X | ((uint32)Y << 10) | ((uint32)Z << 20); }
+    static FIntVector UnpackKey(uint32 Key) { return FIntVector(Key & 1023, (Key >> 10) & 1023, Key >> 20); }
+    static int32 ShardOf(uint32 Key) { return (int32)((Key * 2654435761u) >> 28); }
+
+    float Decayed(const FVoxel& Voxel, double NowSeconds) const;
+    float BackgroundAt(const FVoxel& Voxel, double NowSeconds) const;
+    void UpdateSummary(double NowSeconds);
+
+    FSettings Settings;
+    FIntVector Dims = FIntVector::ZeroValue;
+    double LastPruneSeconds = 0.0;
+
+    TMap<uint32, FVoxel> Shards[NumShards];
+
+    // Per-frame scratch, kept to avoid reallocating
+    TArray<uint32> BandKeys[NumBands];
+    TArray<TPair<uint32, int32>> BandHits[NumBands];
+    TArray<TPair<uint32, int32>> ShardHits[NumShards];
+
+    // Summary of the last Integrate
+    TArray<uint32> OccupiedKeys;     // not background
+    TArray<uint32> BackgroundKeys;
+    TArray<uint8> Heatmap;
+
+    // QueryZone scratch
+    mutable TArray<uint8> ZoneColumns;
+    mutable TArray<int32> ZoneStack;
+};
@@ -0,0 +1,208 @@
+// AzureScoredSelector.h
+#pragma once
+#include "CoreMinimal.h"
+#include "AzureBodySnapshot.h"
+
+/**
+ * Per-body inputs for scored selection. Everything comes from the frame snapshot,
+ * so synthetic samples can be fed in directly.
+ */
+struct FAzureScoredBodySample
+{
+    int32     BodyId = -1;
+    FVector3f Pelvis_mm = FVector3f::ZeroVector;     // Azure camera space
+    FVector3f PelvisWorld = FVector3f::ZeroVector;   // world, cm
+    FVector3f Facing = FVector3f(0.f, 0.f, -1.f);    // unit body forward, Azure camera space
+    float     Confidence = 0.f;                      // 0..1
+};
+
+struct FAzureScoredSelectorSettings
+{
+    float DistanceWeight = 1.f;
+    float ZoneWeight = 1.f;
+    float FacingWeight = 1.f;
+    float ConfidenceWeight = 0.5f;
+    float DwellWeight = 0.5f;
+
+    float MaxDistanceMm = 4500.f;           // distance term is 0 at this range
+    FVector3f ZoneCenterWorld = FVector3f::ZeroVector;
+    float ZoneRadiusCm = 0.f;               // <= 0 disables the zone term
+    float DwellSaturationSeconds = 3.f;     // dwell term reaches 1 after this long in view
+
+    float SwitchMargin = 0.1f;              // challenger must beat the active score by this much
+    float MinHoldSeconds = 1.f;             // and the active must have held this long
+    float StickySeconds = 2.f;              // keep a vanished active this long before re-picking
+};
+
+/**
+ * Picks the active body by a weighted score (distance to sensor, distance to an
+ * interaction zone, facing the sensor, tracking confidence, time in view) with
+ * hysteresis so near-ties don't flap.
+ */
+class FAzureScoredSelector
+{
+public:
+    void Configure(const FAzureScoredSelectorSettings& InSettings) { Settings = InSettings; }
+
+    void Reset()
+    {
+        States.Reset();
+        ActiveId = -1;
+        ActiveSince = 0.f;
+    }
+
+    /** Builds a sample from a snapshot body: facing from the shoulders, refined by the head when it's tracked. */
+    static FAzureScoredBodySample MakeSample(const FAzureTrackedBody& Body)
+    {
+        const k4abt_joint_t* J = Body.Skeleton.joints;
+        auto P = [J](int32 Id) { return FVector3f(J[Id].position.xyz.x, J[Id].position.xyz.y, J[Id].position.xyz.z); };
+
+        FAzureScoredBodySample S;
+        S.BodyId = Body.PersonId;
+        S.Pelvis_mm = P(K4ABT_JOINT_PELVIS);
+        S.PelvisWorld = FVector3f(Body.JointsWorld[K4ABT_JOINT_PELVIS]);
+
+        // Body up x body right = forward (Azure camera space is right-handed, +Y down)
+        const FVector3f BodyUp = (P(K4ABT_JOINT_NECK) - P(K4ABT_JOINT_PELVIS)).GetSafeNormal();
+        const FVector3f Right = (P(K4ABT_JOINT_SHOULDER_RIGHT) - P(K4ABT_JOINT_SHOULDER_LEFT)).GetSafeNormal();
+        FVector3f Facing = FVector3f::CrossProduct(BodyUp, Right).GetSafeNormal();
+
+        if (J[K4ABT_JOINT_NOSE].confidence_level >= K4ABT_JOINT_CONFIDENCE_MEDIUM)
+        {
+            const FVector3f HeadFwd = (P(K4ABT_JOINT_NOSE) - P(K4ABT_JOINT_HEAD)).GetSafeNormal();
+            Facing = (Facing + HeadFwd).GetSafeNormal(KINDA_SMALL_NUMBER, Facing);
+        }
+        S.Facing = Facing;
+
+        float Sum = 0.f;
+        for (int32 i = 0; i < K4ABT_JOINT_COUNT; ++i)
+        {
+            Sum += FMath::Min((float)J[i].confidence_level, (float)K4ABT_JOINT_CONFIDENCE_MEDIUM) / (float)K4ABT_JOINT_CONFIDENCE_MEDIUM;
+        }
+        S.Confidence = Sum / K4ABT_JOINT_COUNT;
+        return S;
+    }
+
+    /** Weighted score in 0..1 for one body that has been in view for DwellSeconds. */
+    static float Score(const FAzureScoredBodySample& B, float DwellSeconds, const FAzureScoredSelectorSettings& Cfg)
+    {
+        const float Dist = B.Pelvis_mm.Size();
+        const float DistanceTerm = 1.f - FMath::Clamp(Dist / FMath::Max(Cfg.MaxDistanceMm, 1.f), 0.f, 1.f);
+
+        // 1 inside the zone, falling to 0 one radius outside it
+        float ZoneTerm = 0.f;
+        float ZoneWeight = 0.f;
+        if (Cfg.ZoneRadiusCm > 0.f)
+        {
+            const float ToZone = FVector3f::Dist(B.PelvisWorld, Cfg.ZoneCenterWorld);
+            ZoneTerm = 1.f - FMath::Clamp((ToZone - Cfg.ZoneRadiusCm) / Cfg.ZoneRadiusCm, 0.f, 1.f);
+            ZoneWeight = Cfg.ZoneWeight;
+        }
+
+        // Facing the sensor = forward pointing back along the pelvis ray
+        const FVector3f ToSensor = Dist > KINDA_SMALL_NUMBER ? -B.Pelvis_mm / Dist : FVector3f(0.f, 0.f, -1.f);
+        const float FacingTerm = FMath::Clamp(FVector3f::DotProduct(B.Facing, ToSensor), 0.f, 1.f);
+
+        const float DwellTerm = FMath::Clamp(DwellSeconds / FMath::Max(Cfg.DwellSaturationSeconds, KINDA_SMALL_NUMBER), 0.f, 1.f);
+
+        const float WeightSum = Cfg.DistanceWeight + ZoneWeight + Cfg.FacingWeight + Cfg.ConfidenceWeight + Cfg.DwellWeight;
+        if (WeightSum <= KINDA_SMALL_NUMBER)
+        {
+            return 0.f;
+        }
+
+        return (Cfg.DistanceWeight * DistanceTerm
+              + ZoneWeight * ZoneTerm
+              + Cfg.FacingWeight * FacingTerm
+              + Cfg.ConfidenceWeight * FMath::Clamp(B.Confidence, 0.f, 1.f)
+              + Cfg.DwellWeight * DwellTerm) / WeightSum;
+    }
+
+    /** Returns the suggested ActiveId (or -1). */
+    int32 Update(const TArray<FAzureScoredBodySample>& Bodies, float NowSeconds)
+    {
+        int32 BestId = -1;
+        float BestScore = -1.f;
+        float ActiveScore = -1.f;
+
+        for (const FAzureScoredBodySample& B : Bodies)
+        {
+            if (B.BodyId < 0) continue;
+
+            FBodyState& S = States.FindOrAdd(B.BodyId);
+            if (S.LastSeen <= 0.f || (NowSeconds - S.LastSeen) > Settings.StickySeconds)
+            {
+                S.FirstSeen = NowSeconds; // (re)entered view
+            }
+            S.LastSeen = NowSeconds;
+            S.LastScore = Score(B, NowSeconds - S.FirstSeen, Settings);
+
+            if (S.LastScore > BestScore) { BestScore = S.LastScore; BestId = B.BodyId; }
+            if (B.BodyId == ActiveId) { ActiveScore = S.LastScore; }
+        }
+
+        if (ActiveId >= 0 && ActiveScore < 0.f)
+        {
+            // Active not in this frame: hold it for a while before giving up
+            const FBodyState* SActive = States.Find(ActiveId);
+            if (SActive && (NowSeconds - SActive->LastSeen) <= Settings.StickySeconds)
+            {
+                PruneStale(NowSeconds);
+                return ActiveId;
+            }
+            ActiveId = -1;
+        }
+
+        if (ActiveId < 0)
+        {
+            if (BestId >= 0)
+            {
+                ActiveId = BestId;
+                ActiveSince = NowSeconds;
+            }
+        }
+        else if (BestId != ActiveId
+              && BestScore > ActiveScore + Settings.SwitchMargin
+              && (NowSeconds - ActiveSince) >= Settings.MinHoldSeconds)
+        {
+            ActiveId = BestId;
+            ActiveSince = NowSeconds;
+        }
+
+        PruneStale(NowSeconds);
+        return ActiveId;
+    }
+
+    int32 GetActiveId() const { return ActiveId; }
+
+    /** Last computed score of a body, or -1 if unknown. */
+    float GetScore(int32 BodyId) const
+    {
+        const FBodyState* S = States.Find(BodyId);
+        return S ? S->LastScore : -1.f;
+    }
+
+private:
+    struct FBodyState
+    {
+        float FirstSeen = 0.f;
+        float LastSeen = 0.f;
+        float LastScore = 0.f;
+    };
+
+    void PruneStale(float NowSeconds)
+    {
+        for (auto It = States.CreateIterator(); It; ++It)
+        {
+            if ((NowSeconds - It->Value.LastSeen) > 5.f)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    FAzureScoredSelectorSettings Settings;
+    TMap<int32, FBodyState> States;
+    int32 ActiveId = -1;
+    float ActiveSince = 0.f;
+};
@@ -0,0 +1,109 @@
+// AzureSkeletonStream.h
+#pragma once
+#include "CoreMinimal.h"
+#include "AzureBodySnapshot.h"
+
+/**
+ * Wire format for streaming skeletons to other machines, one UDP datagram per tracker frame.
+ *
+ * Positions are sensor-space fixed point (0.25 mm, int16). A body is sent either as a keyframe
+ * (absolute positions) or as a delta against its last keyframe: int8 per axis where that fits,
+ * int16 otherwise. Deltas always reference a keyframe, never the previous packet, so one lost
+ * datagram costs one frame and not the stream. Orientations are smallest-three quaternions in
+ * 32 bits, confidence is 2 bits per joint, the sender's selection score one byte per body.
+ * Placement (the sender's AzureCameraTransform) rides along so receivers can reproduce the
+ * sender's world positions. Every encoder picks a random session id: a receiver that sees a new
+ * one starts over instead of taking the restarted sender's low sequence numbers for late packets.
+ */
+namespace AzureStream
+{
+    constexpr uint32 Magic = 0x314B5341; // "ASK1"
+    constexpr uint8  Version = 2;
+
+    /**
+     * Default UDP port of senders and receivers. Clear of the ports UE uses itself: game and
+     * listen servers (7777 up), beacons (15000) and UDP messaging (6666).
+     */
+    constexpr int32 DefaultPort = 37770;
+
+    /** Everything in a packet besides the bodies. */
+    struct FHeader
+    {
+        uint32 SessionId = 0;                           // random per encoder (per sender run)
+        uint32 Sequence = 0;
+        uint64 SensorTimestampUsec = 0;
+        int64  SendUtcTicks = 0;                        // FDateTime ticks; latency needs synced clocks (or loopback)
+        int32  ActiveBodyId = -1;
+        int32  TrackedBodyId = -1;
+        FTransform CameraTransform = FTransform::Identity;
+    };
+}
+
+/** Sender side. Remembers each person's last keyframe. Not thread-safe. */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureSkeletonEncoder
+{
+public:
+    FAzureSkeletonEncoder() { Reset(); }
+
+    /** A body gets a fresh keyframe at least every KeyframeInterval packets. */
+    void Configure(int32 InKeyframeInterval) { KeyframeInterval = FMath::Max(1, InKeyframeInterval); }
+
+    /** Starts a new session: receivers drop what they kept from the previous one. */
+    void Reset();
+
+    /**
+     * Encodes Snapshot (PersonIds are sent) into OutPacket; Header.SessionId and Sequence are
+     * assigned here. BodyScores (optional) holds a selection score (0..1) per Snapshot body,
+     * negative where there is none.
+     */
+    void Encode(const FAzureFrameSnapshot& Snapshot, AzureStream::FHeader& Header, TArray<uint8>& OutPacket,
+                TArrayView<const float> BodyScores = TArrayView<const float>());
+
+private:
+    struct FKeyframe
+    {
+        uint32 Sequence = 0;
+        int16  Q[K4ABT_JOINT_COUNT][3];
+        uint32 LastSeenSequence = 0;
+    };
+
+    TMap<int32, FKeyframe> Keyframes;
+    uint32 SessionId = 0;
+    uint32 NextSequence = 1;
+    int32  KeyframeInterval = 15;
+};
+
+/** Receiver side. Bodies whose keyframe was lost are skipped until the next one arrives. Not thread-safe. */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureSkeletonDecoder
+{
+public:
+    void Reset();
+
+    /**
+     * Decodes one datagram. Returns false for malformed or stale (out of order) packets.
+     * OutSnapshot bodies have BodyId == PersonId, JointsWorld is left for the caller.
+     * OutBodyScores (optional) gets the sender's selection score per body, -1 where unknown.
+     */
+    bool Decode(const uint8* Data, int32 Size, AzureStream::FHeader& OutHeader, FAzureFrameSnapshot& OutSnapshot,
+                TArray<float>* OutBodyScores = nullptr);
+
+    /** Sequence gaps seen so far. */
+    int32 GetLostPackets() const { return LostPackets; }
+
+    /** Delta bodies dropped because their keyframe never arrived. */
+    int32 GetUndecodableBodies() const { return UndecodableBodies; }
+
+private:
+    struct FKeyframe
+    {
+        uint32 Sequence = 0;
+        int16  Q[K4ABT_JOINT_COUNT][3];
+        uint32 LastSeenSequence = 0;
+    };
+
+    TMap<int32, FKeyframe> Keyframes;
+    uint32 SessionId = 0;
+    uint32 LastSequence = 0;
+    int32 LostPackets = 0;
+    int32 UndecodableBodies = 0;
+};
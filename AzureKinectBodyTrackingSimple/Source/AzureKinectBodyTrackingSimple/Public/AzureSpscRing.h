@@ -0,0 +1,57 @@
+// AzureSpscRing.h
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Fixed-capacity lock-free ring for exactly one producer thread and one consumer thread.
+ * Push never blocks: when the ring is full the new item is rejected and the caller decides.
+ */
+template<typename T, uint32 Capacity>
+class TAzureSpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /** Producer side. Returns false (and drops Item) if the consumer fell a full ring behind. */
+    bool Push(const T& Item)
+    {
+        const uint32 Head = HeadIndex.load(std::memory_order_relaxed);
+        const uint32 Tail = TailIndex.load(std::memory_order_acquire);
+        if (Head - Tail >= Capacity)
+        {
+            return false;
+        }
+
+        Items[Head & (Capacity - 1)] = Item;
+        HeadIndex.store(Head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer side. Returns false if nothing is waiting. */
+    bool Pop(T& OutItem)
+    {
+        const uint32 Tail = TailIndex.load(std::memory_order_relaxed);
+        const uint32 Head = HeadIndex.load(std::memory_order_acquire);
+        if (Tail == Head)
+        {
+            return false;
+        }
+
+        OutItem = Items[Tail & (Capacity - 1)];
+        TailIndex.store(Tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Approximate number of queued items (exact only from the consumer thread). */
+    uint32 Num() const
+    {
+        return HeadIndex.load(std::memory_order_acquire) - TailIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    // Producer and consumer indices on separate cache lines so they don't false-share
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> HeadIndex{ 0 };
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> TailIndex{ 0 };
+    T Items[Capacity];
+};
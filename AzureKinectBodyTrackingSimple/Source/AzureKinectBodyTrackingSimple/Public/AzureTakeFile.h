@@ -0,0 +1,101 @@
+// AzureTakeFile.h
+#pragma once
+#include "CoreMinimal.h"
+#include "AzureBodySnapshot.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Skeleton take file (.aktake). Every frame is a fixed-size record, so frame i lives at
+ * HeaderSize + i * FrameStride and the whole file can be memory-mapped and read in place.
+ *
+ *   FHeader | frame 0 | frame 1 | ... | time index (uint32 per bucket)
+ *
+ * The time index maps each IndexBucketUsec slice of the take to the last frame at or before
+ * it, so seeking by time is one lookup plus a step or two. FrameCount/IndexOffset are filled in
+ * when recording stops; a file left without them still plays (the reader derives both).
+ */
+namespace AzureTake
+{
+    constexpr uint32 Magic = 0x4B544B41; // "AKTK"
+    constexpr uint32 Version = 1;
+    constexpr int32  MaxBodies = 6;      // bodies beyond this in one frame are not recorded
+    constexpr uint32 IndexBucketUsec = 100000;
+
+    struct FHeader
+    {
+        uint32 Magic = AzureTake::Magic;
+        uint32 Version = AzureTake::Version;
+        uint32 MaxBodies = AzureTake::MaxBodies;
+        uint32 FrameStride = 0;
+        uint64 FrameCount = 0;
+        uint64 FirstTimestampUsec = 0;
+        uint64 IndexOffset = 0;
+        uint32 IndexBucketUsec = AzureTake::IndexBucketUsec;
+        uint32 IndexCount = 0;
+        uint8  Reserved[16] = {};
+    };
+    static_assert(sizeof(FHeader) == 64, "take header layout is part of the file format");
+
+    struct FBodyRecord
+    {
+        int32 BodyId;
+        int32 PersonId;
+        k4abt_skeleton_t Skeleton;
+    };
+
+    struct FFrameRecord
+    {
+        uint64 TimestampUsec;
+        uint32 BodyCount;
+        uint32 Reserved;
+        FBodyRecord Bodies[MaxBodies];
+    };
+
+    /** Fills a record from a snapshot (unused body slots are zeroed). */
+    AZUREKINECTBODYTRACKINGSIMPLE_API void MakeFrameRecord(const FAzureFrameSnapshot& Snapshot, FFrameRecord& OutRecord);
+
+    /** Builds the time index over a run of timestamps. */
+    AZUREKINECTBODYTRACKINGSIMPLE_API void BuildTimeIndex(TArrayView<const uint64> Timestamps, uint32 BucketUsec, TArray<uint32>& OutIndex);
+}
+
+/** Read-only, memory-mapped (or fully loaded, where mapping isn't available) take. */
+class AZUREKINECTBODYTRACKINGSIMPLE_API FAzureTakeReader
+{
+public:
+    ~FAzureTakeReader();
+
+    bool Open(const FString& Path);
+    void Close();
+
+    bool IsOpen() const { return Base != nullptr; }
+    int32 NumFrames() const { return FrameCount; }
+
+    /** Sensor time between the first and last frame. */
+    double GetDurationSeconds() const;
+
+    /** Sensor time of frame Index relative to the first frame. */
+    uint64 GetFrameTimeUsec(int32 Index) const;
+
+    /** O(1): the last frame at or before TimeUsec (relative to the take start). */
+    int32 FindFrameAtTime(uint64 TimeUsec) const;
+
+    /** Copies frame Index into OutSnapshot (raw skeletons; JointsWorld isn't filled). */
+    bool ReadFrame(int32 Index, FAzureFrameSnapshot& OutSnapshot) const;
+
+private:
+    const AzureTake::FFrameRecord& Frame(int32 Index) const
+    {
+        return *reinterpret_cast<const AzureTake::FFrameRecord*>(Base + sizeof(AzureTake::FHeader) + (int64)Index * sizeof(AzureTake::FFrameRecord));
+    }
+
+    IMappedFileHandle* MappedFile = nullptr;
+    IMappedFileRegion* MappedRegion = nullptr;
+    TArray64<uint8> Loaded;             // fallback when the platform can't map
+    const uint8* Base = nullptr;
+
+    AzureTake::FHeader Header;
+    int32 FrameCount = 0;
+    TArray<uint32> TimeIndex;
+};
@@ -0,0 +1,36 @@
+// k4abt.h (stand-in)
+// Header-only replacement for the Azure Kinect Body Tracking SDK on platforms it doesn't ship on.
+// A tracker can never be created (there's no device to calibrate it from), so every frame
+// the plugin sees off Windows comes from recordings or synthetic data.
+#pragma once
+#include <k4a/k4a.h>
+#include "k4abttypes.h"
+
+struct _k4abt_tracker_t {};
+struct _k4abt_frame_t {};
+
+inline k4a_result_t k4abt_tracker_create(const k4a_calibration_t*, k4abt_tracker_configuration_t, k4abt_tracker_t* tracker_handle)
+{
+    *tracker_handle = nullptr;
+    return K4A_RESULT_FAILED;
+}
+
+inline void k4abt_tracker_destroy(k4abt_tracker_t) {}
+inline void k4abt_tracker_set_temporal_smoothing(k4abt_tracker_t, float) {}
+inline void k4abt_tracker_shutdown(k4abt_tracker_t) {}
+inline k4a_wait_result_t k4abt_tracker_enqueue_capture(k4abt_tracker_t, k4a_capture_t, int32_t) { return K4A_WAIT_RESULT_FAILED; }
+inline k4a_wait_result_t k4abt_tracker_pop_result(k4abt_tracker_t, k4abt_frame_t* body_frame_handle, int32_t)
+{
+    *body_frame_handle = nullptr;
+    return K4A_WAIT_RESULT_FAILED;
+}
+
+inline void k4abt_frame_reference(k4abt_frame_t) {}
+inline void k4abt_frame_release(k4abt_frame_t) {}
+inline uint32_t k4abt_frame_get_num_bodies(k4abt_frame_t) { return 0; }
+inline k4a_result_t k4abt_frame_get_body_skeleton(k4abt_frame_t, uint32_t, k4abt_skeleton_t*) { return K4A_RESULT_FAILED; }
+inline uint32_t k4abt_frame_get_body_id(k4abt_frame_t, uint32_t) { return K4ABT_INVALID_BODY_ID; }
+inline uint64_t k4abt_frame_get_device_timestamp_usec(k4abt_frame_t) { return 0; }
+inline uint64_t k4abt_frame_get_system_timestamp_nsec(k4abt_frame_t) { return 0; }
+inline k4a_image_t k4abt_frame_get_body_index_map(k4abt_frame_t) { return nullptr; }
+inline k4a_capture_t k4abt_frame_get_capture(k4abt_frame_t) { return nullptr; }
@@ -10,6 +10,20 @@ public class AzureKinectSimple : ModuleRules
         PublicDependencyModuleNames.AddRange(new string[] {
             "Core", "CoreUObject", "Engine", "RHI", "RenderCore"
         });
+        // MJPEG decode for the non-BGRA color formats
+        PrivateDependencyModuleNames.AddRange(new string[] {
+            "ImageWrapper"
+        });
+
+        // The SDK only ships for Windows. Elsewhere (Linux build agents) compile against the
+        // header-only stand-in: no device is ever found, everything else builds and runs.
+        if (Target.Platform != UnrealTargetPlatform.Win64)
+        {
+            PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "ThirdParty", "AzureKinectStandIn", "include"));
+            PublicDefinitions.Add("WITH_AZUREKINECT_SDK=0");
+            return;
+        }
+        PublicDefinitions.Add("WITH_AZUREKINECT_SDK=1");
 
         // Look up the SDK root
         string SDK = Environment.GetEnvironmentVariable("AZUREKINECT_SDK");
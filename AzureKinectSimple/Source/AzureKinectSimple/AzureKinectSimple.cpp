@@ -1,5 +1,25 @@
 // AzureKinectSimple.cpp
 #include "Modules/ModuleManager.h"
+#include "AzureKinectStats.h"
+
+DEFINE_LOG_CATEGORY(LogAzureKinect);
+
+DEFINE_STAT(STAT_AzureKinect_Tick);
+DEFINE_STAT(STAT_AzureKinect_CaptureWait);
+DEFINE_STAT(STAT_AzureKinect_ColorUpload);
+DEFINE_STAT(STAT_AzureKinect_ColorDecode);
+DEFINE_STAT(STAT_AzureKinect_DepthConvert);
+DEFINE_STAT(STAT_AzureKinect_DepthFilter);
+DEFINE_STAT(STAT_AzureKinect_CaptureMode);
+DEFINE_STAT(STAT_AzureKinect_SavedCpu);
+DEFINE_STAT(STAT_AzureKinect_FramePoolMemory);
+
+TRACE_DECLARE_INT_COUNTER(AzureKinect_ColorDecodesInFlight, TEXT("AzureKinect/Color Decodes In Flight"));
+TRACE_DECLARE_INT_COUNTER(AzureKinect_ColorFramesDropped, TEXT("AzureKinect/Color Frames Dropped"));
+TRACE_DECLARE_INT_COUNTER(AzureKinect_CaptureMode, TEXT("AzureKinect/Capture Mode"));
+TRACE_DECLARE_FLOAT_COUNTER(AzureKinect_SavedCpuMs, TEXT("AzureKinect/Saved CPU (ms per s)"));
+TRACE_DECLARE_MEMORY_COUNTER(AzureKinect_FramePoolBytes, TEXT("AzureKinect/Frame Pool"));
+TRACE_DECLARE_INT_COUNTER(AzureKinect_FramePoolMisses, TEXT("AzureKinect/Frame Pool Misses"));
 
 class FAzureKinectSimpleModule : public IModuleInterface
 {
@@ -7,7 +27,7 @@ public:
     // Called right after the module DLL is loaded and before any UObject
     virtual void StartupModule() override
     {
-        UE_LOG(LogTemp, Log, TEXT("AzureKinectSimple loaded"));
+        UE_LOG(LogAzureKinect, Log, TEXT("AzureKinectSimple loaded"));
     }
 
     // Called before the module is unloaded, right before the DLL is freed
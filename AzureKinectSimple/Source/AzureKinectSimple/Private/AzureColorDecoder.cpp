@@ -0,0 +1,180 @@
+#include "AzureColorDecoder.h"
+#include "AzureFramePool.h"
+#include "AzureKinectStats.h"
+#include "Async/Async.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+
+FAzureColorDecoder::FAzureColorDecoder(int32 InMaxInFlight)
+    : MaxInFlight(FMath::Max(1, InMaxInFlight))
+{
+    // Load on the game thread; workers only create wrappers from it.
+    ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+    // Frames in circulation: decoding, latest, held by the caller, one spare
+    FreePixels.Reserve(MaxInFlight + 3);
+}
+
+FAzureColorDecoder::~FAzureColorDecoder()
+{
+    Flush();
+}
+
+void FAzureColorDecoder::Flush()
+{
+    while (InFlight.GetValue() > 0)
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+}
+
+bool FAzureColorDecoder::Submit(k4a_image_format_t Format, const uint8* Data, int32 SizeBytes,
+                                int32 Width, int32 Height, int32 StrideBytes, uint64 TimestampUsec)
+{
+    if (!Data || SizeBytes <= 0 || Width <= 0 || Height <= 0)
+    {
+        return false;
+    }
+
+    // Drop instead of queueing: a late frame is worse than a skipped one.
+    if (InFlight.Increment() > MaxInFlight)
+    {
+        InFlight.Decrement();
+        DroppedFrames.Increment();
+        return false;
+    }
+
+    // The k4a image is released right after this call, so the worker gets its own copy.
+    FAzureFrameBuffer* Source = FAzureFramePool::Get().Acquire(SizeBytes);
+    FMemory::Memcpy(Source->Data, Data, SizeBytes);
+
+    Async(EAsyncExecution::TaskGraph,
+        [this, Format, Source, Width, Height, StrideBytes, TimestampUsec]()
+        {
+            Decode(Format, *Source, Width, Height, StrideBytes, TimestampUsec);
+            FAzureFramePool::Get().Release(Source);
+            InFlight.Decrement();
+        });
+
+    return true;
+}
+
+void FAzureColorDecoder::Decode(k4a_image_format_t Format, const FAzureFrameBuffer& Source,
+                                int32 Width, int32 Height, int32 StrideBytes, uint64 TimestampUsec)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureKinect_ColorDecode);
+
+    FDecodedFrame Frame;
+    Frame.Width = Width;
+    Frame.Height = Height;
+    Frame.TimestampUsec = TimestampUsec;
+    if (Format != K4A_IMAGE_FORMAT_COLOR_MJPG && Format != K4A_IMAGE_FORMAT_COLOR_NV12)
+    {
+        DroppedFrames.Increment();
+        return;
+    }
+    {
+        FScopeLock Lock(&LatestLock);
+        if (FreePixels.Num() > 0)
+        {
+            Frame.Pixels = FreePixels.Pop(false);
+        }
+    }
+
+    if (Format == K4A_IMAGE_FORMAT_COLOR_MJPG)
+    {
+        if (!DecodeJpegToBgra(Source.Data, Source.Size, Frame.Pixels, Frame.Width, Frame.Height))
+        {
+            // The buffer goes back to the pool even though the frame is lost
+            DroppedFrames.Increment();
+            if (Frame.Pixels.Max() > 0)
+            {
+                FScopeLock Lock(&LatestLock);
+                FreePixels.Add(MoveTemp(Frame.Pixels));
+            }
+            return;
+        }
+    }
+    else
+    {
+        Frame.Pixels.SetNumUninitialized((int64)Width * Height * 4, false);
+        ConvertNv12ToBgra(Source.Data, Width, Height, StrideBytes, Frame.Pixels.GetData());
+    }
+
+    FScopeLock Lock(&LatestLock);
+    if (TimestampUsec < LatestTimestampUsec)
+    {
+        // A newer frame already finished on another worker.
+        FreePixels.Add(MoveTemp(Frame.Pixels));
+        return;
+    }
+    if (Latest.Pixels.Max() > 0)
+    {
+        // Replaced before it was consumed, or what the caller swapped back in
+        FreePixels.Add(MoveTemp(Latest.Pixels));
+    }
+    Latest = MoveTemp(Frame);
+    LatestTimestampUsec = TimestampUsec;
+    bHasLatest = true;
+}
+
+bool FAzureColorDecoder::DecodeJpegToBgra(const uint8* Jpeg, int64 SizeBytes, TArray64<uint8>& OutBgra, int32& OutWidth, int32& OutHeight) const
+{
+    // ImageWrapper's JPEG path is backed by libjpeg-turbo on desktop platforms.
+    TSharedPtr<IImageWrapper> Wrapper = ImageWrapperModule->CreateImageWrapper(EImageFormat::JPEG);
+    if (!Wrapper.IsValid() || !Wrapper->SetCompressed(Jpeg, SizeBytes) || !Wrapper->GetRaw(ERGBFormat::BGRA, 8, OutBgra))
+    {
+        return false;
+    }
+    OutWidth = Wrapper->GetWidth();
+    OutHeight = Wrapper->GetHeight();
+    return true;
+}
+
+bool FAzureColorDecoder::ConsumeLatest(TArray64<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+{
+    FScopeLock Lock(&LatestLock);
+    if (!bHasLatest)
+    {
+        return false;
+    }
+
+    // Swap instead of copying a full frame under the lock.
+    Swap(OutPixels, Latest.Pixels);
+    OutWidth = Latest.Width;
+    OutHeight = Latest.Height;
+    bHasLatest = false;
+    return true;
+}
+
+void FAzureColorDecoder::ConvertNv12ToBgra(const uint8* Nv12, int32 Width, int32 Height, int32 StrideBytes, uint8* OutBgra)
+{
+    // NV12: full-res Y plane followed by a half-res interleaved UV plane, both with the same stride.
+    const uint8* YPlane = Nv12;
+    const uint8* UVPlane = Nv12 + (int64)StrideBytes * Height;
+
+    for (int32 y = 0; y < Height; ++y)
+    {
+        const uint8* YRow = YPlane + (int64)y * StrideBytes;
+        const uint8* UVRow = UVPlane + (int64)(y >> 1) * StrideBytes;
+        uint8* Dst = OutBgra + (int64)y * Width * 4;
+
+        for (int32 x = 0; x < Width; ++x)
+        {
+            // BT.601 limited range, 8.8 fixed point
+            const int32 C = (int32)YRow[x] - 16;
+            const int32 D = (int32)UVRow[x & ~1] - 128;
+            const int32 E = (int32)UVRow[(x & ~1) + 1] - 128;
+
+            const int32 R = (298 * C + 409 * E + 128) >> 8;
+            const int32 G = (298 * C - 100 * D - 208 * E + 128) >> 8;
+            const int32 B = (298 * C + 516 * D + 128) >> 8;
+
+            Dst[x * 4 + 0] = (uint8)FMath::Clamp(B, 0, 255);
+            Dst[x * 4 + 1] = (uint8)FMath::Clamp(G, 0, 255);
+            Dst[x * 4 + 2] = (uint8)FMath::Clamp(R, 0, 255);
+            Dst[x * 4 + 3] = 255;
+        }
+    }
+}
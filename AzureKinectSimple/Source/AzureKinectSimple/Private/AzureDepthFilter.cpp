@@ -0,0 +1,220 @@
+#include "AzureDepthFilter.h"
+#include "AzureKinectStats.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr int32 RowsPerTile = 32;
+
+    FORCEINLINE uint16 Median3(uint16 A, uint16 B, uint16 C)
+    {
+        return FMath::Max(FMath::Min(A, B), FMath::Min(FMath::Max(A, B), C));
+    }
+}
+
+void FAzureDepthFilter::Configure(const FSettings& InSettings)
+{
+    Settings = InSettings;
+    Settings.FlyingPixelMinNeighbours = FMath::Clamp(Settings.FlyingPixelMinNeighbours, 1, 8);
+    Settings.TemporalAlpha = FMath::Clamp(Settings.TemporalAlpha, 0.01f, 1.f);
+    Settings.HoldFrames = FMath::Clamp(Settings.HoldFrames, 0, 30);
+    Settings.HoleFillRadius = FMath::Clamp(Settings.HoleFillRadius, 1, 16);
+}
+
+void FAzureDepthFilter::Reset()
+{
+    Width = 0;
+    Height = 0;
+    Smoothed.Reset();
+    History1.Reset();
+    History2.Reset();
+    Age.Reset();
+    Filtered.Reset();
+}
+
+void FAzureDepthFilter::Process(const uint16* Depth, int32 InWidth, int32 InHeight, TArray<uint16>& OutDepth)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureKinect_DepthFilter);
+
+    const int32 NumPixels = InWidth * InHeight;
+    if (!Depth || NumPixels <= 0)
+    {
+        OutDepth.Reset();
+        return;
+    }
+
+    if (InWidth != Width || InHeight != Height)
+    {
+        Width = InWidth;
+        Height = InHeight;
+        Smoothed.SetNumZeroed(NumPixels);
+        History1.SetNumZeroed(NumPixels);
+        History2.SetNumZeroed(NumPixels);
+        Age.SetNumZeroed(NumPixels);
+        Filtered.SetNumUninitialized(NumPixels);
+    }
+    OutDepth.SetNumUninitialized(NumPixels, false);
+
+    // Two passes: the hole fill reads rows the first pass wrote in other tiles
+    const int32 NumTiles = FMath::DivideAndRoundUp(Height, RowsPerTile);
+    const EParallelForFlags Flags = Settings.bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+    ParallelFor(NumTiles, [this, Depth](int32 Tile)
+    {
+        FilterRows(Depth, Tile * RowsPerTile, FMath::Min(Height, (Tile + 1) * RowsPerTile));
+    }, Flags);
+
+    if (!Settings.bFillHoles)
+    {
+        FMemory::Memcpy(OutDepth.GetData(), Filtered.GetData(), NumPixels * sizeof(uint16));
+        return;
+    }
+
+    uint16* Out = OutDepth.GetData();
+    ParallelFor(NumTiles, [this, Out](int32 Tile)
+    {
+        FillRows(Tile * RowsPerTile, FMath::Min(Height, (Tile + 1) * RowsPerTile), Out);
+    }, Flags);
+}
+
+bool FAzureDepthFilter::IsFlyingPixel(const uint16* Depth, int32 X, int32 Y) const
+{
+    const int32 D = Depth[Y * Width + X];
+    const int32 Threshold = (int32)(Settings.FlyingPixelThresholdMm + Settings.FlyingPixelThresholdRatio * D);
+
+    // Missing neighbours count as disagreeing too: lone pixels next to holes are mostly noise
+    int32 Disagree = 0;
+    for (int32 Dy = -1; Dy <= 1; ++Dy)
+    {
+        const int32 Ny = Y + Dy;
+        if (Ny < 0 || Ny >= Height) continue;
+
+        const uint16* Row = Depth + Ny * Width;
+        for (int32 Dx = -1; Dx <= 1; ++Dx)
+        {
+            const int32 Nx = X + Dx;
+            if ((Dx == 0 && Dy == 0) || Nx < 0 || Nx >= Width) continue;
+
+            const int32 N = Row[Nx];
+            Disagree += (N == 0 || FMath::Abs(N - D) > Threshold) ? 1 : 0;
+        }
+    }
+    return Disagree >= Settings.FlyingPixelMinNeighbours;
+}
+
+void FAzureDepthFilter::FilterRows(const uint16* Depth, int32 RowBegin, int32 RowEnd)
+{
+    const float Alpha = Settings.TemporalAlpha;
+
+    for (int32 y = RowBegin; y < RowEnd; ++y)
+    {
+        for (int32 x = 0; x < Width; ++x)
+        {
+            const int32 i = y * Width + x;
+
+            uint16 D = Depth[i];
+            if (D != 0 && Settings.bRemoveFlyingPixels && IsFlyingPixel(Depth, x, y))
+            {
+                D = 0;
+            }
+
+            if (!Settings.bTemporal)
+            {
+                Filtered[i] = D;
+                continue;
+            }
+
+            // Median over time removes one-frame spikes; only when all three are valid
+            uint16 M = D;
+            if (Settings.bTemporalMedian && D != 0 && History1[i] != 0 && History2[i] != 0)
+            {
+                M = Median3(D, History1[i], History2[i]);
+            }
+            History2[i] = History1[i];
+            History1[i] = D;
+
+            float& S = Smoothed[i];
+            if (M == 0)
+            {
+                // Short dropouts keep the last value instead of flickering to black
+                if (S > 0.f && ++Age[i] <= Settings.HoldFrames)
+                {
+                    Filtered[i] = (uint16)(S + 0.5f);
+                }
+                else
+                {
+                    S = 0.f;
+                    Age[i] = 0;
+                    Filtered[i] = 0;
+                }
+                continue;
+            }
+
+            Age[i] = 0;
+            const float Threshold = Settings.MotionThresholdMm + Settings.MotionThresholdRatio * M;
+            if (S <= 0.f || FMath::Abs(M - S) > Threshold)
+            {
+                S = M; // something moved: don't drag the old surface along
+            }
+            else
+            {
+                S += Alpha * (M - S);
+            }
+            Filtered[i] = (uint16)(S + 0.5f);
+        }
+    }
+}
+
+void FAzureDepthFilter::FillRows(int32 RowBegin, int32 RowEnd, uint16* OutDepth) const
+{
+    const int32 R = Settings.HoleFillRadius;
+    const int32 MaxStep = (int32)Settings.HoleFillMaxStepMm;
+
+    // Nearest valid value from (X,Y) stepping by (Sx,Sy), or 0
+    auto Scan = [this, R](int32 X, int32 Y, int32 Sx, int32 Sy) -> int32
+    {
+        for (int32 k = 1; k <= R; ++k)
+        {
+            const int32 Nx = X + Sx * k;
+            const int32 Ny = Y + Sy * k;
+            if (Nx < 0 || Nx >= Width || Ny < 0 || Ny >= Height) return 0;
+            if (const uint16 V = Filtered[Ny * Width + Nx]) return V;
+        }
+        return 0;
+    };
+
+    for (int32 y = RowBegin; y < RowEnd; ++y)
+    {
+        for (int32 x = 0; x < Width; ++x)
+        {
+            const int32 i = y * Width + x;
+            const uint16 V = Filtered[i];
+            if (V != 0)
+            {
+                OutDepth[i] = V;
+                continue;
+            }
+
+            // Needs support on both sides (so the sensor's field of view doesn't grow),
+            // and both sides on the same surface (so edges stay sharp)
+            int32 Best = 0;
+            int32 BestStep = MaxStep + 1;
+
+            const int32 L = Scan(x, y, -1, 0);
+            const int32 Rt = L ? Scan(x, y, 1, 0) : 0;
+            if (L && Rt && FMath::Abs(L - Rt) < BestStep)
+            {
+                BestStep = FMath::Abs(L - Rt);
+                Best = (L + Rt) / 2;
+            }
+
+            const int32 U = Scan(x, y, 0, -1);
+            const int32 Dn = U ? Scan(x, y, 0, 1) : 0;
+            if (U && Dn && FMath::Abs(U - Dn) < BestStep)
+            {
+                Best = (U + Dn) / 2;
+            }
+
+            OutDepth[i] = (uint16)Best;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#include "AzureFramePool.h"
+#include "AzureKinectStats.h"
+
+namespace
+{
+    // Header and data in one allocation, data cache-line aligned
+    constexpr int64 HeaderBytes = Align((int64)sizeof(FAzureFrameBuffer), 64);
+}
+
+FAzureFramePool& FAzureFramePool::Get()
+{
+    static FAzureFramePool Pool;
+    return Pool;
+}
+
+FAzureFramePool::~FAzureFramePool()
+{
+    // Blocks still in use at exit (e.g. queued on a dead render thread) are left alone.
+    // No stats here: the stats system may already be gone.
+    FreeUnused();
+}
+
+int32 FAzureFramePool::SizeClassOf(int64 Bytes)
+{
+    if (Bytes <= (1ll << MinOctave))
+    {
+        return 0;
+    }
+
+    // Four classes per octave: (2^Octave, 2^Octave * 1.25], ... (2^Octave * 1.75, 2^(Octave+1)]
+    const int32 Octave = (int32)FPlatformMath::FloorLog2_64((uint64)(Bytes - 1));
+    const int64 Step = (1ll << Octave) / 4;
+    const int32 Quarter = (int32)((Bytes - 1 - (1ll << Octave)) / Step);
+    return FMath::Min((Octave - MinOctave) * 4 + Quarter + 1, NumSizeClasses - 1);
+}
+
+int64 FAzureFramePool::CapacityOf(int32 SizeClass)
+{
+    if (SizeClass == 0)
+    {
+        return 1ll << MinOctave;
+    }
+    const int32 Octave = MinOctave + (SizeClass - 1) / 4;
+    const int32 Quarter = (SizeClass - 1) % 4;
+    return (1ll << Octave) + ((1ll << Octave) / 4) * (Quarter + 1);
+}
+
+FAzureFrameBuffer* FAzureFramePool::Allocate(int32 SizeClass)
+{
+    const int64 Capacity = CapacityOf(SizeClass);
+    uint8* Memory = static_cast<uint8*>(FMemory::Malloc(HeaderBytes + Capacity, 64));
+
+    FAzureFrameBuffer* Buffer = new (Memory) FAzureFrameBuffer();
+    Buffer->Data = Memory + HeaderBytes;
+    Buffer->Capacity = Capacity;
+    Buffer->SizeClass = SizeClass;
+
+    Stats.BytesAllocated += Capacity;
+    ++Stats.BlocksAllocated;
+    return Buffer;
+}
+
+FAzureFrameBuffer* FAzureFramePool::Acquire(int64 Bytes)
+{
+    check(Bytes <= (1ll << MaxOctave));
+    const int32 SizeClass = SizeClassOf(FMath::Max<int64>(1, Bytes));
+
+    FScopeLock ScopeLock(&Lock);
+    FAzureFrameBuffer* Buffer = FreeLists[SizeClass];
+    if (Buffer)
+    {
+        FreeLists[SizeClass] = Buffer->NextFree;
+        Buffer->NextFree = nullptr;
+    }
+    else
+    {
+        Buffer = Allocate(SizeClass);
+        ++Stats.Misses;
+    }
+
+    Buffer->Size = Bytes;
+    ++Stats.BlocksInUse;
+    UpdateStats();
+    return Buffer;
+}
+
+void FAzureFramePool::Release(FAzureFrameBuffer* Buffer)
+{
+    if (!Buffer)
+    {
+        return;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    Buffer->NextFree = FreeLists[Buffer->SizeClass];
+    FreeLists[Buffer->SizeClass] = Buffer;
+    --Stats.BlocksInUse;
+    UpdateStats();
+}
+
+void FAzureFramePool::Preallocate(int64 Bytes, int32 Count)
+{
+    if (Bytes <= 0 || Count <= 0)
+    {
+        return;
+    }
+    const int32 SizeClass = SizeClassOf(Bytes);
+
+    FScopeLock ScopeLock(&Lock);
+    int32 Free = 0;
+    for (FAzureFrameBuffer* It = FreeLists[SizeClass]; It; It = It->NextFree)
+    {
+        ++Free;
+    }
+    for (; Free < Count; ++Free)
+    {
+        FAzureFrameBuffer* Buffer = Allocate(SizeClass);
+        Buffer->NextFree = FreeLists[SizeClass];
+        FreeLists[SizeClass] = Buffer;
+    }
+    UpdateStats();
+}
+
+void FAzureFramePool::Trim()
+{
+    FScopeLock ScopeLock(&Lock);
+    FreeUnused();
+    UpdateStats();
+}
+
+void FAzureFramePool::FreeUnused()
+{
+    for (FAzureFrameBuffer*& Head : FreeLists)
+    {
+        while (Head)
+        {
+            FAzureFrameBuffer* Next = Head->NextFree;
+            Stats.BytesAllocated -= Head->Capacity;
+            --Stats.BlocksAllocated;
+            Head->~FAzureFrameBuffer();
+            FMemory::Free(Head);
+            Head = Next;
+        }
+    }
+}
+
+FAzureFramePool::FStats FAzureFramePool::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Stats;
+}
+
+void FAzureFramePool::UpdateStats()
+{
+    SET_MEMORY_STAT(STAT_AzureKinect_FramePoolMemory, Stats.BytesAllocated);
+    TRACE_COUNTER_SET(AzureKinect_FramePoolBytes, Stats.BytesAllocated);
+    TRACE_COUNTER_SET(AzureKinect_FramePoolMisses, Stats.Misses);
+}
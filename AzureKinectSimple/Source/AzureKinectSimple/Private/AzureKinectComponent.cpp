@@ -1,8 +1,69 @@
 #include "AzureKinectComponent.h"
+#include "AzureColorDecoder.h"
+#include "AzureFramePool.h"
+#include "AzureKinectImageUtils.h"
+#include "AzureKinectStats.h"
+#include "AzureTextureUtils.h"
+#include "Async/Async.h"
 #include "Engine/Texture2D.h"
+#include "HAL/PlatformTime.h"
+#include "RenderCore.h"
 #include "Rendering/Texture2DResource.h"
 #include "Runtime/Engine/Public/EngineGlobals.h"
 
+namespace
+{
+    k4a_image_format_t ToK4AFormat(EAzureKinectColorFormat Format)
+    {
+        switch (Format)
+        {
+        case EAzureKinectColorFormat::MJPEG: return K4A_IMAGE_FORMAT_COLOR_MJPG;
+        case EAzureKinectColorFormat::NV12:  return K4A_IMAGE_FORMAT_COLOR_NV12;
+        default:                             return K4A_IMAGE_FORMAT_COLOR_BGRA32;
+        }
+    }
+
+    k4a_color_resolution_t ToK4AResolution(EAzureKinectColorResolution Resolution)
+    {
+        switch (Resolution)
+        {
+        case EAzureKinectColorResolution::R1080P: return K4A_COLOR_RESOLUTION_1080P;
+        case EAzureKinectColorResolution::R1440P: return K4A_COLOR_RESOLUTION_1440P;
+        case EAzureKinectColorResolution::R1536P: return K4A_COLOR_RESOLUTION_1536P;
+        case EAzureKinectColorResolution::R2160P: return K4A_COLOR_RESOLUTION_2160P;
+        case EAzureKinectColorResolution::R3072P: return K4A_COLOR_RESOLUTION_3072P;
+        default:                                  return K4A_COLOR_RESOLUTION_720P;
+        }
+    }
+
+    FIntPoint ColorSize(EAzureKinectColorResolution Resolution)
+    {
+        switch (Resolution)
+        {
+        case EAzureKinectColorResolution::R1080P: return FIntPoint(1920, 1080);
+        case EAzureKinectColorResolution::R1440P: return FIntPoint(2560, 1440);
+        case EAzureKinectColorResolution::R1536P: return FIntPoint(2048, 1536);
+        case EAzureKinectColorResolution::R2160P: return FIntPoint(3840, 2160);
+        case EAzureKinectColorResolution::R3072P: return FIntPoint(4096, 3072);
+        default:                                  return FIntPoint(1280, 720);
+        }
+    }
+
+    // NFOV depth, unbinned and 2x2 binned
+    const FIntPoint DepthSize(640, 576);
+    const FIntPoint BinnedDepthSize(320, 288);
+
+    k4a_fps_t ToK4AFps(int32 Fps)
+    {
+        return Fps >= 30 ? K4A_FRAMES_PER_SECOND_30 : (Fps >= 15 ? K4A_FRAMES_PER_SECOND_15 : K4A_FRAMES_PER_SECOND_5);
+    }
+
+    float SmoothMs(float Current, float Sample)
+    {
+        return Current > 0.f ? FMath::Lerp(Current, Sample, 0.1f) : Sample;
+    }
+}
+
 UAzureKinectComponent::UAzureKinectComponent()
 {
     PrimaryComponentTick.bCanEverTick = true;
@@ -29,69 +90,375 @@ void UAzureKinectComponent::BeginPlay()
     }
 #endif
 
-    UE_LOG(LogTemp, Log, TEXT("Begin Play"));
+    UE_LOG(LogAzureKinect, Log, TEXT("Begin Play"));
 
     // Open device 0
     if (K4A_RESULT_SUCCEEDED != k4a_device_open(0, &Device))
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to open Azure Kinect"));
+        UE_LOG(LogAzureKinect, Error, TEXT("Failed to open Azure Kinect"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Opened Azure Kinect!"));
+    UE_LOG(LogAzureKinect, Log, TEXT("Opened Azure Kinect!"));
 
-    // Configure: color + depth
-    k4a_device_configuration_t Config = K4A_DEVICE_CONFIG_INIT_DISABLE_ALL;
-    Config.color_format = K4A_IMAGE_FORMAT_COLOR_BGRA32;
-    Config.color_resolution = K4A_COLOR_RESOLUTION_720P;
-    Config.depth_mode = K4A_DEPTH_MODE_NFOV_UNBINNED;
-    k4a_device_start_cameras(Device, &Config);
+    // The sensor only produces NV12 at 720p
+    if (ColorFormat == EAzureKinectColorFormat::NV12 && ColorResolution != EAzureKinectColorResolution::R720P)
+    {
+        UE_LOG(LogAzureKinect, Warning, TEXT("AzureKinect: NV12 is only available at 720p, falling back to 720p"));
+        ColorResolution = EAzureKinectColorResolution::R720P;
+    }
+
+    // Color + depth at full rate; demand and CPU pressure may change that later
+    FullRateFps = (ColorResolution == EAzureKinectColorResolution::R3072P) ? 15 : 30;
+    if (!StartCameras(EAzureKinectCaptureMode::Full, true, true))
+    {
+        k4a_device_close(Device);
+        Device = nullptr;
+        return;
+    }
+
+    StartFrameProcessing();
+}
+
+void UAzureKinectComponent::StartFrameProcessing()
+{
+    // Compressed/planar formats are converted by us, off the game thread
+    if (ColorFormat != EAzureKinectColorFormat::BGRA32 && !ColorDecoder)
+    {
+        ColorDecoder = MakeShared<FAzureColorDecoder>(MaxColorDecodesInFlight);
+    }
+
+    PreallocateFrameMemory();
+}
+
+void UAzureKinectComponent::StopFrameProcessing()
+{
+    // Wait for in-flight decodes before tearing anything down
+    ColorDecoder.Reset();
+
+    AzureTex::ReleaseTexture(ColorTexture);
+    AzureTex::ReleaseTexture(DepthTexture);
+}
+
+void UAzureKinectComponent::PreallocateFrameMemory()
+{
+    // Texture staging: one block per upload the render thread may still hold
+    const FIntPoint Color = ColorSize(ColorResolution);
+    AzureTex::PreallocateStaging(Color.X, Color.Y, 4, StagingFramesInFlight);
+    AzureTex::PreallocateStaging(DepthSize.X, DepthSize.Y, 4, StagingFramesInFlight);
+    if (bAdaptiveCaptureRate)
+    {
+        AzureTex::PreallocateStaging(BinnedDepthSize.X, BinnedDepthSize.Y, 4, StagingFramesInFlight);
+    }
+
+    // Compressed frames are copied for the decoder, at most raw size
+    if (ColorDecoder)
+    {
+        FAzureFramePool::Get().Preallocate((int64)Color.X * Color.Y * 4, MaxColorDecodesInFlight);
+    }
+
+    // Conversion buffers at full depth resolution
+    const int32 NumDepthPixels = DepthSize.X * DepthSize.Y;
+    DepthBuffer.Reserve(NumDepthPixels);
+    if (bFilterDepth)
+    {
+        FilteredDepth.Reserve(NumDepthPixels);
+    }
 }
 
 void UAzureKinectComponent::EndPlay(const EEndPlayReason::Type Reason)
 {
+    StopFrameProcessing();
+
+    if (CameraRestart.IsValid())
+    {
+        CameraRestart.Wait();
+        CameraRestart.Reset();
+    }
     if (Device)
     {
         k4a_device_stop_cameras(Device);
         k4a_device_close(Device);
         Device = nullptr;
     }
+    bCamerasRunning = false;
     Super::EndPlay(Reason);
 }
 
-void UAzureKinectComponent::TickComponent(float DeltaTime, ELevelTick Tick, FActorComponentTickFunction* ThisTickFunc)
+k4a_device_configuration_t UAzureKinectComponent::MakeCameraConfig(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth) const
 {
-    Super::TickComponent(DeltaTime, Tick, ThisTickFunc);
+    const int32 Fps = (Mode == EAzureKinectCaptureMode::Full) ? FullRateFps
+        : (Mode == EAzureKinectCaptureMode::Minimal ? 5 : 15);
+
+    k4a_device_configuration_t Config = K4A_DEVICE_CONFIG_INIT_DISABLE_ALL;
+    if (bColor)
+    {
+        Config.color_format = ToK4AFormat(ColorFormat);
+        Config.color_resolution = ToK4AResolution(ColorResolution);
+    }
+    if (bDepth)
+    {
+        Config.depth_mode = (Mode >= EAzureKinectCaptureMode::Binned)
+            ? K4A_DEPTH_MODE_NFOV_2X2BINNED
+            : K4A_DEPTH_MODE_NFOV_UNBINNED;
+    }
+    Config.camera_fps = ToK4AFps(FMath::Min(Fps, FullRateFps));
+    return Config;
+}
+
+bool UAzureKinectComponent::StartCameras(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth)
+{
+    // BeginPlay only: the cameras aren't running yet and nothing else touches the device
+    const k4a_device_configuration_t Config = MakeCameraConfig(Mode, bColor, bDepth);
+    if (K4A_RESULT_SUCCEEDED != k4a_device_start_cameras(Device, &Config))
+    {
+        UE_LOG(LogAzureKinect, Error, TEXT("AzureKinect: k4a_device_start_cameras failed"));
+        return false;
+    }
+
+    ApplyCameraMode(Mode, bColor, bDepth, FPlatformTime::Seconds());
+    return true;
+}
+
+void UAzureKinectComponent::RestartCamerasAsync(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth)
+{
+    // Stopping and starting the sensor takes hundreds of ms, far too long for the game thread.
+    // Until the worker is done TickComponent neither captures nor samples the frame time.
+    const k4a_device_configuration_t Config = MakeCameraConfig(Mode, bColor, bDepth);
+    const bool bStop = bCamerasRunning;
+    const bool bStart = bColor || bDepth;
+    bCamerasRunning = false;
+    RestartMode = Mode;
+    bRestartColor = bColor;
+    bRestartDepth = bDepth;
+
+    CameraRestart = Async(EAsyncExecution::ThreadPool, [Dev = Device, Config, bStop, bStart]()
+    {
+        if (bStop)
+        {
+            k4a_device_stop_cameras(Dev);
+        }
+        return !bStart || K4A_RESULT_SUCCEEDED == k4a_device_start_cameras(Dev, &Config);
+    });
+}
 
-    // 1) A quick on‑screen ping so you know Tick is happening:
-    if (GEngine)
+void UAzureKinectComponent::FinishCameraRestart(bool bStarted, double Now)
+{
+    if (bStarted)
     {
-        GEngine->AddOnScreenDebugMessage(
-            -1, 0.2f, FColor::Cyan, TEXT("Kinect Ticking...!"));
+        ApplyCameraMode(RestartMode, bRestartColor, bRestartDepth, Now);
+        return;
     }
 
+    // Keep the old mode and streams: TickComponent sees the sensor down and tries again later
+    CameraRetrySeconds = FMath::Clamp(CameraRetrySeconds * 2.f, 1.f, 30.f);
+    NextCameraStartSeconds = Now + CameraRetrySeconds;
+    UE_LOG(LogAzureKinect, Error, TEXT("AzureKinect: k4a_device_start_cameras failed, retrying in %.0f s"), CameraRetrySeconds);
+}
+
+void UAzureKinectComponent::ApplyCameraMode(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth, double Now)
+{
+    CaptureMode = Mode;
+    bColorStreamActive = bColor;
+    bDepthStreamActive = bDepth;
+    bCamerasRunning = bColor || bDepth;
+    LastModeChangeSeconds = Now;
+    CameraRetrySeconds = 0.f;
+    NextCameraStartSeconds = 0.0;
+
+    // Frame times from before the switch say nothing about the new mode
+    SmoothedFrameMs = 0.f;
+    PressureSince = 0.0;
+    HeadroomSince = 0.0;
+    TRACE_COUNTER_SET(AzureKinect_CaptureMode, (int64)Mode);
+
+    // Nobody wants either stream: leave the sensor idle
+    if (!bCamerasRunning)
+    {
+        UE_LOG(LogAzureKinect, Log, TEXT("AzureKinect: no stream in use, cameras stopped"));
+        return;
+    }
+    UE_LOG(LogAzureKinect, Log, TEXT("AzureKinect: cameras started (%s, color %s, depth %s)"),
+        *UEnum::GetDisplayValueAsText(Mode).ToString(), bColor ? TEXT("on") : TEXT("off"), bDepth ? TEXT("on") : TEXT("off"));
+}
+
+void UAzureKinectComponent::AddStreamConsumer(EAzureKinectStream Stream)
+{
+    (Stream == EAzureKinectStream::Color ? ColorDemand : DepthDemand).AddSubscriber();
+}
+
+void UAzureKinectComponent::RemoveStreamConsumer(EAzureKinectStream Stream)
+{
+    (Stream == EAzureKinectStream::Color ? ColorDemand : DepthDemand).RemoveSubscriber();
+}
+
+EAzureKinectCaptureMode UAzureKinectComponent::UpdateAdaptiveRate(float DeltaTime, double Now)
+{
+    // Game thread work, not the frame: DeltaTime also holds vsync and frame-rate limiting, and
+    // both include our own wait for the next capture, which shrinks as the rate steps down
+    const float GameThreadMs = GGameThreadTime > 0
+        ? (float)FPlatformTime::ToMilliseconds(GGameThreadTime)
+        : DeltaTime * 1000.f;
+    SmoothedFrameMs = SmoothMs(SmoothedFrameMs, FMath::Max(0.f, GameThreadMs - CaptureWaitMs));
+
+    // Hysteresis: over budget to step down, clearly under it to step back up
+    const bool bPressure = SmoothedFrameMs > AdaptiveMaxFrameMs;
+    const bool bHeadroom = SmoothedFrameMs < AdaptiveMaxFrameMs * 0.75f;
+    PressureSince = bPressure ? (PressureSince > 0.0 ? PressureSince : Now) : 0.0;
+    HeadroomSince = bHeadroom ? (HeadroomSince > 0.0 ? HeadroomSince : Now) : 0.0;
+
+    int32 Mode = (int32)CaptureMode;
+    if (Now - LastModeChangeSeconds >= AdaptiveHoldSeconds)
+    {
+        if (PressureSince > 0.0 && Now - PressureSince >= AdaptiveHoldSeconds)
+        {
+            ++Mode;
+        }
+        else if (HeadroomSince > 0.0 && Now - HeadroomSince >= 2.0 * AdaptiveHoldSeconds)
+        {
+            --Mode;
+        }
+    }
+    return (EAzureKinectCaptureMode)FMath::Clamp(Mode, 0, (int32)MinCaptureMode);
+}
+
+bool UAzureKinectComponent::KeepStream(bool bWanted, bool bActive, double& UnwantedSince, double Now)
+{
+    if (bWanted)
+    {
+        UnwantedSince = 0.0;
+        return true;
+    }
+    if (UnwantedSince == 0.0)
+    {
+        UnwantedSince = Now;
+    }
+    return bActive && Now - UnwantedSince < StreamStopSeconds;
+}
+
+void UAzureKinectComponent::UpdateSavedCpu(double Now)
+{
+    const double Window = Now - WindowStartSeconds;
+    if (WindowStartSeconds == 0.0 || Window >= 1.0)
+    {
+        // Against every stream converted at full rate, at what a frame cost when it was
+        const bool bSaving = bGateStreamsOnDemand || bAdaptiveCaptureRate;
+        const float FullMs = (ColorCostMs + DepthCostMs) * FullRateFps * (float)Window;
+        const float Saved = (bSaving && WindowStartSeconds > 0.0) ? FMath::Max(0.f, FullMs - SpentWindowMs) : 0.f;
+
+        SavedCpuMsPerSecond = Window > 0.0 ? Saved / (float)Window : 0.f;
+        SavedCpuMsTotal += Saved;
+        SpentWindowMs = 0.f;
+        WindowStartSeconds = Now;
+        TRACE_COUNTER_SET(AzureKinect_SavedCpuMs, SavedCpuMsPerSecond);
+    }
+
+    // Counter stats clear every frame
+    SET_DWORD_STAT(STAT_AzureKinect_CaptureMode, (uint32)CaptureMode);
+    SET_FLOAT_STAT(STAT_AzureKinect_SavedCpu, SavedCpuMsPerSecond);
+}
+
+void UAzureKinectComponent::TickComponent(float DeltaTime, ELevelTick Tick, FActorComponentTickFunction* ThisTickFunc)
+{
+    Super::TickComponent(DeltaTime, Tick, ThisTickFunc);
+    SCOPE_CYCLE_COUNTER(STAT_AzureKinect_Tick);
+
+    // 1) Tick ping, only with "log LogAzureKinect VeryVerbose"
+    UE_LOG(LogAzureKinect, VeryVerbose, TEXT("Kinect Ticking...!"));
+
     // 2) Make sure device is open:
     if (!Device)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Kinect: device not open!"));
+        UE_LOG(LogAzureKinect, Verbose, TEXT("Kinect: device not open!"));
+        return;
+    }
+
+    // 3) A camera restart is running on a worker: nothing to capture, and the frame time
+    //    while the sensor is down would skew the adaptive rate
+    const double Now = FPlatformTime::Seconds();
+    if (CameraRestart.IsValid())
+    {
+        if (!CameraRestart.IsReady())
+        {
+            UpdateSavedCpu(Now);
+            return;
+        }
+        FinishCameraRestart(CameraRestart.Get(), Now);
+        CameraRestart.Reset();
+    }
+
+    // 4) Decide what to capture: full rate unless under pressure, only streams someone uses
+    const EAzureKinectCaptureMode WantedMode = bAdaptiveCaptureRate
+        ? UpdateAdaptiveRate(DeltaTime, Now)
+        : EAzureKinectCaptureMode::Full;
+
+    bool bColorWanted = true;
+    bool bDepthWanted = true;
+    bool bKeepColor = true;
+    bool bKeepDepth = true;
+    if (bGateStreamsOnDemand)
+    {
+        bColorWanted = ColorDemand.IsWanted(ColorTexture, DemandIdleSeconds);
+        bDepthWanted = DepthDemand.IsWanted(DepthTexture, DemandIdleSeconds);
+        bKeepColor = KeepStream(bColorWanted, bColorStreamActive, ColorUnwantedSince, Now);
+        bKeepDepth = KeepStream(bDepthWanted, bDepthStreamActive, DepthUnwantedSince, Now);
+    }
+
+    // A failed start leaves the old mode in place with the sensor down; retry it after a backoff
+    const bool bChanged = WantedMode != CaptureMode || bKeepColor != bColorStreamActive || bKeepDepth != bDepthStreamActive;
+    const bool bSensorDown = !bCamerasRunning && (bKeepColor || bKeepDepth);
+    if ((bChanged || bSensorDown) && Now >= NextCameraStartSeconds)
+    {
+        RestartCamerasAsync(WantedMode, bKeepColor, bKeepDepth);
+    }
+    UpdateSavedCpu(Now);
+
+    if (!bCamerasRunning)
+    {
         return;
     }
 
-    // 3) Wait up to 100ms for a new capture:
-    k4a_wait_result_t Wait = k4a_device_get_capture(Device, &Capture, 100);
+    // 5) Wait up to 100ms for a new capture; below full rate most ticks have none, so don't block.
+    //    The adaptive rate never blocks: waiting would pace the game to the camera and read as load.
+    const int32 TimeoutMs = (CaptureMode == EAzureKinectCaptureMode::Full && !bAdaptiveCaptureRate) ? 100 : 0;
+    k4a_wait_result_t Wait;
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AzureKinect_CaptureWait);
+        const uint64 WaitStart = FPlatformTime::Cycles64();
+        Wait = k4a_device_get_capture(Device, &Capture, TimeoutMs);
+        CaptureWaitMs = (float)FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WaitStart);
+    }
     if (Wait == K4A_WAIT_RESULT_TIMEOUT)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Kinect: no frame this tick (timeout)"));
+        UE_LOG(LogAzureKinect, Verbose, TEXT("Kinect: no frame this tick (timeout)"));
         return;
     }
     else if (Wait != K4A_WAIT_RESULT_SUCCEEDED)
     {
-        UE_LOG(LogTemp, Error, TEXT("Kinect: capture error %d"), (int)Wait);
+        UE_LOG(LogAzureKinect, Error, TEXT("Kinect: capture error %d"), (int)Wait);
         return;
     }
 
-    UpdateColor();
-    UpdateDepth();
+    // 6) Convert and upload what is in use; the costs feed the saved-CPU estimate
+    if (bColorStreamActive && bColorWanted)
+    {
+        const uint64 Start = FPlatformTime::Cycles64();
+        UpdateColor();
+        const float Ms = (float)FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+        ColorCostMs = SmoothMs(ColorCostMs, Ms);
+        SpentWindowMs += Ms;
+    }
+    if (bDepthStreamActive && bDepthWanted)
+    {
+        const uint64 Start = FPlatformTime::Cycles64();
+        UpdateDepth();
+        const float Ms = (float)FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+        if (CaptureMode < EAzureKinectCaptureMode::Binned)
+        {
+            DepthCostMs = SmoothMs(DepthCostMs, Ms);
+        }
+        SpentWindowMs += Ms;
+    }
     k4a_capture_release(Capture);
 }
 
@@ -100,128 +467,151 @@ void UAzureKinectComponent::InitializeTextures(int Width, int Height)
     // Don't try to make a 0×0 texture!
     if (Width <= 0 || Height <= 0)
     {
-        UE_LOG(LogTemp, Warning,
+        UE_LOG(LogAzureKinect, Warning,
             TEXT("AzureKinect: InitializeTextures called with invalid size %d×%d"),
             Width, Height);
         return;
     }
 
-    // Create or update ColorTexture
-    if (!ColorTexture)
-    {
-        ColorTexture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
-        ColorTexture->AddToRoot();
-        ColorTexture->UpdateResource();
-    }
+    AzureTex::EnsureTexture(ColorTexture, Width, Height, PF_B8G8R8A8, true);
 }
 
 void UAzureKinectComponent::UpdateColor()
 {
     // — Color image —
     k4a_image_t ColorImg = k4a_capture_get_color_image(Capture);
-    if (ColorImg)
+    if (!ColorImg)
     {
-        const int32 W = k4a_image_get_width_pixels(ColorImg);
-        const int32 H = k4a_image_get_height_pixels(ColorImg);
-        uint8* ColorPtr = k4a_image_get_buffer(ColorImg);
+        UploadDecodedColor();
+        return;
+    }
 
-        // Only proceed if we actually have pixels
-        if (W > 0 && H > 0 && ColorPtr)
-        {
-            // Recreate the transient if size changed (or first time)
-            if (!ColorTexture || ColorTexture->GetSizeX() != W || ColorTexture->GetSizeY() != H)
-            {
-                ColorTexture = UTexture2D::CreateTransient(W, H, PF_B8G8R8A8);
-                ColorTexture->AddToRoot();
-                ColorTexture->UpdateResource();
-            }
-
-            // Lock the texture's bulk data, memcpy, unlock, and push to GPU
-            if (FTexturePlatformData* PlatData = ColorTexture->GetPlatformData())
-            {
-                if (PlatData->Mips.Num() > 0)
-                {
-                    // Grab the first mip
-                    FTexture2DMipMap& Mip = PlatData->Mips[0];
-
-                    // Lock for writing
-                    void* Dest = Mip.BulkData.Lock(LOCK_READ_WRITE);
-                    // Copy entire image (W*H pixels * 4 bytes/pixel)
-                    FMemory::Memcpy(Dest, ColorPtr, W * H * 4);
-                    Mip.BulkData.Unlock();
-
-                    // Immediately update the resource so the GPU sees it
-                    ColorTexture->UpdateResource();
-                }
-            }
-        }
+    ProcessColorFrame(
+        k4a_image_get_buffer(ColorImg),
+        (int32)k4a_image_get_size(ColorImg),
+        k4a_image_get_width_pixels(ColorImg),
+        k4a_image_get_height_pixels(ColorImg),
+        k4a_image_get_stride_bytes(ColorImg),
+        k4a_image_get_device_timestamp_usec(ColorImg));
 
-        k4a_image_release(ColorImg);
-    }
+    k4a_image_release(ColorImg);
 }
 
-void UAzureKinectComponent::UpdateDepth()
+void UAzureKinectComponent::ProcessColorFrame(const uint8* Data, int32 SizeBytes, int32 Width, int32 Height, int32 StrideBytes, uint64 TimestampUsec)
 {
-    k4a_image_t DepthImg = k4a_capture_get_depth_image(Capture);
-    if (!DepthImg)
+    if (ColorFormat == EAzureKinectColorFormat::BGRA32)
     {
-        UE_LOG(LogTemp, Warning, TEXT("AzureKinect: no depth image in this capture"));
-        return;
+        // BGRA32: the SDK already converted, copy straight in
+        UploadColor(Data, Width, Height);
+    }
+    else if (ColorDecoder)
+    {
+        // MJPEG/NV12: hand a copy to the workers, the caller's buffer goes away after this
+        ColorDecoder->Submit(ToK4AFormat(ColorFormat), Data, SizeBytes, Width, Height, StrideBytes, TimestampUsec);
     }
 
-    const int32 DepthW = k4a_image_get_width_pixels(DepthImg);
-    const int32 DepthH = k4a_image_get_height_pixels(DepthImg);
-    const int32 NumPixels = DepthW * DepthH;
-    const uint16* DepthPtr = reinterpret_cast<uint16*>(k4a_image_get_buffer(DepthImg));
+    UploadDecodedColor();
+}
 
-    if (!DepthPtr || NumPixels <= 0)
+void UAzureKinectComponent::UploadDecodedColor()
+{
+    if (!ColorDecoder)
     {
-        UE_LOG(LogTemp, Warning, TEXT("AzureKinect: depth buffer invalid"));
-        k4a_image_release(DepthImg);
         return;
     }
 
-    // Resize buffers if needed
-    if (DepthBuffer.Num() != NumPixels)
+    // Pick up whatever the workers finished since last tick
+    int32 DecodedW = 0;
+    int32 DecodedH = 0;
+    if (ColorDecoder->ConsumeLatest(DecodedColor, DecodedW, DecodedH))
     {
-        DepthBuffer.SetNumUninitialized(NumPixels);
+        UploadColor(DecodedColor.GetData(), DecodedW, DecodedH);
     }
 
-    // Convert depth to grayscale
-    for (int32 i = 0; i < NumPixels; ++i)
-    {
-        uint16 depth = DepthPtr[i];
+    TRACE_COUNTER_SET(AzureKinect_ColorDecodesInFlight, ColorDecoder->GetInFlight());
+    TRACE_COUNTER_SET(AzureKinect_ColorFramesDropped, ColorDecoder->GetDroppedFrames());
+}
 
-        // Example: Normalize and clamp (scale this appropriately to your depth range)
-        uint8 grayscale = FMath::Clamp(depth / 10, 0, 255);
+void UAzureKinectComponent::UploadColor(const uint8* Pixels, int32 W, int32 H)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureKinect_ColorUpload);
 
-        DepthBuffer[i] = FColor(grayscale, grayscale, grayscale, 255);
+    // Only proceed if we actually have pixels
+    if (W <= 0 || H <= 0 || !Pixels)
+    {
+        return;
     }
 
-    if (!DepthTexture || DepthTexture->GetSizeX() != DepthW || DepthTexture->GetSizeY() != DepthH)
+    // Only recreated on a resolution change; every frame is a region update from a pooled staging block
+    AzureTex::EnsureTexture(ColorTexture, W, H, PF_B8G8R8A8, true);
+    AzureTex::UploadTexture(ColorTexture, Pixels, W, H, 4);
+}
+
+int32 UAzureKinectComponent::GetDroppedColorFrames() const
+{
+    return ColorDecoder ? ColorDecoder->GetDroppedFrames() : 0;
+}
+
+void UAzureKinectComponent::UpdateDepth()
+{
+    k4a_image_t DepthImg = k4a_capture_get_depth_image(Capture);
+    if (!DepthImg)
     {
-        DepthTexture = UTexture2D::CreateTransient(DepthW, DepthH, PF_B8G8R8A8);
-        DepthTexture->AddToRoot();
-        DepthTexture->Filter = TF_Nearest;
-        DepthTexture->SRGB = false;
-        DepthTexture->UpdateResource();
+        UE_LOG(LogAzureKinect, Verbose, TEXT("AzureKinect: no depth image in this capture"));
+        return;
     }
 
-    for (int32 i = 0; i < NumPixels; ++i)
+    ProcessDepthFrame(
+        reinterpret_cast<const uint16*>(k4a_image_get_buffer(DepthImg)),
+        k4a_image_get_width_pixels(DepthImg),
+        k4a_image_get_height_pixels(DepthImg));
+
+    k4a_image_release(DepthImg);
+}
+
+void UAzureKinectComponent::ProcessDepthFrame(const uint16* Depth, int32 DepthW, int32 DepthH)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AzureKinect_DepthConvert);
+
+    const int32 NumPixels = DepthW * DepthH;
+    const uint16* DepthPtr = Depth;
+    if (!DepthPtr || NumPixels <= 0)
     {
-        uint16 depth = DepthPtr[i];
-        uint8 gray = FMath::Clamp(depth / 10, 0, 255);
-        DepthBuffer[i] = FColor(gray, gray, gray, 255);
+        UE_LOG(LogAzureKinect, Warning, TEXT("AzureKinect: depth buffer invalid"));
+        return;
     }
 
-    // Update raw texture memory
-    FTexture2DMipMap& Mip = DepthTexture->GetPlatformData()->Mips[0];  // ✅ Requires full engine access
-    void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
-    FMemory::Memcpy(Data, DepthBuffer.GetData(), NumPixels * sizeof(FColor));
-    Mip.BulkData.Unlock();
+    // Resize buffers if needed; keep the allocation when binned depth makes them smaller
+    if (DepthBuffer.Num() != NumPixels)
+    {
+        DepthBuffer.SetNumUninitialized(NumPixels, false);
+    }
 
-    DepthTexture->UpdateResource();
+    // Optional clean-up stage between the sensor and everything below
+    if (bFilterDepth)
+    {
+        FAzureDepthFilter::FSettings Cfg;
+        Cfg.bRemoveFlyingPixels = bRemoveFlyingPixels;
+        Cfg.bTemporal = bTemporalDepthFilter;
+        Cfg.TemporalAlpha = DepthTemporalAlpha;
+        Cfg.MotionThresholdMm = DepthMotionThresholdMm;
+        Cfg.bFillHoles = bFillDepthHoles;
+        Cfg.HoleFillRadius = DepthHoleFillRadius;
+        DepthFilter.Configure(Cfg);
+
+        DepthFilter.Process(DepthPtr, DepthW, DepthH, FilteredDepth);
+        DepthPtr = FilteredDepth.GetData();
+    }
+    else if (FilteredDepth.Num() > 0)
+    {
+        // Switched off: start from scratch when it's switched back on
+        DepthFilter.Reset();
+        FilteredDepth.Empty();
+    }
 
+    // Convert depth to grayscale
+    AzureImage::DepthToGrayscale(DepthPtr, NumPixels, DepthBuffer.GetData());
 
-    k4a_image_release(DepthImg);
+    AzureTex::EnsureTexture(DepthTexture, DepthW, DepthH, PF_B8G8R8A8);
+    AzureTex::UploadTexture(DepthTexture, reinterpret_cast<const uint8*>(DepthBuffer.GetData()), DepthW, DepthH, sizeof(FColor));
 }
@@ -0,0 +1,18 @@
+#include "AzureKinectImageUtils.h"
+
+namespace AzureImage
+{
+    void DepthToGrayscale(const uint16* Depth, int32 NumPixels, FColor* OutPixels)
+    {
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            const uint8 Gray = (uint8)FMath::Min<uint32>(Depth[i] / 10u, 255u);
+            OutPixels[i] = FColor(Gray, Gray, Gray, 255);
+        }
+    }
+
+    void CopyBgra(const uint8* Src, int32 Width, int32 Height, uint8* Dest)
+    {
+        FMemory::Memcpy(Dest, Src, (int64)Width * Height * 4);
+    }
+}
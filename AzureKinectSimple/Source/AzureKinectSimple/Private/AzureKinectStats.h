@@ -0,0 +1,30 @@
+// AzureKinectStats.h (Private)
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+// Per-frame chatter is Verbose: enable with "log LogAzureKinect Verbose"
+DECLARE_LOG_CATEGORY_EXTERN(LogAzureKinect, Log, All);
+
+// Shared with the body tracking module ("stat AzureKinect")
+DECLARE_STATS_GROUP(TEXT("AzureKinect"), STATGROUP_AzureKinect, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Tick"), STAT_AzureKinect_Tick, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Capture Wait"), STAT_AzureKinect_CaptureWait, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Color Upload"), STAT_AzureKinect_ColorUpload, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Color Decode (worker)"), STAT_AzureKinect_ColorDecode, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Depth Conversion"), STAT_AzureKinect_DepthConvert, STATGROUP_AzureKinect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Depth Filter"), STAT_AzureKinect_DepthFilter, STATGROUP_AzureKinect, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Capture Mode (0 = full rate)"), STAT_AzureKinect_CaptureMode, STATGROUP_AzureKinect, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Saved CPU (ms/s)"), STAT_AzureKinect_SavedCpu, STATGROUP_AzureKinect, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Frame Pool"), STAT_AzureKinect_FramePoolMemory, STATGROUP_AzureKinect, );
+
+// Insights counters
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureKinect_ColorDecodesInFlight);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureKinect_ColorFramesDropped);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureKinect_CaptureMode);
+TRACE_DECLARE_FLOAT_COUNTER_EXTERN(AzureKinect_SavedCpuMs);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(AzureKinect_FramePoolBytes);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AzureKinect_FramePoolMisses);
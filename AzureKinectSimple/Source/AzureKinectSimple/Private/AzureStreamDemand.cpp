@@ -0,0 +1,19 @@
+#include "AzureStreamDemand.h"
+#include "Engine/Texture.h"
+#include "Misc/App.h"
+
+void FAzureStreamDemand::Touch() const
+{
+    LastReadSeconds = FApp::GetCurrentTime();
+}
+
+bool FAzureStreamDemand::IsWanted(const UTexture* Texture, float IdleSeconds) const
+{
+    if (Subscribers > 0 || !Texture)
+    {
+        return true;
+    }
+
+    const double Since = FApp::GetCurrentTime() - IdleSeconds;
+    return LastReadSeconds >= Since || Texture->GetLastRenderTimeForStreaming() >= Since;
+}
@@ -0,0 +1,88 @@
+#include "AzureTextureUtils.h"
+#include "AzureFramePool.h"
+#include "Engine/Texture2D.h"
+#include "TextureResource.h"
+
+namespace
+{
+    // The update region lives in the staging block, behind the pixels
+    int64 RegionOffset(int32 Width, int32 Height, int32 BytesPerPixel)
+    {
+        return Align((int64)Width * Height * BytesPerPixel, 16);
+    }
+
+    int64 StagingBytes(int32 Width, int32 Height, int32 BytesPerPixel)
+    {
+        return RegionOffset(Width, Height, BytesPerPixel) + sizeof(FUpdateTextureRegion2D);
+    }
+}
+
+namespace AzureTex
+{
+    bool EnsureTexture(UTexture2D*& Texture, int32 Width, int32 Height, EPixelFormat Format, bool bImage)
+    {
+        if (Width <= 0 || Height <= 0)
+        {
+            return false;
+        }
+
+        if (Texture && Texture->GetSizeX() == Width && Texture->GetSizeY() == Height)
+        {
+            return false;
+        }
+
+        // Resolution changed: the old one would otherwise stay rooted forever
+        ReleaseTexture(Texture);
+
+        Texture = UTexture2D::CreateTransient(Width, Height, Format);
+        Texture->AddToRoot();
+        if (!bImage)
+        {
+            Texture->Filter = TF_Nearest;
+            Texture->SRGB = false;
+        }
+        Texture->UpdateResource();
+        return true;
+    }
+
+    void ReleaseTexture(UTexture2D*& Texture)
+    {
+        if (Texture)
+        {
+            Texture->RemoveFromRoot();
+            Texture = nullptr;
+        }
+    }
+
+    void UploadTexture(UTexture2D* Texture, const uint8* Pixels, int32 Width, int32 Height, int32 BytesPerPixel)
+    {
+        // Without a resource (e.g. -nullrhi) the cleanup callback would never run
+        if (!Texture || !Texture->GetResource() || !Pixels || Width <= 0 || Height <= 0)
+        {
+            return;
+        }
+
+        // The render thread consumes pixels and region later, so both must outlive this call
+        FAzureFrameBuffer* Staging = FAzureFramePool::Get().Acquire(StagingBytes(Width, Height, BytesPerPixel));
+        FMemory::Memcpy(Staging->Data, Pixels, (SIZE_T)Width * Height * BytesPerPixel);
+
+        FUpdateTextureRegion2D* Region = new (Staging->Data + RegionOffset(Width, Height, BytesPerPixel))
+            FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height);
+
+        Texture->UpdateTextureRegions(
+            0, 1, Region,
+            Width * BytesPerPixel, BytesPerPixel, Staging->Data,
+            [Staging](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+            {
+                FAzureFramePool::Get().Release(Staging);
+            });
+    }
+
+    void PreallocateStaging(int32 Width, int32 Height, int32 BytesPerPixel, int32 FramesInFlight)
+    {
+        if (Width > 0 && Height > 0)
+        {
+            FAzureFramePool::Get().Preallocate(StagingBytes(Width, Height, BytesPerPixel), FramesInFlight);
+        }
+    }
+}
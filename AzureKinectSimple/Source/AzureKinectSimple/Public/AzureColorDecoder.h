@@ -0,0 +1,64 @@
+// AzureColorDecoder.h
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include <k4a/k4a.h>
+
+class IImageWrapperModule;
+struct FAzureFrameBuffer;
+
+/**
+ * Decodes MJPEG / NV12 color frames to BGRA on task-graph workers so the SDK
+ * doesn't have to do the conversion on its own single thread.
+ * Frames are submitted from the game thread; the newest finished frame wins.
+ * Source copies come from FAzureFramePool and decoded frames are recycled, so NV12 runs
+ * without allocating once warm (the JPEG decoder still allocates inside ImageWrapper).
+ */
+class AZUREKINECTSIMPLE_API FAzureColorDecoder
+{
+public:
+    explicit FAzureColorDecoder(int32 InMaxInFlight);
+    ~FAzureColorDecoder();
+
+    /** Copies the frame and schedules a decode. Returns false if it was dropped (all slots busy). */
+    bool Submit(k4a_image_format_t Format, const uint8* Data, int32 SizeBytes,
+                int32 Width, int32 Height, int32 StrideBytes, uint64 TimestampUsec);
+
+    /** Moves the newest decoded frame (BGRA8) into OutPixels. Returns false if nothing new finished. */
+    bool ConsumeLatest(TArray64<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+    int32 GetDroppedFrames() const { return DroppedFrames.GetValue(); }
+    int32 GetInFlight() const { return InFlight.GetValue(); }
+
+    /** Blocks until every scheduled decode has finished. */
+    void Flush();
+
+    /** Converts an NV12 frame (BT.601, limited range) to BGRA8. */
+    static void ConvertNv12ToBgra(const uint8* Nv12, int32 Width, int32 Height, int32 StrideBytes, uint8* OutBgra);
+
+    /** Decodes one MJPEG frame to BGRA8 on the calling thread, as the workers do. */
+    bool DecodeJpegToBgra(const uint8* Jpeg, int64 SizeBytes, TArray64<uint8>& OutBgra, int32& OutWidth, int32& OutHeight) const;
+
+private:
+    struct FDecodedFrame
+    {
+        TArray64<uint8> Pixels;
+        int32  Width = 0;
+        int32  Height = 0;
+        uint64 TimestampUsec = 0;
+    };
+
+    void Decode(k4a_image_format_t Format, const FAzureFrameBuffer& Source, int32 Width, int32 Height, int32 StrideBytes, uint64 TimestampUsec);
+
+    IImageWrapperModule* ImageWrapperModule = nullptr;
+    int32 MaxInFlight = 2;
+
+    FThreadSafeCounter InFlight;
+    FThreadSafeCounter DroppedFrames;
+
+    FCriticalSection LatestLock;
+    FDecodedFrame Latest;
+    bool bHasLatest = false;
+    TArray<TArray64<uint8>> FreePixels; // decoded frames nobody holds any more, reused by Decode
+    uint64 LatestTimestampUsec = 0;
+};
@@ -0,0 +1,57 @@
+// AzureDepthFilter.h
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Optional clean-up of raw depth (mm, 0 = invalid) before anything uses it:
+ * flying pixels along depth edges are dropped, every pixel is smoothed over time
+ * (median of the last three values, then an exponential average that restarts where
+ * the scene moves), and small holes are filled only where the neighbours on both sides
+ * agree, so silhouettes don't bleed into the background.
+ * Runs in row tiles on the task graph (unless bParallel is off). Keeps per-pixel history: feed it one stream.
+ */
+class AZUREKINECTSIMPLE_API FAzureDepthFilter
+{
+public:
+    struct FSettings
+    {
+        bool  bRemoveFlyingPixels = true;
+        float FlyingPixelThresholdMm = 40.f;     // a neighbour further than this (+ ratio * depth) disagrees ...
+        float FlyingPixelThresholdRatio = 0.02f;
+        int32 FlyingPixelMinNeighbours = 4;      // ... and this many of the 8 disagreeing drops the pixel
+
+        bool  bTemporal = true;
+        bool  bTemporalMedian = true;            // median of the last 3 values before smoothing
+        float TemporalAlpha = 0.4f;              // weight of the newest frame (1 = no smoothing)
+        float MotionThresholdMm = 30.f;          // a jump beyond this (+ ratio * depth) restarts the pixel
+        float MotionThresholdRatio = 0.01f;
+        int32 HoldFrames = 2;                    // a pixel that drops out keeps its value this many frames
+
+        bool  bFillHoles = true;
+        int32 HoleFillRadius = 3;                // px searched left/right/up/down
+        float HoleFillMaxStepMm = 50.f;          // opposite neighbours must agree within this
+
+        bool  bParallel = true;                  // false: every tile on the calling thread (one core's cost)
+    };
+
+    void Configure(const FSettings& InSettings);
+    void Reset();
+
+    /** Filters one frame into OutDepth (resized to Width * Height). A new size restarts the history. */
+    void Process(const uint16* Depth, int32 Width, int32 Height, TArray<uint16>& OutDepth);
+
+private:
+    void FilterRows(const uint16* Depth, int32 RowBegin, int32 RowEnd);
+    void FillRows(int32 RowBegin, int32 RowEnd, uint16* OutDepth) const;
+    bool IsFlyingPixel(const uint16* Depth, int32 X, int32 Y) const;
+
+    FSettings Settings;
+    int32 Width = 0;
+    int32 Height = 0;
+
+    TArray<float>  Smoothed;    // temporal state, 0 = none
+    TArray<uint16> History1;    // the previous two frames, flying pixels already removed
+    TArray<uint16> History2;
+    TArray<uint8>  Age;         // frames a held pixel has been invalid
+    TArray<uint16> Filtered;    // flying pixels + temporal, input of the hole fill
+};
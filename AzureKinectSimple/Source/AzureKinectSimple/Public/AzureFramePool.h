@@ -0,0 +1,68 @@
+// AzureFramePool.h
+#pragma once
+#include "CoreMinimal.h"
+
+/** A block of frame memory from FAzureFramePool: Size bytes asked for, Capacity bytes usable. */
+struct FAzureFrameBuffer
+{
+    uint8* Data = nullptr;
+    int64  Size = 0;
+    int64  Capacity = 0;
+
+private:
+    friend class FAzureFramePool;
+    FAzureFrameBuffer* NextFree = nullptr;
+    int32 SizeClass = 0;
+};
+
+/**
+ * Per-frame buffers of both plugins (texture staging, frame copies handed to workers),
+ * recycled through one free list per size class. Classes step by a quarter octave, so a
+ * block wastes at most 25%. Once every frame size has been seen a few times nothing is
+ * allocated any more; blocks only go back to the system on Trim.
+ * Acquire and Release are thread-safe: the render thread and workers release most blocks.
+ */
+class AZUREKINECTSIMPLE_API FAzureFramePool
+{
+public:
+    struct FStats
+    {
+        int64 BytesAllocated = 0;  // held by the pool, in use or free
+        int32 BlocksAllocated = 0;
+        int32 BlocksInUse = 0;
+        int64 Misses = 0;          // Acquires that had to allocate
+    };
+
+    /** Shared by every component of both plugins. */
+    static FAzureFramePool& Get();
+
+    ~FAzureFramePool();
+
+    /** A block of at least Bytes; contents are undefined. */
+    FAzureFrameBuffer* Acquire(int64 Bytes);
+    void Release(FAzureFrameBuffer* Buffer);
+
+    /** Makes sure Count blocks that fit Bytes are free, e.g. on BeginPlay for the known frame sizes. */
+    void Preallocate(int64 Bytes, int32 Count);
+
+    /** Frees every block not in use. */
+    void Trim();
+
+    FStats GetStats() const;
+
+private:
+    static constexpr int32 MinOctave = 12; // 4 KB
+    static constexpr int32 MaxOctave = 40;
+    static constexpr int32 NumSizeClasses = (MaxOctave - MinOctave) * 4 + 1;
+
+    static int32 SizeClassOf(int64 Bytes);
+    static int64 CapacityOf(int32 SizeClass);
+
+    FAzureFrameBuffer* Allocate(int32 SizeClass);
+    void FreeUnused();
+    void UpdateStats();
+
+    mutable FCriticalSection Lock;
+    FAzureFrameBuffer* FreeLists[NumSizeClasses] = {};
+    FStats Stats;
+};
@@ -2,10 +2,51 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Async/Future.h"
 #include <k4a/k4a.h>
+#include "AzureDepthFilter.h"
+#include "AzureStreamDemand.h"
 #include "Runtime/Engine/Public/EngineGlobals.h"
 #include "AzureKinectComponent.generated.h"
 
+class FAzureColorDecoder;
+
+UENUM(BlueprintType)
+enum class EAzureKinectColorFormat : uint8
+{
+    BGRA32  UMETA(DisplayName="BGRA32 (converted by the SDK)"),
+    MJPEG   UMETA(DisplayName="MJPEG (decoded on worker threads)"),
+    NV12    UMETA(DisplayName="NV12 (converted on worker threads, 720p only)")
+};
+
+UENUM(BlueprintType)
+enum class EAzureKinectColorResolution : uint8
+{
+    R720P   UMETA(DisplayName="1280x720"),
+    R1080P  UMETA(DisplayName="1920x1080"),
+    R1440P  UMETA(DisplayName="2560x1440"),
+    R1536P  UMETA(DisplayName="2048x1536"),
+    R2160P  UMETA(DisplayName="3840x2160"),
+    R3072P  UMETA(DisplayName="4096x3072 (15 fps)")
+};
+
+UENUM(BlueprintType)
+enum class EAzureKinectStream : uint8
+{
+    Color,
+    Depth
+};
+
+/** Capture settings, from full rate down; the component steps through them under CPU pressure. */
+UENUM(BlueprintType)
+enum class EAzureKinectCaptureMode : uint8
+{
+    Full        UMETA(DisplayName="30 fps, full depth"),
+    Reduced     UMETA(DisplayName="15 fps, full depth"),
+    Binned      UMETA(DisplayName="15 fps, 2x2 binned depth"),
+    Minimal     UMETA(DisplayName="5 fps, 2x2 binned depth")
+};
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class AZUREKINECTSIMPLE_API UAzureKinectComponent : public UActorComponent
 {
@@ -32,17 +73,142 @@ public:
 
     /** Getter nodes for Blueprint graphs */
     UFUNCTION(BlueprintCallable, Category="AzureKinect")
-    UTexture2D* GetColorTexture() const { return ColorTexture; }
+    UTexture2D* GetColorTexture() const { ColorDemand.Touch(); return ColorTexture; }
 
     UFUNCTION(BlueprintCallable, Category="AzureKinect")
     void GetDepthData(TArray<FColor>& OutDepth) const
     {
+        DepthDemand.Touch();
         OutDepth = DepthBuffer;
     }
 
     UFUNCTION(BlueprintCallable, Category="AzureKinect")
-    UTexture2D* GetDepthTexture() const { return DepthTexture; }
+    UTexture2D* GetDepthTexture() const { DepthDemand.Touch(); return DepthTexture; }
+
+    /**
+     * Keep a stream running while nothing samples or reads it (e.g. C++ reading DepthBuffer
+     * directly). Pair every call with RemoveStreamConsumer.
+     */
+    UFUNCTION(BlueprintCallable, Category="AzureKinect|Demand")
+    void AddStreamConsumer(EAzureKinectStream Stream);
+
+    UFUNCTION(BlueprintCallable, Category="AzureKinect|Demand")
+    void RemoveStreamConsumer(EAzureKinectStream Stream);
+
+    /**
+     * Only convert and upload a stream while it has a consumer, a getter read it or its texture
+     * was drawn within DemandIdleSeconds; after StreamStopSeconds without one, the sensor stops
+     * sending it. Reading the texture properties directly doesn't count as use.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Demand")
+    bool bGateStreamsOnDemand = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Demand", meta=(EditCondition="bGateStreamsOnDemand", ClampMin="0.1"))
+    float DemandIdleSeconds = 1.f;
+
+    /** Restarting the cameras interrupts both streams for a moment, so streams are only switched this late. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Demand", meta=(EditCondition="bGateStreamsOnDemand", ClampMin="1.0"))
+    float StreamStopSeconds = 5.f;
+
+    /**
+     * Step the capture down (15 fps, then binned depth, then 5 fps) while the game thread's work
+     * (without waiting for the sensor) stays over AdaptiveMaxFrameMs, and back up once it has
+     * room again. Captures are polled instead of waited for while this is on.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Demand")
+    bool bAdaptiveCaptureRate = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Demand", meta=(EditCondition="bAdaptiveCaptureRate", ClampMin="5.0"))
+    float AdaptiveMaxFrameMs = 20.f;
+
+    /** How long the frame time has to stay over (or well under) the budget before the mode changes. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Demand", meta=(EditCondition="bAdaptiveCaptureRate", ClampMin="1.0"))
+    float AdaptiveHoldSeconds = 3.f;
+
+    /** Lowest mode the adaptive rate may pick. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Demand", meta=(EditCondition="bAdaptiveCaptureRate"))
+    EAzureKinectCaptureMode MinCaptureMode = EAzureKinectCaptureMode::Minimal;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="AzureKinect|Demand")
+    EAzureKinectCaptureMode CaptureMode = EAzureKinectCaptureMode::Full;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="AzureKinect|Demand")
+    bool bColorStreamActive = false;
 
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="AzureKinect|Demand")
+    bool bDepthStreamActive = false;
+
+    /** Estimated game thread time not spent on conversions and uploads, against full rate with every stream on. */
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="AzureKinect|Demand")
+    float SavedCpuMsPerSecond = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="AzureKinect|Demand")
+    float SavedCpuMsTotal = 0.f;
+
+    /** Format requested from the sensor. MJPEG/NV12 are decoded by the plugin instead of the SDK. Applied on BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AzureKinect|Color")
+    EAzureKinectColorFormat ColorFormat = EAzureKinectColorFormat::BGRA32;
+
+    /** Applied on BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AzureKinect|Color")
+    EAzureKinectColorResolution ColorResolution = EAzureKinectColorResolution::R720P;
+
+    /** How many color frames may be decoding at once; newer frames are dropped beyond this. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AzureKinect|Color", meta=(ClampMin="1", ClampMax="8"))
+    int32 MaxColorDecodesInFlight = 3;
+
+    /** Frames dropped because every decode slot was busy (or the JPEG was corrupt). */
+    UFUNCTION(BlueprintCallable, Category="AzureKinect|Color")
+    int32 GetDroppedColorFrames() const;
+
+    /** Clean depth up before it reaches DepthBuffer/DepthTexture (flying pixels, temporal noise, holes). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Depth Filter")
+    bool bFilterDepth = false;
+
+    /** Drop pixels that disagree with most of their neighbours (the smear between foreground and background). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Depth Filter", meta=(EditCondition="bFilterDepth"))
+    bool bRemoveFlyingPixels = true;
+
+    /** Smooth every pixel over time; pixels that move more than DepthMotionThresholdMm restart immediately. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Depth Filter", meta=(EditCondition="bFilterDepth"))
+    bool bTemporalDepthFilter = true;
+
+    /** Weight of the newest frame: lower is smoother but lags more on slow motion. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Depth Filter", meta=(EditCondition="bFilterDepth", ClampMin="0.05", ClampMax="1.0"))
+    float DepthTemporalAlpha = 0.4f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Depth Filter", meta=(EditCondition="bFilterDepth", ClampMin="5.0"))
+    float DepthMotionThresholdMm = 30.f;
+
+    /** Fill small holes where the pixels on both sides lie on the same surface. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Depth Filter", meta=(EditCondition="bFilterDepth"))
+    bool bFillDepthHoles = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AzureKinect|Depth Filter", meta=(EditCondition="bFilterDepth", ClampMin="1", ClampMax="16"))
+    int32 DepthHoleFillRadius = 3;
+
+    /**
+     * Texture staging blocks preallocated per stream on BeginPlay: uploads the render thread
+     * may hold at once. A slower render thread makes the pool allocate a few more, once.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AzureKinect|Memory", meta=(ClampMin="1", ClampMax="8"))
+    int32 StagingFramesInFlight = 3;
+
+    /**
+     * C++: runs frames that don't come from this component's sensor (recordings, the benchmark's
+     * soak run) through the same conversions and uploads as captures. BeginPlay calls it once
+     * the sensor is open; no device is needed.
+     */
+    void StartFrameProcessing();
+
+    /** Waits for color decodes in flight and releases both textures. EndPlay calls it too. */
+    void StopFrameProcessing();
+
+    /** One color frame in ColorFormat. MJPEG/NV12 reach ColorTexture on a later call or tick, once decoded. */
+    void ProcessColorFrame(const uint8* Data, int32 SizeBytes, int32 Width, int32 Height, int32 StrideBytes, uint64 TimestampUsec);
+
+    /** One depth frame in millimeters, unbinned or 2x2 binned: DepthFilter, DepthBuffer and DepthTexture. */
+    void ProcessDepthFrame(const uint16* Depth, int32 Width, int32 Height);
 
 private:
     // Kinect handles
@@ -52,7 +218,54 @@ private:
     // Internal raw buffer
     TArray<uint16> RawDepthBuffer;
 
+    // Optional depth clean-up (bFilterDepth)
+    FAzureDepthFilter DepthFilter;
+    TArray<uint16> FilteredDepth;
+
+    // Worker-side MJPEG/NV12 decoding (null in BGRA32 mode)
+    TSharedPtr<FAzureColorDecoder> ColorDecoder;
+    TArray64<uint8> DecodedColor;
+
+    // Demand gating / adaptive rate (bGateStreamsOnDemand, bAdaptiveCaptureRate)
+    FAzureStreamDemand ColorDemand;
+    FAzureStreamDemand DepthDemand;
+    double ColorUnwantedSince = 0.0;
+    double DepthUnwantedSince = 0.0;
+    bool bCamerasRunning = false;
+    int32 FullRateFps = 30;
+    float SmoothedFrameMs = 0.f;   // game thread time without the capture wait
+    float CaptureWaitMs = 0.f;     // last tick's wait in k4a_device_get_capture
+    double PressureSince = 0.0;     // frame over budget since, 0 = not
+    double HeadroomSince = 0.0;     // frame well under budget since, 0 = not
+    double LastModeChangeSeconds = 0.0;
+
+    // Camera restarts run on a worker; the game thread leaves the device alone until they finish
+    TFuture<bool> CameraRestart;
+    EAzureKinectCaptureMode RestartMode = EAzureKinectCaptureMode::Full;
+    bool bRestartColor = false;
+    bool bRestartDepth = false;
+    float CameraRetrySeconds = 0.f;      // backoff after a failed start, 0 = none failed
+    double NextCameraStartSeconds = 0.0; // no new start attempt before this
+
+    // Cost of one full-resolution frame of each stream (smoothed), for the saved-CPU estimate
+    float ColorCostMs = 0.f;
+    float DepthCostMs = 0.f;
+    float SpentWindowMs = 0.f;
+    double WindowStartSeconds = 0.0;
+
+    k4a_device_configuration_t MakeCameraConfig(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth) const;
+    bool StartCameras(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth);
+    void RestartCamerasAsync(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth);
+    void FinishCameraRestart(bool bStarted, double Now);
+    void ApplyCameraMode(EAzureKinectCaptureMode Mode, bool bColor, bool bDepth, double Now);
+    EAzureKinectCaptureMode UpdateAdaptiveRate(float DeltaTime, double Now);
+    bool KeepStream(bool bWanted, bool bActive, double& UnwantedSince, double Now);
+    void UpdateSavedCpu(double Now);
+
+    void PreallocateFrameMemory();
     void InitializeTextures(int Width, int Height);
     void UpdateColor();
+    void UploadColor(const uint8* Pixels, int32 W, int32 H);
+    void UploadDecodedColor();
     void UpdateDepth();
 };
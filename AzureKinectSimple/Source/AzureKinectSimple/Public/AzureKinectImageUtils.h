@@ -0,0 +1,13 @@
+// AzureKinectImageUtils.h
+#pragma once
+#include "CoreMinimal.h"
+
+/** The per-pixel work behind the component's textures, split out so it runs without a sensor. */
+namespace AzureImage
+{
+    /** Depth (mm) to the opaque gray preview of the depth texture: one level per cm, white from 2.55 m. */
+    AZUREKINECTSIMPLE_API void DepthToGrayscale(const uint16* Depth, int32 NumPixels, FColor* OutPixels);
+
+    /** Copies a tightly packed BGRA8 image (the color texture's mip layout). */
+    AZUREKINECTSIMPLE_API void CopyBgra(const uint8* Src, int32 Width, int32 Height, uint8* Dest);
+}
@@ -0,0 +1,30 @@
+// AzureStreamDemand.h
+#pragma once
+#include "CoreMinimal.h"
+
+class UTexture;
+
+/**
+ * Whether anything still uses one output stream: a subscriber holds it, a getter read it
+ * recently, or the renderer sampled its texture recently. Times are FApp::GetCurrentTime,
+ * the clock the renderer stamps textures with. Game thread only.
+ */
+struct AZUREKINECTSIMPLE_API FAzureStreamDemand
+{
+    /** Marks a read; const so const getters can call it. */
+    void Touch() const;
+
+    void AddSubscriber() { ++Subscribers; }
+    void RemoveSubscriber() { Subscribers = FMath::Max(0, Subscribers - 1); }
+    int32 NumSubscribers() const { return Subscribers; }
+
+    /**
+     * True with a subscriber, a read or a sample of Texture within IdleSeconds, or while
+     * Texture doesn't exist yet (nothing could have bound it).
+     */
+    bool IsWanted(const UTexture* Texture, float IdleSeconds) const;
+
+private:
+    int32 Subscribers = 0;
+    mutable double LastReadSeconds = -UE_BIG_NUMBER;
+};
@@ -0,0 +1,30 @@
+// AzureTextureUtils.h
+#pragma once
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+
+class UTexture2D;
+
+namespace AzureTex
+{
+    /**
+     * Makes sure Texture is a WxH transient texture of the given format.
+     * Only (re)creates it on first use or when the size changes (releasing the old one);
+     * returns true if it did. Data textures get nearest filtering and no sRGB, images
+     * (bImage) keep the defaults.
+     */
+    AZUREKINECTSIMPLE_API bool EnsureTexture(UTexture2D*& Texture, int32 Width, int32 Height, EPixelFormat Format, bool bImage = false);
+
+    /** Takes a texture made by EnsureTexture out of the root set (GC frees it once unused) and clears the pointer. */
+    AZUREKINECTSIMPLE_API void ReleaseTexture(UTexture2D*& Texture);
+
+    /**
+     * Copies Pixels into a pooled staging block and queues a render-thread update of mip 0
+     * through UpdateTextureRegions, so the RHI resource is reused instead of rebuilt every
+     * frame. The block goes back to FAzureFramePool once the render thread is done with it.
+     */
+    AZUREKINECTSIMPLE_API void UploadTexture(UTexture2D* Texture, const uint8* Pixels, int32 Width, int32 Height, int32 BytesPerPixel);
+
+    /** Staging blocks for FramesInFlight uploads of a WxH texture, so the first frames don't allocate either. */
+    AZUREKINECTSIMPLE_API void PreallocateStaging(int32 Width, int32 Height, int32 BytesPerPixel, int32 FramesInFlight);
+}
@@ -0,0 +1,170 @@
+// k4a.h (stand-in)
+// Header-only replacement for the Azure Kinect Sensor SDK on platforms it doesn't ship on.
+// There is never a device: opening fails and nothing is captured. Images and captures are
+// real heap objects, so code that only moves pixels (benchmarks, recorded frames) works.
+#pragma once
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+#include "k4atypes.h"
+
+struct _k4a_device_t {};
+struct _k4a_transformation_t {};
+
+struct _k4a_image_t
+{
+    std::atomic<int> refs{ 1 };
+    k4a_image_format_t format = K4A_IMAGE_FORMAT_CUSTOM;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    uint8_t* buffer = nullptr;
+    size_t size = 0;
+    uint64_t device_timestamp_usec = 0;
+    uint64_t system_timestamp_nsec = 0;
+};
+
+struct _k4a_capture_t
+{
+    std::atomic<int> refs{ 1 };
+    k4a_image_t color = nullptr;
+    k4a_image_t depth = nullptr;
+};
+
+// --- device: none attached ---
+
+inline uint32_t k4a_device_get_installed_count(void) { return 0; }
+inline k4a_result_t k4a_device_open(uint32_t, k4a_device_t* device_handle) { *device_handle = nullptr; return K4A_RESULT_FAILED; }
+inline void k4a_device_close(k4a_device_t) {}
+inline k4a_result_t k4a_device_start_cameras(k4a_device_t, const k4a_device_configuration_t*) { return K4A_RESULT_FAILED; }
+inline void k4a_device_stop_cameras(k4a_device_t) {}
+inline k4a_result_t k4a_device_start_imu(k4a_device_t) { return K4A_RESULT_FAILED; }
+inline void k4a_device_stop_imu(k4a_device_t) {}
+inline k4a_wait_result_t k4a_device_get_capture(k4a_device_t, k4a_capture_t* capture_handle, int32_t) { *capture_handle = nullptr; return K4A_WAIT_RESULT_FAILED; }
+inline k4a_wait_result_t k4a_device_get_imu_sample(k4a_device_t, k4a_imu_sample_t*, int32_t) { return K4A_WAIT_RESULT_FAILED; }
+inline k4a_result_t k4a_device_get_calibration(k4a_device_t, k4a_depth_mode_t, k4a_color_resolution_t, k4a_calibration_t*) { return K4A_RESULT_FAILED; }
+
+// --- images ---
+
+inline k4a_result_t k4a_image_create(k4a_image_format_t format, int width_pixels, int height_pixels, int stride_bytes, k4a_image_t* image_handle)
+{
+    *image_handle = nullptr;
+    if (width_pixels <= 0 || height_pixels <= 0 || stride_bytes <= 0)
+    {
+        return K4A_RESULT_FAILED;
+    }
+
+    k4a_image_t Image = new _k4a_image_t();
+    Image->format = format;
+    Image->width = width_pixels;
+    Image->height = height_pixels;
+    Image->stride = stride_bytes;
+    Image->size = (size_t)stride_bytes * height_pixels;
+    Image->buffer = (uint8_t*)calloc(Image->size, 1);
+    *image_handle = Image;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+inline void k4a_image_reference(k4a_image_t image_handle) { if (image_handle) image_handle->refs++; }
+inline void k4a_image_release(k4a_image_t image_handle)
+{
+    if (image_handle && --image_handle->refs == 0)
+    {
+        free(image_handle->buffer);
+        delete image_handle;
+    }
+}
+
+inline uint8_t* k4a_image_get_buffer(k4a_image_t image_handle) { return image_handle ? image_handle->buffer : nullptr; }
+inline size_t k4a_image_get_size(k4a_image_t image_handle) { return image_handle ? image_handle->size : 0; }
+inline k4a_image_format_t k4a_image_get_format(k4a_image_t image_handle) { return image_handle ? image_handle->format : K4A_IMAGE_FORMAT_CUSTOM; }
+inline int k4a_image_get_width_pixels(k4a_image_t image_handle) { return image_handle ? image_handle->width : 0; }
+inline int k4a_image_get_height_pixels(k4a_image_t image_handle) { return image_handle ? image_handle->height : 0; }
+inline int k4a_image_get_stride_bytes(k4a_image_t image_handle) { return image_handle ? image_handle->stride : 0; }
+inline uint64_t k4a_image_get_device_timestamp_usec(k4a_image_t image_handle) { return image_handle ? image_handle->device_timestamp_usec : 0; }
+inline uint64_t k4a_image_get_system_timestamp_nsec(k4a_image_t image_handle) { return image_handle ? image_handle->system_timestamp_nsec : 0; }
+inline void k4a_image_set_device_timestamp_usec(k4a_image_t image_handle, uint64_t timestamp_usec) { if (image_handle) image_handle->device_timestamp_usec = timestamp_usec; }
+inline void k4a_image_set_system_timestamp_nsec(k4a_image_t image_handle, uint64_t timestamp_nsec) { if (image_handle) image_handle->system_timestamp_nsec = timestamp_nsec; }
+
+// --- captures ---
+
+inline k4a_result_t k4a_capture_create(k4a_capture_t* capture_handle) { *capture_handle = new _k4a_capture_t(); return K4A_RESULT_SUCCEEDED; }
+inline void k4a_capture_reference(k4a_capture_t capture_handle) { if (capture_handle) capture_handle->refs++; }
+inline void k4a_capture_release(k4a_capture_t capture_handle)
+{
+    if (capture_handle && --capture_handle->refs == 0)
+    {
+        k4a_image_release(capture_handle->color);
+        k4a_image_release(capture_handle->depth);
+        delete capture_handle;
+    }
+}
+
+inline void k4a_capture_set_color_image(k4a_capture_t capture_handle, k4a_image_t image_handle)
+{
+    if (!capture_handle) return;
+    k4a_image_reference(image_handle);
+    k4a_image_release(capture_handle->color);
+    capture_handle->color = image_handle;
+}
+
+inline void k4a_capture_set_depth_image(k4a_capture_t capture_handle, k4a_image_t image_handle)
+{
+    if (!capture_handle) return;
+    k4a_image_reference(image_handle);
+    k4a_image_release(capture_handle->depth);
+    capture_handle->depth = image_handle;
+}
+
+// Like the SDK, the caller owns (and releases) the returned reference
+inline k4a_image_t k4a_capture_get_color_image(k4a_capture_t capture_handle)
+{
+    if (!capture_handle || !capture_handle->color) return nullptr;
+    k4a_image_reference(capture_handle->color);
+    return capture_handle->color;
+}
+
+inline k4a_image_t k4a_capture_get_depth_image(k4a_capture_t capture_handle)
+{
+    if (!capture_handle || !capture_handle->depth) return nullptr;
+    k4a_image_reference(capture_handle->depth);
+    return capture_handle->depth;
+}
+
+// --- calibration / transformation ---
+
+/** Pinhole only (distortion ignored): enough for synthetic calibrations. */
+inline k4a_result_t k4a_calibration_2d_to_3d(const k4a_calibration_t* calibration, const k4a_float2_t* source_point2d, float source_depth_mm,
+                                             k4a_calibration_type_t source_camera, k4a_calibration_type_t target_camera,
+                                             k4a_float3_t* target_point3d_mm, int* valid)
+{
+    *valid = 0;
+    if (source_camera != target_camera || (source_camera != K4A_CALIBRATION_TYPE_DEPTH && source_camera != K4A_CALIBRATION_TYPE_COLOR))
+    {
+        return K4A_RESULT_FAILED;
+    }
+
+    const k4a_calibration_camera_t& Camera = (source_camera == K4A_CALIBRATION_TYPE_DEPTH)
+        ? calibration->depth_camera_calibration
+        : calibration->color_camera_calibration;
+    const auto& P = Camera.intrinsics.parameters.param;
+    if (P.fx <= 0.f || P.fy <= 0.f)
+    {
+        return K4A_RESULT_FAILED;
+    }
+
+    target_point3d_mm->xyz.x = (source_point2d->xy.x - P.cx) / P.fx * source_depth_mm;
+    target_point3d_mm->xyz.y = (source_point2d->xy.y - P.cy) / P.fy * source_depth_mm;
+    target_point3d_mm->xyz.z = source_depth_mm;
+    *valid = 1;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+inline k4a_transformation_t k4a_transformation_create(const k4a_calibration_t*) { return nullptr; }
+inline void k4a_transformation_destroy(k4a_transformation_t) {}
+inline k4a_result_t k4a_transformation_depth_image_to_color_camera_custom(
+    k4a_transformation_t, const k4a_image_t, const k4a_image_t, k4a_image_t, k4a_image_t,
+    k4a_transformation_interpolation_type_t, uint32_t)
+{
+    return K4A_RESULT_FAILED;
+}